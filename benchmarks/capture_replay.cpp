@@ -0,0 +1,310 @@
+// capture_replay.cpp
+//
+// Replays a file written by ChannelCapture (pyNetX.start_capture()) without
+// SSH, so parser changes can be measured against real device traffic.
+//
+// Notification records go through NetconfClient::on_notification_input(),
+// the code the reactor runs on every read: frame splitting, the missing-EOM
+// and incomplete-notification guards, queueing and health events. Each
+// session gets its own unconnected client, and sessions are replayed one
+// after another. RPC records go through append_until_eom(), as in the RPC
+// read loops.
+//
+// With paced=1 every read is delivered at its recorded offset, so the
+// incomplete-notification timeout fires as it did on the device. With
+// paced=0 reads are delivered back to back. A capture that ends in a partial
+// frame still waits for the timeout once at the end; unpaced runs use a 1 s
+// timeout for that and leave the wait out of the reported time.
+//
+//   capture_replay <capture_file> [paced] [repeat] [label_filter] > results.json
+
+#include "channel_capture.hpp"
+#include "netconf_client.hpp"
+#include "netconf_framing.hpp"
+#include "notification_event_bus.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string path;
+    bool paced = false;
+    int repeat = 1;
+    std::string filter;
+};
+
+struct Session {
+    ChannelCapture::Channel channel;
+    std::string label;
+    int fd;
+    std::vector<const CaptureRecord*> reads;
+};
+
+struct Result {
+    std::string name;
+    std::size_t reads = 0;
+    std::size_t bytes = 0;
+    std::size_t frames = 0;  // notifications queued, or RPC replies framed
+    double nsMedian = 0;
+    double nsMin = 0;
+    std::map<std::string, std::size_t> events;
+};
+
+// Hands one session's recorded reads to on_notification_input(), optionally
+// at their recorded pace.
+class ReplayInput final : public NotificationInput {
+public:
+    ReplayInput(const Session& session, bool paced)
+        : session_(session), paced_(paced),
+          origin_(Clock::now()), firstNanos_(session.reads.front()->nanos) {}
+
+    bool advance() {
+        if (next_ >= session_.reads.size()) {
+            return false;
+        }
+        const CaptureRecord& record = *session_.reads[next_++];
+        if (paced_) {
+            std::this_thread::sleep_until(due(record));
+        }
+        pending_ += record.data;
+        return true;
+    }
+
+    std::string read() override {
+        std::string out;
+        out.swap(pending_);
+        return out;
+    }
+
+    int poll(int timeoutMs) override {
+        const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        if (next_ < session_.reads.size() &&
+            (!paced_ || due(*session_.reads[next_]) <= deadline)) {
+            advance();
+            return 1;
+        }
+        const auto before = Clock::now();
+        std::this_thread::sleep_until(deadline);
+        idle_ += Clock::now() - before;
+        return 0;
+    }
+
+    /// Time spent in poll() waiting for a read that was not due yet.
+    Clock::duration idle() const noexcept { return idle_; }
+
+private:
+    Clock::time_point due(const CaptureRecord& record) const {
+        return origin_ + std::chrono::nanoseconds(record.nanos - firstNanos_);
+    }
+
+    const Session& session_;
+    const bool paced_;
+    const Clock::time_point origin_;
+    const std::int64_t firstNanos_;
+    std::size_t next_ = 0;
+    std::string pending_;
+    Clock::duration idle_{0};
+};
+
+std::size_t drainQueue(NetconfClient& client) {
+    return client.try_next_notifications(std::numeric_limits<std::size_t>::max()).size();
+}
+
+void drainEvents(std::map<std::string, std::size_t>& counts) {
+    NotificationEventBus& bus = NotificationEventBus::instance();
+    while (bus.pending_event_count() > 0) {
+        NotificationHealthEvent event = bus.next_event(0);
+        if (event.valid) {
+            ++counts[event.type];
+        }
+    }
+}
+
+// One pass over a notification session; returns the wall time. Unpaced
+// runs exclude the time spent waiting for the incomplete-notification
+// timeout, which is not parser work.
+double replayNotifications(const Session& session, bool paced, Result& result) {
+    // Back to back, the timeout can only fire after the last read, so the
+    // shortest one gives the same frames and events.
+    const int incompleteTimeout = paced ? 5 : 1;
+    auto client = std::make_shared<NetconfClient>(
+        "replay", 830, "replay", "", "", 60, 60, -1, 5, 1024, incompleteTimeout, 1,
+        session.label
+    );
+    NotificationEventBus::instance().clear();
+
+    ReplayInput input(session, paced);
+    result.frames = 0;
+    result.events.clear();
+
+    const auto start = Clock::now();
+    while (input.advance()) {
+        client->on_notification_input(session.fd, input);
+        result.frames += drainQueue(*client);
+    }
+    auto end = Clock::now();
+    if (!paced) {
+        end -= input.idle();
+    }
+
+    drainEvents(result.events);
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+double replayRpc(const Session& session, Result& result) {
+    std::string response;
+    result.frames = 0;
+
+    const auto start = Clock::now();
+    for (const CaptureRecord* record : session.reads) {
+        if (append_until_eom(response, record->data.data(), record->data.size())) {
+            ++result.frames;
+            response.clear();
+        }
+    }
+    const auto end = Clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+// Session names come from device labels and the capture path from the
+// command line; either may hold quotes, backslashes or control characters.
+std::string jsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(c));
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+void printJson(const Options& opt, const std::vector<Result>& results) {
+    std::printf("{\n  \"context\": {\n");
+    std::printf("    \"benchmark\": \"capture_replay\",\n");
+#if defined(__VERSION__)
+    std::printf("    \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    std::printf("    \"capture\": %s,\n", jsonString(opt.path).c_str());
+    std::printf("    \"paced\": %s,\n", opt.paced ? "true" : "false");
+    std::printf("    \"repetitions\": %d\n  },\n", opt.repeat);
+
+    std::printf("  \"sessions\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::printf("    {\"name\": %s, \"reads\": %zu, \"bytes\": %zu, \"frames\": %zu, "
+                    "\"ns\": %.0f, \"ns_min\": %.0f",
+            jsonString(r.name).c_str(), r.reads, r.bytes, r.frames, r.nsMedian, r.nsMin);
+        if (r.nsMedian > 0) {
+            std::printf(", \"mib_per_s\": %.1f",
+                static_cast<double>(r.bytes) / r.nsMedian * 1e9 / (1 << 20));
+        }
+        if (r.frames > 0) {
+            std::printf(", \"ns_per_frame\": %.1f", r.nsMedian / static_cast<double>(r.frames));
+        }
+        std::printf(", \"events\": {");
+        bool first = true;
+        for (const auto& event : r.events) {
+            std::printf("%s%s: %zu", first ? "" : ", ", jsonString(event.first).c_str(), event.second);
+            first = false;
+        }
+        std::printf("}}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <capture_file> [paced] [repeat] [label_filter]\n", argv[0]);
+        return 2;
+    }
+    Options opt;
+    opt.path = argv[1];
+    if (argc > 2) opt.paced = std::atoi(argv[2]) != 0;
+    if (argc > 3) opt.repeat = std::max(1, std::atoi(argv[3]));
+    if (argc > 4) opt.filter = argv[4];
+
+    std::vector<CaptureRecord> records;
+    try {
+        CaptureReader reader(opt.path);
+        CaptureRecord record;
+        while (reader.next(record)) {
+            records.push_back(std::move(record));
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "capture_replay: %s\n", e.what());
+        return 1;
+    }
+
+    // One session per channel, fd and label, in order of first appearance.
+    std::vector<Session> sessions;
+    for (const CaptureRecord& record : records) {
+        if (!opt.filter.empty() && record.label.find(opt.filter) == std::string::npos) {
+            continue;
+        }
+        Session* session = nullptr;
+        for (Session& s : sessions) {
+            if (s.channel == record.channel && s.fd == record.fd && s.label == record.label) {
+                session = &s;
+                break;
+            }
+        }
+        if (!session) {
+            sessions.push_back(Session{record.channel, record.label, record.fd, {}});
+            session = &sessions.back();
+        }
+        session->reads.push_back(&record);
+    }
+
+    std::vector<Result> results;
+    for (const Session& session : sessions) {
+        const bool notification = session.channel == ChannelCapture::Channel::Notification;
+        Result result;
+        result.name = std::string(notification ? "notification/" : "rpc/") + session.label +
+                      "/fd" + std::to_string(session.fd);
+        result.reads = session.reads.size();
+        for (const CaptureRecord* record : session.reads) {
+            result.bytes += record->data.size();
+        }
+
+        std::vector<double> runs;
+        for (int i = 0; i < opt.repeat; ++i) {
+            runs.push_back(notification ? replayNotifications(session, opt.paced, result)
+                                        : replayRpc(session, result));
+        }
+        std::sort(runs.begin(), runs.end());
+        result.nsMedian = runs[runs.size() / 2];
+        result.nsMin = runs.front();
+        results.push_back(std::move(result));
+    }
+
+    printJson(opt, results);
+    return 0;
+}
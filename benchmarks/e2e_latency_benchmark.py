@@ -0,0 +1,291 @@
+"""End-to-end latency and throughput of pyNetX against the local fake server.
+
+Runs against `FakeNetconfSSHServer` (test/fake_netconf_ssh_server.py) in this
+process, once per cell of a matrix over `set_threadpool_size()` and
+`set_notification_reactor_count()`. Each cell measures:
+
+  rpc            per-call latency of get_async() and get_sync(), reported as
+                 p50/p90/p99/p999/max in microseconds. --rpc-concurrency
+                 clients run back to back: coroutines for async, threads for
+                 sync
+  connect        connect_async() for --connect-clients clients at once;
+                 reports connects per second
+  notifications  one subscription per drain method. The server pushes
+                 --notifications notifications; arrival_per_second is how fast
+                 they reach the client queue, drain_per_second is how fast
+                 next_notification() or next_notifications() empties it
+
+    python benchmarks/e2e_latency_benchmark.py --threadpool-sizes 1,2,4,8 \\
+        --reactor-counts 1,2 --json e2e.json
+
+The pool and reactors are reconfigured in place between cells, as an
+application would do it. p999 needs at least 1000 samples per mode to mean
+anything; the default --rpc-count is 2000. The fake server is paramiko on one
+thread per connection and shares the CPU with the client, so compare runs made
+on the same host.
+"""
+
+from __future__ import annotations
+
+import argparse
+import asyncio
+import json
+import math
+import os
+import platform
+import sys
+import threading
+import time
+import warnings
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "test"))
+
+import pyNetX  # noqa: E402
+from fake_netconf_ssh_server import OK_REPLY, FakeNetconfSSHServer  # noqa: E402
+from netconf_fleet_simulator import data_reply, notification_xml  # noqa: E402
+
+PERCENTILES = (("p50", 0.50), ("p90", 0.90), ("p99", 0.99), ("p999", 0.999))
+
+
+def _int_list(text: str) -> list[int]:
+    values = [int(v) for v in text.split(",") if v.strip()]
+    if not values or any(v <= 0 for v in values):
+        raise argparse.ArgumentTypeError(f"expected comma-separated positive integers, got {text!r}")
+    return values
+
+
+def _parse_args(argv=None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--threadpool-sizes", type=_int_list, default=[1, 2, 4, 8])
+    parser.add_argument("--reactor-counts", type=_int_list, default=[1, 2])
+    parser.add_argument("--rpc-count", type=int, default=2000, help="timed RPCs per mode and cell")
+    parser.add_argument("--rpc-warmup", type=int, default=50)
+    parser.add_argument("--rpc-concurrency", type=int, default=1)
+    parser.add_argument("--reply-bytes", type=int, default=1024)
+    parser.add_argument("--connect-clients", type=int, default=32)
+    parser.add_argument("--notifications", type=int, default=5000)
+    parser.add_argument("--notification-bytes", type=int, default=512)
+    parser.add_argument("--batch-size", type=int, default=1000, help="max_items for next_notifications()")
+    parser.add_argument("--arrival-timeout", type=float, default=60.0)
+    parser.add_argument("--json", dest="json_path", default="", help="also write results to this file")
+    return parser.parse_args(argv)
+
+
+def latency_summary(samples_ns: list[int]) -> dict:
+    """Nearest-rank percentiles of samples_ns, in microseconds."""
+    if not samples_ns:
+        return {"count": 0}
+    ordered = sorted(samples_ns)
+    n = len(ordered)
+    summary = {"count": n, "mean_us": sum(ordered) / n / 1000.0}
+    for name, q in PERCENTILES:
+        summary[f"{name}_us"] = ordered[min(n - 1, max(0, math.ceil(q * n) - 1))] / 1000.0
+    summary["max_us"] = ordered[-1] / 1000.0
+    return summary
+
+
+def _make_client(server: FakeNetconfSSHServer):
+    return pyNetX.NetconfClient(
+        hostname=server.host,
+        port=server.port,
+        username=server.username,
+        password=server.password,
+        connect_timeout=30,
+        read_timeout=30,
+        socket_connect_timeout=10,
+        notif_queue_size=-1,
+    )
+
+
+async def _connect_all(clients) -> None:
+    await asyncio.gather(*(c.connect_async() for c in clients))
+
+
+async def _disconnect_all(clients) -> None:
+    await asyncio.gather(*(c.disconnect_async() for c in clients), return_exceptions=True)
+
+
+async def _rpc_async(clients, count: int, warmup: int) -> list[int]:
+    samples: list[int] = []
+    per_client = max(1, count // len(clients))
+
+    async def loop(client):
+        for _ in range(warmup):
+            await client.get_async()
+        for _ in range(per_client):
+            started = time.perf_counter_ns()
+            await client.get_async()
+            samples.append(time.perf_counter_ns() - started)
+
+    await asyncio.gather(*(loop(c) for c in clients))
+    return samples
+
+
+def _rpc_sync(clients, count: int, warmup: int) -> list[int]:
+    samples: list[int] = []
+    lock = threading.Lock()
+    per_client = max(1, count // len(clients))
+
+    def loop(client):
+        local: list[int] = []
+        for _ in range(warmup):
+            client.get_sync()
+        for _ in range(per_client):
+            started = time.perf_counter_ns()
+            client.get_sync()
+            local.append(time.perf_counter_ns() - started)
+        with lock:
+            samples.extend(local)
+
+    # get_sync() is deprecated; its warning is part of the call's cost, but
+    # printing it thousands of times is not.
+    with warnings.catch_warnings():
+        warnings.simplefilter("ignore", DeprecationWarning)
+        if len(clients) == 1:
+            loop(clients[0])
+        else:
+            with ThreadPoolExecutor(max_workers=len(clients)) as executor:
+                list(executor.map(loop, clients))
+    return samples
+
+
+async def _rpc_phase(server, args) -> dict:
+    clients = [_make_client(server) for _ in range(args.rpc_concurrency)]
+    await _connect_all(clients)
+    try:
+        async_samples = await _rpc_async(clients, args.rpc_count, args.rpc_warmup)
+        sync_samples = _rpc_sync(clients, args.rpc_count, args.rpc_warmup)
+    finally:
+        await _disconnect_all(clients)
+    return {"async": latency_summary(async_samples), "sync": latency_summary(sync_samples)}
+
+
+async def _connect_phase(server, args) -> dict:
+    clients = [_make_client(server) for _ in range(args.connect_clients)]
+    started = time.perf_counter()
+    results = await asyncio.gather(*(c.connect_async() for c in clients), return_exceptions=True)
+    elapsed = time.perf_counter() - started
+    connected = [c for c, r in zip(clients, results) if r is True]
+    await _disconnect_all(connected)
+    return {
+        "attempted": len(clients),
+        "connected": len(connected),
+        "seconds": elapsed,
+        "connects_per_second": len(connected) / elapsed if elapsed > 0 else 0.0,
+    }
+
+
+def _drain_one_at_a_time(client, expected: int) -> int:
+    received = 0
+    while received < expected:
+        if not client.next_notification(timeout_ms=0):
+            break
+        received += 1
+    return received
+
+
+def _drain_batches(client, expected: int, batch_size: int) -> int:
+    received = 0
+    while received < expected:
+        batch = client.next_notifications(max_items=batch_size, timeout_ms=0)
+        if not batch:
+            break
+        received += len(batch)
+    return received
+
+
+async def _notification_phase(server, args) -> dict:
+    results = {}
+    expected = args.notifications
+    for method in ("next_notification", "next_notifications"):
+        client = _make_client(server)
+        await client.connect_async()
+        try:
+            await client.subscribe_async()
+            started = time.perf_counter()
+            deadline = started + args.arrival_timeout
+            while client.notification_queue_size() < expected and time.perf_counter() < deadline:
+                await asyncio.sleep(0.001)
+            arrival = time.perf_counter() - started
+            queued = client.notification_queue_size()
+
+            started = time.perf_counter()
+            if method == "next_notification":
+                drained = _drain_one_at_a_time(client, queued)
+            else:
+                drained = _drain_batches(client, queued, args.batch_size)
+            drain = time.perf_counter() - started
+        finally:
+            try:
+                client.delete_subscription()
+            except Exception:
+                pass
+            await _disconnect_all([client])
+
+        results[method] = {
+            "expected": expected,
+            "queued": queued,
+            "drained": drained,
+            "arrival_seconds": arrival,
+            "arrival_per_second": queued / arrival if arrival > 0 else 0.0,
+            "drain_seconds": drain,
+            "drain_per_second": drained / drain if drain > 0 else 0.0,
+        }
+    return results
+
+
+async def run(args: argparse.Namespace) -> dict:
+    reply = data_reply("101", args.reply_bytes)
+    server = FakeNetconfSSHServer(
+        rpc_responder=lambda rpc: reply if "<get" in rpc else OK_REPLY,
+        notifications=[notification_xml(i, args.notification_bytes) for i in range(args.notifications)],
+        notification_start_delay=0.0,
+        notification_interval=0.0,
+    )
+
+    cells = []
+    with server:
+        for pool_size in args.threadpool_sizes:
+            for reactors in args.reactor_counts:
+                pyNetX.set_threadpool_size(pool_size)
+                pyNetX.set_notification_reactor_count(reactors)
+                cells.append(
+                    {
+                        "threadpool_size": pool_size,
+                        "reactor_count": reactors,
+                        "rpc": await _rpc_phase(server, args),
+                        "connect": await _connect_phase(server, args),
+                        "notifications": await _notification_phase(server, args),
+                    }
+                )
+                print(
+                    f"threadpool_size={pool_size} reactors={reactors} done",
+                    file=sys.stderr,
+                )
+
+    return {
+        "context": {
+            "benchmark": "e2e_latency_benchmark",
+            "python": platform.python_version(),
+            "platform": platform.platform(),
+            "cpu_count": os.cpu_count(),
+            "args": {k: v for k, v in vars(args).items() if k != "json_path"},
+        },
+        "cells": cells,
+    }
+
+
+def main(argv=None) -> None:
+    args = _parse_args(argv)
+    results = asyncio.run(run(args))
+
+    text = json.dumps(results, indent=2, sort_keys=True)
+    print(text)
+    if args.json_path:
+        with open(args.json_path, "w", encoding="utf-8") as fh:
+            fh.write(text + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,234 @@
+"""Load-test pyNetX against a simulated NETCONF fleet.
+
+Starts `NetconfFleetSimulator` (test/netconf_fleet_simulator.py) in this
+process, then drives one pyNetX client per simulated device through three
+phases:
+
+  connect        connect_async() for every device, at most
+                 --connect-concurrency in flight; reports connects per second
+                 and failures by exception type
+  rpc            each client issues get_async() back to back for
+                 --rpc-seconds; reports RPCs per second and reply MiB/s
+  notifications  subscribe_async() on every client, then drain with
+                 next_notifications_async() for --notification-seconds;
+                 reports notifications per second next to what the simulator
+                 sent, plus health events by type
+
+    python benchmarks/fleet_load_test.py --devices 500 --notification-rate 50 --json fleet.json
+
+The simulator and pyNetX share one process. On a small machine the simulator's
+paramiko threads compete with pyNetX for CPU, so compare runs made on the same
+host with the same device count.
+"""
+
+from __future__ import annotations
+
+import argparse
+import asyncio
+import json
+import os
+import platform
+import sys
+import time
+from collections import Counter
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "test"))
+
+import pyNetX  # noqa: E402
+from netconf_fleet_simulator import DeviceProfile, NetconfFleetSimulator  # noqa: E402
+
+
+def _parse_args(argv=None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--devices", type=int, default=100)
+    parser.add_argument("--addresses", default="127.0.0.1", help="comma-separated simulator bind addresses")
+    parser.add_argument("--connect-concurrency", type=int, default=64)
+    parser.add_argument("--rpc-seconds", type=float, default=5.0)
+    parser.add_argument("--notification-seconds", type=float, default=5.0)
+    parser.add_argument("--reply-bytes", type=int, default=4096)
+    parser.add_argument("--latency-ms", type=float, default=1.0)
+    parser.add_argument("--jitter-ms", type=float, default=0.5)
+    parser.add_argument("--notification-rate", type=float, default=20.0, help="per device, per second")
+    parser.add_argument("--notification-bytes", type=int, default=512)
+    parser.add_argument("--malformed-every", type=int, default=0)
+    parser.add_argument("--threadpool-size", type=int, default=0, help="0 keeps the pyNetX default")
+    parser.add_argument("--reactors", type=int, default=0, help="0 keeps the pyNetX default")
+    parser.add_argument("--json", dest="json_path", default="", help="also write results to this file")
+    return parser.parse_args(argv)
+
+
+def _make_client(device, username: str, password: str):
+    return pyNetX.NetconfClient(
+        hostname=device.host,
+        port=device.port,
+        username=username,
+        password=password,
+        connect_timeout=30,
+        read_timeout=30,
+        socket_connect_timeout=10,
+        notif_queue_size=-1,
+        label=device.label,
+    )
+
+
+async def _connect_phase(clients, concurrency: int) -> dict:
+    semaphore = asyncio.Semaphore(concurrency)
+    failures: Counter[str] = Counter()
+    connected = []
+
+    async def connect(client):
+        async with semaphore:
+            try:
+                await client.connect_async()
+                connected.append(client)
+            except Exception as exc:
+                failures[type(exc).__name__] += 1
+
+    started = time.perf_counter()
+    await asyncio.gather(*(connect(c) for c in clients))
+    elapsed = time.perf_counter() - started
+    return {
+        "attempted": len(clients),
+        "connected": len(connected),
+        "failures": dict(failures),
+        "seconds": elapsed,
+        "connects_per_second": len(connected) / elapsed if elapsed > 0 else 0.0,
+        "_clients": connected,
+    }
+
+
+async def _rpc_phase(clients, seconds: float) -> dict:
+    deadline = time.perf_counter() + seconds
+    counts = Counter()
+
+    async def loop(client):
+        while time.perf_counter() < deadline:
+            try:
+                reply = await client.get_async()
+            except Exception as exc:
+                counts["errors"] += 1
+                counts[f"error:{type(exc).__name__}"] += 1
+                continue
+            counts["rpcs"] += 1
+            counts["reply_bytes"] += len(reply)
+
+    started = time.perf_counter()
+    await asyncio.gather(*(loop(c) for c in clients))
+    elapsed = time.perf_counter() - started
+    return {
+        "rpcs": counts["rpcs"],
+        "errors": {k[6:]: v for k, v in counts.items() if k.startswith("error:")},
+        "seconds": elapsed,
+        "rpcs_per_second": counts["rpcs"] / elapsed if elapsed > 0 else 0.0,
+        "reply_mib_per_second": counts["reply_bytes"] / elapsed / (1 << 20) if elapsed > 0 else 0.0,
+    }
+
+
+async def _notification_phase(clients, seconds: float, simulator: NetconfFleetSimulator) -> dict:
+    subscribed = []
+    for result, client in zip(
+        await asyncio.gather(*(c.subscribe_async() for c in clients), return_exceptions=True),
+        clients,
+    ):
+        if not isinstance(result, Exception):
+            subscribed.append(client)
+
+    pyNetX.clear_notification_events()
+    sent_before = simulator.stats()
+    deadline = time.perf_counter() + seconds
+    received = 0
+
+    async def drain(client):
+        nonlocal received
+        while time.perf_counter() < deadline:
+            try:
+                batch = await client.next_notifications_async(max_items=1000, timeout_ms=100)
+            except Exception:
+                await asyncio.sleep(0.01)
+                continue
+            received += len(batch)
+
+    started = time.perf_counter()
+    await asyncio.gather(*(drain(c) for c in subscribed))
+    elapsed = time.perf_counter() - started
+    sent_after = simulator.stats()
+
+    events: Counter[str] = Counter()
+    while pyNetX.pending_notification_event_count() > 0:
+        event = pyNetX.next_notification_event(0)
+        if not event.valid:
+            break
+        events[event.type] += 1
+
+    sent = sent_after["notifications_sent"] - sent_before["notifications_sent"]
+    malformed = sent_after["malformed_sent"] - sent_before["malformed_sent"]
+    return {
+        "subscribed": len(subscribed),
+        "received": received,
+        "simulator_sent": sent,
+        "simulator_malformed_sent": malformed,
+        "seconds": elapsed,
+        "notifications_per_second": received / elapsed if elapsed > 0 else 0.0,
+        "health_events": dict(events),
+    }
+
+
+async def _disconnect_all(clients) -> None:
+    await asyncio.gather(*(c.disconnect_async() for c in clients), return_exceptions=True)
+
+
+async def run(args: argparse.Namespace) -> dict:
+    if args.threadpool_size:
+        pyNetX.set_threadpool_size(args.threadpool_size)
+    if args.reactors:
+        pyNetX.set_notification_reactor_count(args.reactors)
+
+    profile = DeviceProfile(
+        reply_bytes=args.reply_bytes,
+        latency_ms=args.latency_ms,
+        jitter_ms=args.jitter_ms,
+        notification_rate=args.notification_rate,
+        notification_bytes=args.notification_bytes,
+        malformed_every=args.malformed_every,
+    )
+    addresses = [a.strip() for a in args.addresses.split(",") if a.strip()]
+
+    with NetconfFleetSimulator(args.devices, profile=profile, addresses=addresses) as simulator:
+        clients = [_make_client(d, simulator.username, simulator.password) for d in simulator.devices]
+
+        connect = await _connect_phase(clients, args.connect_concurrency)
+        connected = connect.pop("_clients")
+        try:
+            rpc = await _rpc_phase(connected, args.rpc_seconds)
+            notifications = await _notification_phase(connected, args.notification_seconds, simulator)
+        finally:
+            await _disconnect_all(connected)
+
+        return {
+            "context": {
+                "benchmark": "fleet_load_test",
+                "python": platform.python_version(),
+                "cpu_count": os.cpu_count(),
+                "threadpool_size": pyNetX.get_threadpool_size(),
+                "args": {k: v for k, v in vars(args).items() if k != "json_path"},
+            },
+            "connect": connect,
+            "rpc": rpc,
+            "notifications": notifications,
+            "simulator": simulator.stats(),
+        }
+
+
+def main(argv=None) -> None:
+    args = _parse_args(argv)
+    results = asyncio.run(run(args))
+
+    text = json.dumps(results, indent=2, sort_keys=True)
+    print(text)
+    if args.json_path:
+        with open(args.json_path, "w", encoding="utf-8") as fh:
+            fh.write(text + "\n")
+
+
+if __name__ == "__main__":
+    main()
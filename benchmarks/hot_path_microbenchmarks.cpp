@@ -0,0 +1,524 @@
+// hot_path_microbenchmarks.cpp
+//
+// Microbenchmarks for the per-reply and per-notification hot paths, written
+// as JSON so two builds can be compared.
+//
+//   framing/*          append_until_eom() over a reply arriving in the 1 KiB
+//                      reads of read_until_eom_non_blocking()
+//   split/*            split_notification_frames() over notification streams,
+//                      coalesced into one read or cut into 4 KiB reads
+//   validate/*         is_valid_notification_document()
+//   rpc_error/*        NetconfClient::check_for_rpc_error()
+//   thread_pool/*      ThreadPool::enqueue() round trips and batches
+//   event_bus/*        NotificationEventBus::emit() + next_event()
+//   rpc_stats/*        RpcStats::record() of one traced RPC, and snapshot()
+//   metrics/*          MetricsRegistry updates and an OpenMetrics render
+//   trace/*            a TraceSpan with tracing off and on
+//   log/*              NETX_LOG() below the level, over the rate limit, and
+//                      into the ring
+//
+// Every case runs `repetitions` times for at least min_time_ms / repetitions
+// each; the JSON reports the median and fastest repetition per operation.
+//
+//   hot_path_microbenchmarks [min_time_ms] [workers] [name_filter] > results.json
+
+#include "netconf_client.hpp"
+#include "logger.hpp"
+#include "metrics_registry.hpp"
+#include "netconf_framing.hpp"
+#include "notification_event_bus.hpp"
+#include "rpc_stats.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_global.hpp"
+#include "trace_recorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int REPETITIONS = 5;
+constexpr size_t RPC_READ_CHUNK = 1024;   // read_until_eom_non_blocking buffer
+constexpr size_t NOTIF_READ_CHUNK = 4096; // notification channel read buffer
+
+template <class T>
+void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsMedian = 0.0;
+    double nsMin = 0.0;
+    size_t bytesPerOp = 0;
+    size_t itemsPerOp = 0;
+};
+
+// One call of op is one operation. op returns nothing; anything it computes
+// must go through doNotOptimize().
+Result measure(
+    const std::string& name,
+    int minTimeMs,
+    size_t bytesPerOp,
+    size_t itemsPerOp,
+    const std::function<void()>& op
+) {
+    const auto perRep = std::chrono::microseconds(
+        std::max(1, minTimeMs) * 1000 / REPETITIONS
+    );
+
+    // Size a batch so the clock is read rarely relative to the work.
+    op();
+    uint64_t batch = 1;
+    for (;;) {
+        const auto started = Clock::now();
+        for (uint64_t i = 0; i < batch; ++i) op();
+        if (Clock::now() - started >= std::chrono::microseconds(200) || batch >= (1u << 24)) break;
+        batch *= 2;
+    }
+
+    Result result;
+    result.name = name;
+    result.bytesPerOp = bytesPerOp;
+    result.itemsPerOp = itemsPerOp;
+
+    std::vector<double> perOp;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        uint64_t done = 0;
+        const auto started = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        while (elapsed < perRep) {
+            for (uint64_t i = 0; i < batch; ++i) op();
+            done += batch;
+            elapsed = Clock::now() - started;
+        }
+        result.iterations += done;
+        perOp.push_back(
+            std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(done)
+        );
+    }
+
+    std::sort(perOp.begin(), perOp.end());
+    result.nsMedian = perOp[perOp.size() / 2];
+    result.nsMin = perOp.front();
+    return result;
+}
+
+// ----------------------- Synthetic inputs -------------------------
+
+std::string makeNotification(size_t targetBytes, size_t seq) {
+    std::string xml =
+        "<notification xmlns=\"urn:ietf:params:xml:ns:netconf:notification:1.0\">"
+        "<eventTime>2026-10-18T12:00:00.000000Z</eventTime>"
+        "<interface-state-change xmlns=\"urn:example:interfaces\">"
+        "<name>ge-0/0/" + std::to_string(seq % 48) + "</name>"
+        "<oper-status>up</oper-status>";
+    for (size_t i = 0; xml.size() + 64 < targetBytes; ++i) {
+        xml += "<counter name=\"c" + std::to_string(i) + "\">" +
+            std::to_string(1000003 * (i + seq)) + "</counter>";
+    }
+    xml += "</interface-state-change></notification>";
+    return xml;
+}
+
+std::string makeNotificationStream(size_t count, size_t notificationBytes) {
+    std::string stream;
+    for (size_t i = 0; i < count; ++i) {
+        stream += makeNotification(notificationBytes, i);
+        stream += "]]>]]>";
+    }
+    return stream;
+}
+
+std::string makeDataReply(size_t targetBytes) {
+    std::string xml =
+        "<rpc-reply xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\" message-id=\"101\">"
+        "<data><interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">";
+    for (size_t i = 0; xml.size() + 64 < targetBytes; ++i) {
+        xml += "<interface><name>ge-0/0/" + std::to_string(i) + "</name>"
+            "<description>uplink " + std::to_string(i) + "</description>"
+            "<enabled>true</enabled><mtu>9192</mtu></interface>";
+    }
+    xml += "</interfaces></data></rpc-reply>";
+    return xml;
+}
+
+const char* const OK_REPLY =
+    "<rpc-reply xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\" message-id=\"101\">"
+    "<ok/></rpc-reply>";
+
+const char* const ERROR_REPLY =
+    "<rpc-reply xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\" message-id=\"101\">"
+    "<rpc-error><error-type>application</error-type><error-tag>invalid-value</error-tag>"
+    "<error-severity>error</error-severity><error-path>/interfaces/interface[name='ge-0/0/1']</error-path>"
+    "<error-message xml:lang=\"en\">MTU out of range</error-message></rpc-error></rpc-reply>";
+
+// Counts split frames without inspecting them, so split/* measures the
+// splitter alone.
+class CountingHandler : public NotificationFrameHandler {
+public:
+    void on_eom_frame(const std::string& frame) override { bytes += frame.size(); }
+    void on_recovered_frame(const std::string& frame) override { bytes += frame.size(); }
+    void on_abandoned_partial(std::string partial) override { bytes += partial.size(); }
+    void on_orphan_prefix(std::size_t n) override { bytes += n; }
+
+    size_t bytes = 0;
+};
+
+// ----------------------- Cases -------------------------
+
+// Inputs are built inside run(), so a filtered run skips their setup too.
+struct Case {
+    std::string name;
+    std::function<Result(const std::string& name)> run;
+};
+
+void framingCases(std::vector<Case>& cases, int minTimeMs) {
+    for (size_t size : {size_t(4) << 10, size_t(64) << 10, size_t(1) << 20}) {
+        const std::string name = "framing/append_until_eom/" + std::to_string(size >> 10) + "KiB";
+        cases.push_back({name, [size, minTimeMs](const std::string& name) {
+            const std::string reply = makeDataReply(size) + "]]>]]>";
+            std::string response;
+            return measure(name, minTimeMs, reply.size(), 1, [&] {
+                response.clear();
+                for (size_t off = 0; off < reply.size(); off += RPC_READ_CHUNK) {
+                    const size_t n = std::min(RPC_READ_CHUNK, reply.size() - off);
+                    if (append_until_eom(response, reply.data() + off, n)) break;
+                }
+                doNotOptimize(response);
+            });
+        }});
+    }
+}
+
+void splitCases(std::vector<Case>& cases, int minTimeMs) {
+    struct Shape { size_t count; size_t bytes; };
+    for (Shape shape : {Shape{64, 512}, Shape{64, 4096}, Shape{8, 65536}}) {
+        const std::string suffix =
+            std::to_string(shape.count) + "x" + std::to_string(shape.bytes) + "B";
+
+        cases.push_back({"split/coalesced/" + suffix, [shape, minTimeMs](const std::string& name) {
+            const std::string stream = makeNotificationStream(shape.count, shape.bytes);
+            CountingHandler handler;
+            std::string buffer;
+            return measure(name, minTimeMs, stream.size(), shape.count, [&] {
+                buffer = stream;
+                NotificationScanState scan;
+                split_notification_frames(buffer, scan, handler);
+                doNotOptimize(handler.bytes);
+            });
+        }});
+
+        cases.push_back({"split/fragmented_4KiB_reads/" + suffix, [shape, minTimeMs](const std::string& name) {
+            const std::string stream = makeNotificationStream(shape.count, shape.bytes);
+            CountingHandler handler;
+            std::string buffer;
+            return measure(name, minTimeMs, stream.size(), shape.count, [&] {
+                buffer.clear();
+                NotificationScanState scan;
+                for (size_t off = 0; off < stream.size(); off += NOTIF_READ_CHUNK) {
+                    buffer.append(stream, off, NOTIF_READ_CHUNK);
+                    split_notification_frames(buffer, scan, handler);
+                }
+                doNotOptimize(handler.bytes);
+            });
+        }});
+    }
+}
+
+void validateCases(std::vector<Case>& cases, int minTimeMs) {
+    for (size_t size : {size_t(512), size_t(4096), size_t(65536)}) {
+        const std::string name = "validate/notification/" + std::to_string(size) + "B";
+        cases.push_back({name, [size, minTimeMs](const std::string& name) {
+            const std::string notification = makeNotification(size, 7);
+            return measure(name, minTimeMs, notification.size(), 1, [&] {
+                doNotOptimize(is_valid_notification_document(notification));
+            });
+        }});
+    }
+
+    cases.push_back({"validate/truncated/4096B", [minTimeMs](const std::string& name) {
+        const std::string truncated = makeNotification(4096, 7).substr(0, 3000);
+        return measure(name, minTimeMs, truncated.size(), 1, [&] {
+            doNotOptimize(is_valid_notification_document(truncated));
+        });
+    }});
+}
+
+void rpcErrorCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"rpc_error/ok", [minTimeMs](const std::string& name) {
+        const std::string reply = OK_REPLY;
+        return measure(name, minTimeMs, reply.size(), 1, [&] {
+            NetconfClient::check_for_rpc_error(reply);
+        });
+    }});
+
+    cases.push_back({"rpc_error/rpc_error_throws", [minTimeMs](const std::string& name) {
+        const std::string reply = ERROR_REPLY;
+        return measure(name, minTimeMs, reply.size(), 1, [&] {
+            try {
+                NetconfClient::check_for_rpc_error(reply);
+            } catch (const NetconfException& e) {
+                doNotOptimize(e);
+            }
+        });
+    }});
+
+    for (size_t size : {size_t(64) << 10, size_t(1) << 20}) {
+        const std::string name = "rpc_error/data_reply/" + std::to_string(size >> 10) + "KiB";
+        cases.push_back({name, [size, minTimeMs](const std::string& name) {
+            const std::string reply = makeDataReply(size);
+            return measure(name, minTimeMs, reply.size(), 1, [&] {
+                NetconfClient::check_for_rpc_error(reply);
+            });
+        }});
+    }
+}
+
+void threadPoolCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"thread_pool/enqueue_get_round_trip", [minTimeMs](const std::string& name) {
+        ThreadPool& pool = get_pool();
+        return measure(name, minTimeMs, 0, 1, [&] {
+            doNotOptimize(pool.enqueue([] { return 1; }).get());
+        });
+    }});
+
+    // Shaped like the *_async lambdas: a shared_ptr and two strings.
+    cases.push_back({"thread_pool/enqueue_batch_1000", [minTimeMs](const std::string& name) {
+        ThreadPool& pool = get_pool();
+        auto owner = std::make_shared<int>(0);
+        const std::string target = "candidate";
+        const std::string config = std::string(256, 'x');
+        std::vector<std::future<size_t>> futures;
+        futures.reserve(1000);
+        return measure(name, minTimeMs, 0, 1000, [&] {
+            for (int i = 0; i < 1000; ++i) {
+                futures.push_back(pool.enqueue([owner, target, config] {
+                    return target.size() + config.size();
+                }));
+            }
+            for (auto& f : futures) doNotOptimize(f.get());
+            futures.clear();
+        });
+    }});
+}
+
+void eventBusCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"event_bus/emit_next_event", [minTimeMs](const std::string& name) {
+        NotificationEventBus& bus = NotificationEventBus::instance();
+        bus.clear();
+        NotificationHealthEvent event;
+        event.type = "malformed_notification";
+        event.timestamp = current_notification_event_timestamp_utc();
+        event.label = "core-router-17";
+        event.hostname = "10.0.0.17";
+        event.port = 830;
+        event.message =
+            "Received EOM-delimited data that is not a valid NETCONF notification; queued malformed frame";
+        return measure(name, minTimeMs, 0, 1, [&] {
+            bus.emit(event);
+            doNotOptimize(bus.next_event(0));
+        });
+    }});
+}
+
+void rpcStatsCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"rpc_stats/record", [minTimeMs](const std::string& name) {
+        RpcStats stats;
+        RpcTrace trace;
+        trace.submitted = Clock::now();
+        trace.scheduled = trace.submitted + std::chrono::microseconds(3);
+        trace.started = trace.scheduled + std::chrono::microseconds(20);
+        trace.written = trace.started + std::chrono::microseconds(15);
+        trace.first_byte = trace.written + std::chrono::milliseconds(2);
+        trace.received = trace.first_byte + std::chrono::microseconds(400);
+        trace.finished = trace.received + std::chrono::microseconds(30);
+        return measure(name, minTimeMs, 0, 1, [&] {
+            stats.record(trace);
+        });
+    }});
+
+    cases.push_back({"rpc_stats/snapshot", [minTimeMs](const std::string& name) {
+        RpcStats stats;
+        RpcTrace trace;
+        trace.started = Clock::now();
+        for (int i = 0; i < 10000; ++i) {
+            trace.finished = trace.started + std::chrono::microseconds(100 + i);
+            stats.record(trace);
+        }
+        return measure(name, minTimeMs, 0, 1, [&] {
+            doNotOptimize(stats.snapshot());
+        });
+    }});
+}
+
+void metricsCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"metrics/counter_inc", [minTimeMs](const std::string& name) {
+        auto counter = MetricsRegistry::instance().counter(
+            "bench_counter", "benchmark", {{"case", "counter_inc"}});
+        return measure(name, minTimeMs, 0, 1, [&] {
+            counter->inc();
+        });
+    }});
+
+    cases.push_back({"metrics/histogram_observe", [minTimeMs](const std::string& name) {
+        auto histogram = MetricsRegistry::instance().histogram(
+            "bench_duration_seconds", "benchmark", {{"case", "histogram_observe"}});
+        std::uint64_t nanos = 0;
+        return measure(name, minTimeMs, 0, 1, [&] {
+            histogram->observe_nanos(nanos);
+            nanos = (nanos + 7919) % 20000000;
+        });
+    }});
+
+    // A 1000-device fleet: five collectors and three owned series per client.
+    cases.push_back({"metrics/render_1000_clients", [minTimeMs](const std::string& name) {
+        MetricsRegistry& registry = MetricsRegistry::instance();
+        std::vector<std::shared_ptr<MetricCounter>> counters;
+        std::vector<std::shared_ptr<MetricHistogram>> histograms;
+        std::vector<MetricsRegistration> registrations;
+        for (int i = 0; i < 1000; ++i) {
+            const MetricLabels labels = {{"device", "leaf-" + std::to_string(i)}};
+            counters.push_back(registry.counter("bench_rpcs", "benchmark", labels));
+            counters.push_back(registry.counter("bench_rpc_failures", "benchmark", labels));
+            histograms.push_back(registry.histogram("bench_rpc_duration_seconds", "benchmark", labels));
+            for (const char* family : {"bench_a", "bench_b", "bench_c", "bench_d", "bench_e"}) {
+                registrations.push_back(registry.collect(
+                    MetricType::Gauge, family, "benchmark", labels, [] { return 1.0; }));
+            }
+        }
+        return measure(name, minTimeMs, 0, 1, [&] {
+            doNotOptimize(registry.render_openmetrics());
+        });
+    }});
+}
+
+// A span with tracing off must cost no more than a load and a branch.
+void traceCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"trace/span_disabled", [minTimeMs](const std::string& name) {
+        TraceRecorder::stop();
+        return measure(name, minTimeMs, 0, 1, [&] {
+            TraceSpan span("bench", "span_disabled");
+        });
+    }});
+
+    cases.push_back({"trace/span_enabled", [minTimeMs](const std::string& name) {
+        TraceRecorder::start(4096);
+        Result result = measure(name, minTimeMs, 0, 1, [&] {
+            TraceSpan span("bench", "span_enabled", "leaf-01", "bytes", 512);
+        });
+        TraceRecorder::stop();
+        return result;
+    }});
+}
+
+// A flooded log statement must cost a rate-limit check, not a stderr write.
+void logCases(std::vector<Case>& cases, int minTimeMs) {
+    cases.push_back({"log/below_level", [minTimeMs](const std::string& name) {
+        return measure(name, minTimeMs, 0, 1, [&] {
+            NETX_LOG(LogLevel::Debug, "below level " << 42);
+        });
+    }});
+
+    cases.push_back({"log/rate_limited", [minTimeMs](const std::string& name) {
+        Logger::set_sink([](LogLevel, const std::string&) {});
+        Result result = measure(name, minTimeMs, 0, 1, [&] {
+            NETX_LOG(LogLevel::Warning, "rate limited " << 42);
+        });
+        Logger::flush();
+        Logger::set_sink(nullptr);
+        return result;
+    }});
+
+    cases.push_back({"log/enqueued", [minTimeMs](const std::string& name) {
+        Logger::set_sink([](LogLevel, const std::string&) {});
+        Logger::set_rate_limit(0);
+        Result result = measure(name, minTimeMs, 0, 1, [&] {
+            NETX_LOG(LogLevel::Warning, "queue_size=" << 1024 << " dropped_delta=" << 7);
+        });
+        Logger::flush();
+        Logger::set_rate_limit(Logger::DEFAULT_RATE_LIMIT);
+        Logger::set_sink(nullptr);
+        return result;
+    }});
+}
+
+void printJson(const std::vector<Result>& results, int minTimeMs, int workers) {
+    std::printf("{\n  \"context\": {\n");
+    std::printf("    \"benchmark\": \"hot_path_microbenchmarks\",\n");
+#if defined(__VERSION__)
+    std::printf("    \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    std::printf("    \"cplusplus\": %ld,\n", static_cast<long>(__cplusplus));
+#ifdef NDEBUG
+    std::printf("    \"assertions\": false,\n");
+#else
+    std::printf("    \"assertions\": true,\n");
+#endif
+    std::printf("    \"hardware_concurrency\": %u,\n", std::thread::hardware_concurrency());
+    std::printf("    \"pool_workers\": %d,\n", workers);
+    std::printf("    \"min_time_ms\": %d,\n", minTimeMs);
+    std::printf("    \"repetitions\": %d\n  },\n", REPETITIONS);
+
+    std::printf("  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::printf("    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.1f, \"ns_per_op_min\": %.1f",
+            r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.nsMedian, r.nsMin);
+        if (r.bytesPerOp > 0) {
+            std::printf(", \"bytes_per_op\": %zu, \"mib_per_s\": %.1f",
+                r.bytesPerOp, static_cast<double>(r.bytesPerOp) / r.nsMedian * 1e9 / (1 << 20));
+        }
+        if (r.itemsPerOp > 1) {
+            std::printf(", \"items_per_op\": %zu, \"ns_per_item\": %.1f",
+                r.itemsPerOp, r.nsMedian / static_cast<double>(r.itemsPerOp));
+        }
+        std::printf("}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int minTimeMs = 500;
+    int workers = 4;
+    std::string filter;
+    if (argc > 1) minTimeMs = std::atoi(argv[1]);
+    if (argc > 2) workers = std::atoi(argv[2]);
+    if (argc > 3) filter = argv[3];
+
+    init_global_pool(workers);
+
+    std::vector<Case> cases;
+    framingCases(cases, minTimeMs);
+    splitCases(cases, minTimeMs);
+    validateCases(cases, minTimeMs);
+    rpcErrorCases(cases, minTimeMs);
+    threadPoolCases(cases, minTimeMs);
+    eventBusCases(cases, minTimeMs);
+    rpcStatsCases(cases, minTimeMs);
+    metricsCases(cases, minTimeMs);
+    traceCases(cases, minTimeMs);
+    logCases(cases, minTimeMs);
+
+    std::vector<Result> results;
+    for (const Case& c : cases) {
+        if (filter.empty() || c.name.find(filter) != std::string::npos) {
+            results.push_back(c.run(c.name));
+        }
+    }
+
+    printJson(results, minTimeMs, workers);
+    return 0;
+}
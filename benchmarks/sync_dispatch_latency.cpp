@@ -0,0 +1,129 @@
+// sync_dispatch_latency.cpp
+//
+// Round-trip latency of a synchronous call on one client strand.
+//
+// "pool round trip" is the old *_sync path: the call is queued on the strand,
+// a pool worker runs it and the caller blocks on the future. "inline dispatch"
+// is the current path: Strand::dispatch() runs the call on the caller's
+// thread once the strand is free.
+//
+// Each call does a few microseconds of work, standing in for a reply that is
+// already buffered. The second pass keeps every worker busy with other
+// strands' tasks, which is the situation where queueing delay dominates.
+//
+//   sync_dispatch_latency [workers] [calls] [work_us] [busy_ms]
+
+#include "strand.hpp"
+#include "thread_pool_global.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    int workers = 4;
+    size_t calls = 20000;
+    int workUs = 2;
+    int busyMs = 1;
+};
+
+void spinFor(std::chrono::microseconds d) {
+    const auto until = Clock::now() + d;
+    while (Clock::now() < until) {
+    }
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+void report(const char* name, std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    std::printf(
+        "  %-18s p50=%9.1fus  p99=%9.1fus  p99.9=%9.1fus  max=%9.1fus\n",
+        name,
+        percentile(samples, 0.50),
+        percentile(samples, 0.99),
+        percentile(samples, 0.999),
+        samples.empty() ? 0.0 : samples.back()
+    );
+}
+
+template <class Call>
+std::vector<double> measure(const Options& opt, Call call) {
+    std::vector<double> samples;
+    samples.reserve(opt.calls);
+    for (size_t i = 0; i < opt.calls; ++i) {
+        const auto started = Clock::now();
+        call();
+        samples.push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - started).count()
+        );
+    }
+    return samples;
+}
+
+void run(const char* scenario, const Options& opt) {
+    std::printf("%s\n", scenario);
+    auto strand = std::make_shared<Strand>();
+    const auto work = std::chrono::microseconds(opt.workUs);
+
+    std::vector<double> pooled = measure(opt, [&] {
+        strand->enqueue([work] { spinFor(work); }).get();
+    });
+    report("pool round trip", pooled);
+
+    std::vector<double> inline_ = measure(opt, [&] {
+        strand->dispatch([work] { spinFor(work); });
+    });
+    report("inline dispatch", inline_);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (argc > 1) opt.workers = std::atoi(argv[1]);
+    if (argc > 2) opt.calls = static_cast<size_t>(std::strtoul(argv[2], nullptr, 10));
+    if (argc > 3) opt.workUs = std::atoi(argv[3]);
+    if (argc > 4) opt.busyMs = std::atoi(argv[4]);
+
+    std::printf(
+        "workers=%d calls=%zu work_us=%d busy_ms=%d (caller-observed latency per call)\n",
+        opt.workers, opt.calls, opt.workUs, opt.busyMs
+    );
+
+    init_global_pool(opt.workers);
+    run("idle pool:", opt);
+
+    // Keep one long task per worker queued at all times on unrelated strands.
+    std::atomic<bool> stop{false};
+    std::vector<std::shared_ptr<Strand>> background;
+    std::vector<std::thread> feeders;
+    for (int i = 0; i < opt.workers; ++i) {
+        background.push_back(std::make_shared<Strand>());
+        feeders.emplace_back([&, i] {
+            while (!stop.load()) {
+                background[i]->enqueue([&opt] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(opt.busyMs));
+                }).get();
+            }
+        });
+    }
+    run("busy pool:", opt);
+
+    stop.store(true);
+    for (auto& t : feeders) t.join();
+    return 0;
+}
@@ -0,0 +1,307 @@
+// thread_pool_allocations.cpp
+//
+// Heap allocations per submission for a typical *_async call.
+//
+// Each submitted lambda captures what the client methods capture: a
+// shared_ptr to the client and two strings (target and config) longer than
+// the small-string buffer. A CompletionHook scope is open around every call
+// with a pending completion as its target, like the one in the Python
+// bindings: it holds the loop's completion queue and queues itself when
+// ready. Strings and completions are built before the measured window and
+// moved in, so only allocations made by the submission path itself (task
+// wrapper, promise/future state, queue nodes) are counted.
+//
+// Four paths are measured:
+// - packaged_task: the previous enqueue() (shared_ptr<packaged_task> wrapped
+//   in a std::function, on a mutex/condvar queue), as a baseline
+// - pool_task: ThreadPool::enqueue()
+// - strand: Strand::enqueue() on the global pool, round-robin over eight
+//   strands, which is the path every client *_async call takes
+// - strand_cross_free: as strand, but the futures are dropped on another
+//   thread, so each promise state is freed away from the thread that
+//   allocated it
+//
+//   thread_pool_allocations [workers] [tasks] [batch]
+
+#include "completion_hook.hpp"
+#include "strand.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_global.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::atomic<unsigned long long> gAllocations{0};
+}
+
+void* operator new(std::size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// enqueue() as it was before PoolTask and the pooled promise state.
+class PackagedTaskPool {
+public:
+    explicit PackagedTaskPool(size_t nThreads) {
+        for (size_t i = 0; i < nThreads; ++i) {
+            threads_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mtx_);
+                        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~PackagedTaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    template<class F>
+    auto enqueue(F&& f) -> std::future<typename std::result_of<F()>::type> {
+        using Ret = typename std::result_of<F()>::type;
+        auto taskPtr = std::make_shared<std::packaged_task<Ret()>>(std::forward<F>(f));
+        std::future<Ret> fut = taskPtr->get_future();
+        CompletionHook::Callback onReady = CompletionHook::take();
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            tasks_.emplace_back([taskPtr, onReady]() {
+                (*taskPtr)();
+                if (onReady) onReady();
+            });
+        }
+        cv_.notify_one();
+        return fut;
+    }
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_ = false;
+};
+
+// Client *_async calls go through the client's strand.
+class StrandTarget {
+public:
+    static constexpr size_t STRANDS = 8;
+
+    explicit StrandTarget(size_t nThreads) {
+        init_global_pool(static_cast<int>(nThreads));
+        for (size_t i = 0; i < STRANDS; ++i) {
+            strands_.push_back(std::make_shared<Strand>());
+        }
+    }
+
+    template<class F>
+    auto enqueue(F&& f) -> std::future<typename std::result_of<F()>::type> {
+        return strands_[next_++ % STRANDS]->enqueue(std::forward<F>(f));
+    }
+
+private:
+    std::vector<std::shared_ptr<Strand>> strands_;
+    size_t next_ = 0;
+};
+
+struct FakeClient {
+    std::atomic<unsigned long> calls{0};
+};
+
+// Stand-ins for the bindings' LoopCompletionQueue and PendingCompletion.
+struct FakeLoopQueue {
+    std::atomic<unsigned long> completions{0};
+    void push(const std::shared_ptr<struct FakeCompletion>&) noexcept {
+        completions.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct FakeCompletion : CompletionHook::Target,
+                        std::enable_shared_from_this<FakeCompletion> {
+    explicit FakeCompletion(std::shared_ptr<FakeLoopQueue> queue) : queue(std::move(queue)) {}
+
+    void ready() override { queue->push(shared_from_this()); }
+
+    std::shared_ptr<FakeLoopQueue> queue;
+};
+
+// Waits for and drops batches of futures on its own thread. Batches are
+// swapped in and out of reserved vectors, so handing one over does not
+// allocate.
+class Releaser {
+public:
+    explicit Releaser(size_t batch) {
+        pending_.reserve(batch);
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    ~Releaser() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    /// Hand over futures; they come back empty once the previous batch is gone.
+    void hand(std::vector<std::future<std::string>>& futures) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return pending_.empty(); });
+        pending_.swap(futures);
+        cv_.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return pending_.empty(); });
+    }
+
+private:
+    void loop() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        for (;;) {
+            cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+            if (pending_.empty()) return;
+            for (auto& fut : pending_) {
+                fut.get();
+            }
+            pending_.clear();
+            cv_.notify_all();
+        }
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::future<std::string>> pending_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+struct Options {
+    size_t workers = 4;
+    size_t tasks = 100000;
+    size_t batch = 64;
+};
+
+template <class Pool>
+void run(const char* name, const Options& opt, bool crossFree = false) {
+    Pool pool(opt.workers);
+    auto client = std::make_shared<FakeClient>();
+    auto loopQueue = std::make_shared<FakeLoopQueue>();
+    std::unique_ptr<Releaser> releaser;
+    if (crossFree) {
+        releaser.reset(new Releaser(opt.batch));
+    }
+
+    auto submitAll = [&](size_t count) {
+        std::vector<std::string> targets(opt.batch, std::string(48, 't'));
+        std::vector<std::string> configs(opt.batch, std::string(256, 'c'));
+        std::vector<CompletionHook::Callback> hooks(opt.batch);
+        std::vector<std::future<std::string>> futures;
+        futures.reserve(opt.batch);
+
+        for (size_t done = 0; done < count; done += opt.batch) {
+            const size_t n = std::min(opt.batch, count - done);
+
+            // Refill the capture strings and build the completions outside the
+            // measured window; the bindings pay for those per call anyway.
+            const unsigned long long paused = gAllocations.load();
+            for (size_t i = 0; i < n; ++i) {
+                targets[i].assign(48, 't');
+                configs[i].assign(256, 'c');
+                hooks[i] = std::make_shared<FakeCompletion>(loopQueue);
+            }
+            gAllocations.store(paused);
+
+            for (size_t i = 0; i < n; ++i) {
+                CompletionHook::Scope scope(std::move(hooks[i]));
+                futures.push_back(pool.enqueue(
+                    [client, target = std::move(targets[i]), config = std::move(configs[i])]() {
+                        client->calls.fetch_add(target.size() + config.size(), std::memory_order_relaxed);
+                        return std::string("<ok/>");
+                    }
+                ));
+            }
+            if (releaser) {
+                releaser->hand(futures);
+                continue;
+            }
+            for (auto& fut : futures) {
+                fut.get();
+            }
+            futures.clear();
+        }
+        if (releaser) {
+            releaser->wait();
+        }
+    };
+
+    // Warm up thread-local caches, queues and the string buffers.
+    submitAll(opt.batch * 16);
+
+    const unsigned long long before = gAllocations.load();
+    submitAll(opt.tasks);
+    const unsigned long long allocations = gAllocations.load() - before;
+
+    std::printf(
+        "%-18s allocations=%llu per_task=%.3f\n",
+        name, allocations, static_cast<double>(allocations) / static_cast<double>(opt.tasks)
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (argc > 1) opt.workers = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    if (argc > 2) opt.tasks = static_cast<size_t>(std::strtoul(argv[2], nullptr, 10));
+    if (argc > 3) opt.batch = static_cast<size_t>(std::strtoul(argv[3], nullptr, 10));
+    if (opt.workers == 0 || opt.batch == 0 || opt.tasks == 0) {
+        std::fprintf(stderr, "workers, tasks and batch must be greater than 0\n");
+        return 1;
+    }
+
+    std::printf(
+        "workers=%zu tasks=%zu batch=%zu (heap allocations made by enqueue and completion)\n",
+        opt.workers, opt.tasks, opt.batch
+    );
+
+    run<PackagedTaskPool>("packaged_task", opt);
+    run<ThreadPool>("pool_task", opt);
+    run<StrandTarget>("strand", opt);
+    run<StrandTarget>("strand_cross_free", opt, true);
+    return 0;
+}
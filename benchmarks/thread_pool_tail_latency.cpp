@@ -0,0 +1,194 @@
+// thread_pool_tail_latency.cpp
+//
+// Mixed short/long task benchmark for the global ThreadPool.
+//
+// A steady stream of short tasks (a few microseconds of CPU, like parsing a
+// reply) is mixed with a small fraction of long blocking tasks (a sleep that
+// stands in for a slow device RPC). For every short task we record the time
+// from enqueue() to the moment it starts running and report percentiles.
+//
+// The previous least-inflight dispatcher is reproduced below as a baseline:
+// it never moves queued work, so a short task that lands behind a long one
+// waits for it even when other workers are idle.
+//
+//   thread_pool_tail_latency [workers] [tasks] [long_every] [long_ms] [gap_us]
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Least-inflight dispatch with one mutex/condvar queue per worker and no
+// stealing (the pool implementation before work stealing).
+class LeastInflightPool {
+public:
+    explicit LeastInflightPool(size_t nThreads) {
+        for (size_t i = 0; i < nThreads; ++i) {
+            workers_.emplace_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < nThreads; ++i) {
+            threads_.emplace_back([this, i] {
+                Worker& worker = *workers_[i];
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(worker.mtx);
+                        worker.cv.wait(lock, [&] { return stop_ || !worker.tasks.empty(); });
+                        if (stop_ && worker.tasks.empty()) return;
+                        task = std::move(worker.tasks.front());
+                        worker.tasks.pop();
+                    }
+                    worker.inflight.fetch_sub(1, std::memory_order_relaxed);
+                    task();
+                }
+            });
+        }
+    }
+
+    ~LeastInflightPool() {
+        for (auto& w : workers_) {
+            std::lock_guard<std::mutex> lock(w->mtx);
+            stop_ = true;
+        }
+        for (auto& w : workers_) w->cv.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    template <class F>
+    std::future<void> enqueue(F&& f) {
+        auto task = std::make_shared<std::packaged_task<void()>>(std::forward<F>(f));
+        auto fut = task->get_future();
+        size_t best = 0;
+        size_t bestCount = SIZE_MAX;
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            size_t cnt = workers_[i]->inflight.load(std::memory_order_relaxed);
+            if (cnt < bestCount) {
+                bestCount = cnt;
+                best = i;
+            }
+        }
+        Worker& worker = *workers_[best];
+        {
+            std::lock_guard<std::mutex> lock(worker.mtx);
+            worker.tasks.emplace([task] { (*task)(); });
+            worker.inflight.fetch_add(1, std::memory_order_relaxed);
+        }
+        worker.cv.notify_one();
+        return fut;
+    }
+
+private:
+    struct Worker {
+        std::queue<std::function<void()>> tasks;
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::atomic<size_t> inflight{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    bool stop_ = false;
+};
+
+struct Options {
+    size_t workers = 4;
+    size_t tasks = 20000;
+    size_t longEvery = 500; // one long task per this many tasks
+    int longMs = 20;
+    int gapUs = 20;
+};
+
+void spinFor(std::chrono::microseconds d) {
+    const auto until = Clock::now() + d;
+    while (Clock::now() < until) {
+    }
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+template <class Pool>
+void run(const char* name, const Options& opt) {
+    std::vector<double> waitUs(opt.tasks, -1.0);
+    std::vector<std::future<void>> futures;
+    futures.reserve(opt.tasks);
+
+    const auto started = Clock::now();
+    {
+        Pool pool(opt.workers);
+        for (size_t i = 0; i < opt.tasks; ++i) {
+            const bool isLong = opt.longEvery > 0 && i % opt.longEvery == 0;
+            const auto submitted = Clock::now();
+            if (isLong) {
+                futures.push_back(pool.enqueue([&opt] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(opt.longMs));
+                }));
+            } else {
+                futures.push_back(pool.enqueue([&waitUs, i, submitted] {
+                    waitUs[i] = std::chrono::duration<double, std::micro>(
+                        Clock::now() - submitted).count();
+                    spinFor(std::chrono::microseconds(5));
+                }));
+            }
+            // Open-loop arrivals. The submitter sleeps between tasks like an
+            // event loop blocked in epoll, rather than spinning on a core.
+            std::this_thread::sleep_for(std::chrono::microseconds(opt.gapUs));
+        }
+        for (auto& f : futures) f.get();
+    }
+    const double wallMs =
+        std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+
+    std::vector<double> samples;
+    samples.reserve(opt.tasks);
+    for (double v : waitUs) {
+        if (v >= 0.0) samples.push_back(v);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    std::printf(
+        "%-16s short=%zu  p50=%9.1fus  p99=%9.1fus  p99.9=%9.1fus  max=%9.1fus  wall=%7.1fms\n",
+        name,
+        samples.size(),
+        percentile(samples, 0.50),
+        percentile(samples, 0.99),
+        percentile(samples, 0.999),
+        samples.empty() ? 0.0 : samples.back(),
+        wallMs
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (argc > 1) opt.workers = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    if (argc > 2) opt.tasks = static_cast<size_t>(std::strtoul(argv[2], nullptr, 10));
+    if (argc > 3) opt.longEvery = static_cast<size_t>(std::strtoul(argv[3], nullptr, 10));
+    if (argc > 4) opt.longMs = std::atoi(argv[4]);
+    if (argc > 5) opt.gapUs = std::atoi(argv[5]);
+
+    std::printf(
+        "workers=%zu tasks=%zu long_every=%zu long_ms=%d gap_us=%d "
+        "(enqueue -> start latency of short tasks)\n",
+        opt.workers, opt.tasks, opt.longEvery, opt.longMs, opt.gapUs
+    );
+
+    run<LeastInflightPool>("least-inflight", opt);
+    run<ThreadPool>("work-stealing", opt);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// async_waiter.hpp
+#ifndef ASYNC_WAITER_HPP
+#define ASYNC_WAITER_HPP
+
+#include "completion_hook.hpp"
+#include "deadline_timer.hpp"
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <utility>
+
+// A registered continuation that completes a std::future without a thread.
+//
+// The waiter is created on the calling thread and claims that thread's
+// CompletionHook, so the future behaves like one returned by
+// ThreadPool::enqueue(): whoever completes it (a producer, or the
+// DeadlineTimer on timeout) also runs the hook. Only the first complete() or
+// fail() has any effect.
+template <class T>
+class AsyncWaiter {
+public:
+    AsyncWaiter() : on_ready_(CompletionHook::take()) {}
+    virtual ~AsyncWaiter() = default;
+
+    AsyncWaiter(const AsyncWaiter&) = delete;
+    AsyncWaiter& operator=(const AsyncWaiter&) = delete;
+
+    std::future<T> future() { return promise_.get_future(); }
+
+    bool complete(T value) {
+        if (done_.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        promise_.set_value(std::move(value));
+        notify();
+        return true;
+    }
+
+    bool fail(std::exception_ptr error) {
+        if (done_.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        promise_.set_exception(std::move(error));
+        notify();
+        return true;
+    }
+
+    /// Timeout registered for this waiter, if any; cancel it on completion.
+    DeadlineTimer::Handle timer;
+
+private:
+    void notify() {
+        CompletionHook::Callback on_ready = std::move(on_ready_);
+        on_ready_ = nullptr;
+        if (on_ready) on_ready();
+    }
+
+    std::promise<T> promise_;
+    CompletionHook::Callback on_ready_;
+    std::atomic<bool> done_{false};
+};
+
+#endif // ASYNC_WAITER_HPP
@@ -0,0 +1,110 @@
+// channel_capture.hpp
+#ifndef CHANNEL_CAPTURE_HPP
+#define CHANNEL_CAPTURE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Opt-in capture of the raw bytes read from RPC and notification channels,
+// for replaying real device traffic through the framing code offline (see
+// benchmarks/capture_replay.cpp).
+//
+// File layout, in host byte order: the 8-byte magic "PNXCAP01", then one
+// record per channel read:
+//
+//   u64 nanos since start()   u8 channel   u8 reserved   u16 label bytes
+//   i32 fd                    u32 data bytes              label   data
+//
+// Records from every session go into one file under one lock, written
+// through a 1 MiB stdio buffer. While capture is off every call site costs one
+// relaxed load.
+class ChannelCapture {
+public:
+    enum class Channel : std::uint8_t {
+        Rpc = 0,
+        Notification = 1,
+    };
+
+    struct Totals {
+        std::uint64_t records = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    // Names the session of the RPC reads made on this thread while it is
+    // open; the static RPC read loops do not know which client they serve.
+    class Scope {
+    public:
+        Scope(const std::string& label, int fd) noexcept
+            : label_(label), fd_(fd), previous_(current())
+        {
+            current() = this;
+        }
+
+        ~Scope() {
+            current() = previous_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        friend class ChannelCapture;
+
+        const std::string& label_;
+        int fd_;
+        Scope* previous_;
+    };
+
+    static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Truncate path and start capturing into it. Throws std::runtime_error
+    /// if it cannot be opened; a capture already running is stopped first.
+    static void start(const std::string& path);
+    /// Stop capturing and close the file; returns what was written.
+    static Totals stop() noexcept;
+
+    static void record(Channel channel, const std::string& label, int fd,
+                       const char* data, std::size_t size) noexcept;
+    /// An RPC channel read, attributed to the innermost open Scope. Reads
+    /// outside any Scope, such as hellos, are not recorded.
+    static void record_rpc(const char* data, std::size_t size) noexcept;
+
+private:
+    static Scope*& current() noexcept {
+        static thread_local Scope* scope = nullptr;
+        return scope;
+    }
+
+    static std::atomic<bool> enabled_;
+};
+
+struct CaptureRecord {
+    std::int64_t nanos = 0;
+    ChannelCapture::Channel channel = ChannelCapture::Channel::Rpc;
+    int fd = -1;
+    std::string label;
+    std::string data;
+};
+
+// Reads a file written by ChannelCapture, one record at a time.
+class CaptureReader {
+public:
+    /// Throws std::runtime_error if path cannot be opened or is not a capture.
+    explicit CaptureReader(const std::string& path);
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    /// False at the end of the file. Throws std::runtime_error on a
+    /// truncated record.
+    bool next(CaptureRecord& out);
+
+private:
+    std::FILE* file_;
+};
+
+#endif // CHANNEL_CAPTURE_HPP
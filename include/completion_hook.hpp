@@ -0,0 +1,93 @@
+// completion_hook.hpp
+#ifndef COMPLETION_HOOK_HPP
+#define COMPLETION_HOOK_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Thread-scoped completion callback for future-returning APIs.
+//
+// Code that turns a std::future into an event-loop awaitable opens a Scope
+// around the call that creates the future. The producer of that future
+// (ThreadPool::enqueue) take()s the callback and runs it once the future is
+// ready, so the consumer is woken by the completion itself instead of polling.
+// If nothing takes the callback, Scope::taken() stays false and the caller has
+// to arrange its own wakeup.
+class CompletionHook {
+public:
+    // Whatever waits for the future: the bindings' pending completion, a
+    // coroutine awaiter. ready() runs on the thread that completed the future.
+    class Target {
+    public:
+        virtual void ready() = 0;
+
+    protected:
+        ~Target() = default;
+    };
+
+    // Reference to a Target, held by the producer until the future is ready.
+    // It is one shared_ptr, so moving it into a pool task never allocates.
+    class Callback {
+    public:
+        Callback() noexcept = default;
+        Callback(std::nullptr_t) noexcept {}
+
+        template <class T>
+        Callback(std::shared_ptr<T> target) noexcept : target_(std::move(target)) {}
+
+        /// A callback that does not own target; target must outlive it.
+        static Callback borrow(Target& target) noexcept {
+            return Callback(std::shared_ptr<Target>(std::shared_ptr<Target>(), &target));
+        }
+
+        explicit operator bool() const noexcept { return target_ != nullptr; }
+        void operator()() const { target_->ready(); }
+        void swap(Callback& other) noexcept { target_.swap(other.target_); }
+
+    private:
+        std::shared_ptr<Target> target_;
+    };
+
+    class Scope {
+    public:
+        explicit Scope(Callback callback)
+            : callback_(std::move(callback)), previous_(current())
+        {
+            current() = this;
+        }
+
+        ~Scope() {
+            current() = previous_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        bool taken() const noexcept { return !callback_; }
+
+    private:
+        friend class CompletionHook;
+
+        Callback callback_;
+        Scope* previous_;
+    };
+
+    /// Claim the innermost open scope's callback on this thread, if any.
+    static Callback take() noexcept {
+        Callback callback;
+        Scope* scope = current();
+        if (scope) {
+            callback.swap(scope->callback_);
+        }
+        return callback;
+    }
+
+private:
+    static Scope*& current() noexcept {
+        static thread_local Scope* scope = nullptr;
+        return scope;
+    }
+};
+
+#endif // COMPLETION_HOOK_HPP
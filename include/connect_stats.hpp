@@ -0,0 +1,142 @@
+// connect_stats.hpp
+#ifndef CONNECT_STATS_HPP
+#define CONNECT_STATS_HPP
+
+#include "latency_histogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// The steps of opening one NETCONF session, in order.
+//
+//   dns        libssh2 session init and hostname resolution
+//   tcp        socket setup and TCP connect
+//   handshake  SSH key exchange
+//   auth       user authentication
+//   channel    session channel open
+//   subsystem  netconf subsystem request
+//   hello      server hello read and client hello sent
+enum class ConnectPhase : int {
+    Dns = 0,
+    Tcp,
+    Handshake,
+    Auth,
+    Channel,
+    Subsystem,
+    Hello,
+};
+
+constexpr std::size_t CONNECT_PHASE_COUNT = 7;
+
+const char* connect_phase_name(ConnectPhase phase);
+
+// Why a connect failed, within the phase it failed in.
+//
+//   timeout   the phase used up its time budget
+//   refused   the TCP connection was refused
+//   rejected  the device rejected the credentials
+//   error     anything else: protocol error, bad hello, socket error
+enum class ConnectFailure : int {
+    None = 0,
+    Timeout,
+    Refused,
+    Rejected,
+    Error,
+};
+
+constexpr std::size_t CONNECT_FAILURE_COUNT = 5;
+
+const char* connect_failure_name(ConnectFailure failure);
+
+// Monotonic timing of one connection attempt for one session.
+struct ConnectTrace {
+    using Clock = std::chrono::steady_clock;
+
+    /// Starts the dns phase. budget is the time a phase may take; a failure
+    /// after it has run out counts as a timeout. A budget <= 0 means none.
+    explicit ConnectTrace(bool notification_session = false,
+                          std::chrono::milliseconds budget = std::chrono::milliseconds(0));
+
+    /// End the current phase and start the next one.
+    void enter(ConnectPhase next, std::chrono::milliseconds budget);
+    /// Classify the failure of the current phase explicitly.
+    void mark_failure(ConnectFailure kind) noexcept { failure = kind; }
+    void succeed();
+    void fail(const std::string& error);
+
+    std::int64_t total_nanos() const noexcept;
+
+    bool notification_session = false;
+    std::string label;  // device label, carried by the USDT probes
+    Clock::time_point started;
+    Clock::time_point finished;
+    ConnectPhase phase = ConnectPhase::Dns;  // current, or the one that failed
+    std::array<std::int64_t, CONNECT_PHASE_COUNT> phase_nanos;  // -1 if not completed
+    bool done = false;
+    bool failed = false;
+    ConnectFailure failure = ConnectFailure::None;
+    std::string message;
+
+private:
+    void close_phase(Clock::time_point now);
+
+    Clock::time_point phase_started_;
+    std::chrono::milliseconds phase_budget_{0};
+};
+
+struct ConnectRecord {
+    std::string label;
+    std::string hostname;
+    int port = 0;
+    ConnectTrace trace;
+};
+
+struct ConnectStatsSnapshot {
+    std::uint64_t attempts = 0;
+    std::uint64_t succeeded = 0;
+    std::uint64_t failed = 0;
+    // Completed phases of every attempt; total covers successful attempts.
+    std::array<LatencySummary, CONNECT_PHASE_COUNT> phases{};
+    LatencySummary total;
+    // failures[phase][kind]
+    std::array<std::array<std::uint64_t, CONNECT_FAILURE_COUNT>, CONNECT_PHASE_COUNT> failures{};
+    std::vector<ConnectRecord> slowest;          // slowest first
+    std::vector<ConnectRecord> recent_failures;  // oldest first
+};
+
+// Process-wide aggregation of every client's connection attempts, RPC and
+// notification sessions alike. Cumulative until reset(), so a reconnect storm
+// can be measured by resetting before it.
+class ConnectStats {
+public:
+    static constexpr std::size_t SLOWEST_KEPT = 10;
+    static constexpr std::size_t RECENT_FAILURES_KEPT = 32;
+
+    static ConnectStats& instance();
+
+    void record(const std::string& label, const std::string& hostname, int port,
+                const ConnectTrace& trace);
+    ConnectStatsSnapshot snapshot() const;
+    void reset();
+
+private:
+    ConnectStats() = default;
+
+    mutable std::mutex mtx_;
+    std::uint64_t attempts_ = 0;
+    std::uint64_t succeeded_ = 0;
+    std::uint64_t failed_ = 0;
+    std::array<LatencyHistogram, CONNECT_PHASE_COUNT> phases_;
+    LatencyHistogram total_;
+    std::array<std::array<std::uint64_t, CONNECT_FAILURE_COUNT>, CONNECT_PHASE_COUNT> failures_{};
+    std::vector<ConnectRecord> slowest_;  // min-heap on total time
+    std::deque<ConnectRecord> recent_failures_;
+};
+
+#endif // CONNECT_STATS_HPP
@@ -0,0 +1,53 @@
+// deadline_timer.hpp
+#ifndef DEADLINE_TIMER_HPP
+#define DEADLINE_TIMER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Process-wide one-shot timer service.
+//
+// A single background thread fires callbacks at their deadline. It exists so
+// that async waits with a timeout can be registered as continuations instead
+// of parking a pool worker for the whole timeout. Callbacks run on the timer
+// thread and must be short: complete a promise, push a completion.
+class DeadlineTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    struct Handle {
+        Clock::time_point deadline{};
+        std::uint64_t id = 0;  // 0 means no timer
+    };
+
+    static DeadlineTimer& instance();
+
+    Handle schedule(Clock::time_point deadline, Callback callback);
+
+    /// Returns false when the timer already fired or was never scheduled.
+    bool cancel(const Handle& handle);
+
+    std::size_t pending() const;
+
+private:
+    DeadlineTimer();
+
+    void run();
+
+    using Key = std::pair<Clock::time_point, std::uint64_t>;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::map<Key, Callback> timers_;
+    std::uint64_t next_id_ = 1;
+    std::thread thread_;
+};
+
+#endif // DEADLINE_TIMER_HPP
@@ -0,0 +1,45 @@
+// event_fd_signal.hpp
+#ifndef EVENT_FD_SIGNAL_HPP
+#define EVENT_FD_SIGNAL_HPP
+
+#include <atomic>
+#include <mutex>
+
+// Edge-style readiness signal backed by a Linux eventfd, for event loops that
+// watch file descriptors (asyncio add_reader, selectors, epoll).
+//
+// The eventfd is opened lazily on the first fd() call, so producers pay a
+// single relaxed load while nobody watches. A consumer calls arm() and then
+// re-checks its queue; the next notify() writes the eventfd exactly once and
+// disarms. Producers that publish before notify() never lose a wakeup.
+class EventFdSignal {
+public:
+    EventFdSignal() = default;
+    ~EventFdSignal();
+
+    EventFdSignal(const EventFdSignal&) = delete;
+    EventFdSignal& operator=(const EventFdSignal&) = delete;
+
+    /// Returns the eventfd, opening it on first use. Throws std::runtime_error.
+    int fd();
+
+    /// Request a write on the next notify(). Re-check the watched state after
+    /// arming; the fence pairs with the one in notify().
+    void arm() noexcept;
+
+    /// Producer side. Writes the eventfd if armed, or unconditionally when
+    /// force is set (used for shutdown-style wakeups).
+    void notify(bool force = false) noexcept;
+
+    /// Reset the eventfd counter so a level-triggered watcher stops firing.
+    void drain() noexcept;
+
+private:
+    void write_one() noexcept;
+
+    std::mutex open_mtx_;
+    std::atomic<int> fd_{-1};
+    std::atomic<bool> armed_{false};
+};
+
+#endif // EVENT_FD_SIGNAL_HPP
@@ -0,0 +1,85 @@
+// futex_event.hpp
+#ifndef FUTEX_EVENT_HPP
+#define FUTEX_EVENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Futex-backed wait/notify primitive for lock-free queues.
+//
+// Waiters park on a 32-bit sequence word. notify_one() is a fence plus a load
+// when nobody is parked, and only enters the kernel when a waiter actually
+// sleeps. The readiness predicate is re-checked after registering as parked,
+// so a producer that publishes before calling notify_one() never loses a
+// wakeup.
+class FutexEvent {
+public:
+    FutexEvent() = default;
+    FutexEvent(const FutexEvent&) = delete;
+    FutexEvent& operator=(const FutexEvent&) = delete;
+
+    /// Park until ready() is true or the deadline passes.
+    /// Returns the final value of ready().
+    template <class Ready>
+    bool wait_until(Ready ready, std::chrono::steady_clock::time_point deadline) {
+        for (;;) {
+            if (ready()) {
+                return true;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+
+            if (park_unless(ready,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now))) {
+                return true;
+            }
+        }
+    }
+
+    /// Park until ready() is true, without a timeout.
+    template <class Ready>
+    void wait(Ready ready) {
+        while (!ready()) {
+            if (park_unless(ready, std::chrono::nanoseconds(-1))) {
+                return;
+            }
+        }
+    }
+
+    void notify_one() noexcept;
+    void notify_all() noexcept;
+
+private:
+    /// Registers as parked, re-checks ready() and sleeps unless it became
+    /// true. Returns true when ready() was observed. Negative timeout means
+    /// no timeout.
+    template <class Ready>
+    bool park_unless(Ready& ready, std::chrono::nanoseconds timeout) {
+        const std::uint32_t seq = seq_.load(std::memory_order_acquire);
+
+        // Pairs with the fence in notify_one(): either the producer sees us
+        // parked, or we see its item before sleeping.
+        parked_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (ready()) {
+            parked_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        park(seq, timeout);
+        parked_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void park(std::uint32_t seq, std::chrono::nanoseconds timeout) noexcept;
+
+    std::atomic<std::uint32_t> seq_{0};
+    std::atomic<std::uint32_t> parked_{0};
+};
+
+#endif // FUTEX_EVENT_HPP
@@ -0,0 +1,57 @@
+// latency_histogram.hpp
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-size log-linear latency histogram in the style of HdrHistogram.
+//
+// Values are nanoseconds. Below 1 µs buckets are 128 ns wide; above that every
+// power of two is split into 8 linear sub-buckets, so a bucket is at most
+// 12.5% of its value wide. Values above ~275 s land in the last bucket. The
+// whole histogram is under 1 KiB, so one per phase per client is affordable.
+//
+// Not synchronized; the owner serializes record(), merge() and the readers.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int UNIT_SHIFT = 7;  // 128 ns
+    static constexpr std::size_t BUCKET_COUNT = 232;
+
+    void record(std::uint64_t nanos) noexcept;
+    void merge(const LatencyHistogram& other) noexcept;
+    void clear() noexcept;
+
+    std::uint64_t count() const noexcept { return count_; }
+    std::uint64_t max() const noexcept { return max_; }
+    double mean() const noexcept;
+    /// Upper bound of the bucket holding the q-quantile (0 < q <= 1), capped
+    /// at the largest value recorded. 0 when empty.
+    std::uint64_t value_at_quantile(double q) const noexcept;
+
+    static std::size_t bucket_for(std::uint64_t nanos) noexcept;
+    static std::uint64_t bucket_upper_bound(std::size_t bucket) noexcept;
+
+private:
+    std::array<std::uint32_t, BUCKET_COUNT> counts_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+// Percentiles of a LatencyHistogram in microseconds.
+struct LatencySummary {
+    std::uint64_t count = 0;
+    double mean_us = 0;
+    double p50_us = 0;
+    double p90_us = 0;
+    double p99_us = 0;
+    double p999_us = 0;
+    double max_us = 0;
+};
+
+LatencySummary summarize_latency(const LatencyHistogram& histogram);
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,117 @@
+// logger.hpp
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+
+// Values match Python's logging levels so they pass straight through the
+// Python handler.
+enum class LogLevel : int {
+    Debug = 10,
+    Info = 20,
+    Warning = 30,
+    Error = 40,
+};
+
+const char* log_level_name(LogLevel level) noexcept;
+
+// One NETX_LOG() call site. Holds the site's rate limit window: at most
+// Logger::rate_limit() messages per second get through, and the number held
+// back is appended to the next one that does.
+class LogSite {
+public:
+    LogSite(const char* file, int line) noexcept : file_(file), line_(line) {}
+
+    LogSite(const LogSite&) = delete;
+    LogSite& operator=(const LogSite&) = delete;
+
+    /// Counts the message against this second's budget.
+    bool admit(std::int64_t now_nanos, std::uint32_t limit) noexcept;
+    /// Messages held back since the last admitted one; resets the count.
+    std::uint64_t take_suppressed() noexcept {
+        return suppressed_.exchange(0, std::memory_order_relaxed);
+    }
+
+    const char* file() const noexcept { return file_; }
+    int line() const noexcept { return line_; }
+
+private:
+    const char* file_;
+    int line_;
+    std::atomic<std::int64_t> window_start_{0};
+    std::atomic<std::uint32_t> in_window_{0};
+    std::atomic<std::uint64_t> suppressed_{0};
+};
+
+struct LogStats {
+    std::uint64_t written = 0;
+    std::uint64_t dropped = 0;     // ring was full
+    std::uint64_t suppressed = 0;  // over a site's rate limit
+    LogLevel level = LogLevel::Info;
+    std::uint32_t rate_limit = 0;
+};
+
+// Process-wide asynchronous logger. Use it instead of std::cerr.
+//
+// NETX_LOG() formats the message only if the level is enabled and the site is
+// under its rate limit, copies it into a fixed-size lock-free ring and
+// returns; it never waits on the writer or on stderr, so it is safe under
+// _notif_queue_mtx and on the reactor thread. A background thread writes the
+// ring to stderr or to the handler set with set_sink(). When the ring is full
+// the message is dropped and counted. Messages are cut to 240 bytes.
+class Logger {
+public:
+    using Sink = std::function<void(LogLevel, const std::string&)>;
+
+    static constexpr std::uint32_t DEFAULT_RATE_LIMIT = 10;
+
+    static bool enabled(LogLevel level) noexcept {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+    static void set_level(LogLevel level) noexcept;
+
+    /// Messages per site per second; 0 turns rate limiting off.
+    static void set_rate_limit(std::uint32_t per_site_per_second) noexcept;
+    static std::uint32_t rate_limit() noexcept {
+        return rate_limit_.load(std::memory_order_relaxed);
+    }
+
+    /// Route messages to sink instead of stderr; an empty sink restores
+    /// stderr. Waits for the writer to finish the message it is handing to
+    /// the previous sink. The sink runs on the writer thread and must not
+    /// call NETX_LOG() itself.
+    static void set_sink(Sink sink);
+
+    /// Wait until every message logged before the call has been written, or
+    /// the timeout passes. Returns false on timeout.
+    static bool flush(std::int64_t timeout_ms = 1000);
+
+    static LogStats stats() noexcept;
+
+    /// Used by NETX_LOG(); false if the site is over its rate limit.
+    static bool admit(LogSite& site) noexcept;
+    static void write(LogLevel level, LogSite& site, const std::string& message) noexcept;
+
+private:
+    static std::atomic<int> level_;
+    static std::atomic<std::uint32_t> rate_limit_;
+};
+
+#define NETX_LOG(level, message)                                              \
+    do {                                                                      \
+        static LogSite netx_log_site_(__FILE__, __LINE__);                    \
+        if (Logger::enabled(level) && Logger::admit(netx_log_site_)) {        \
+            try {                                                             \
+                std::ostringstream netx_log_stream_;                          \
+                netx_log_stream_ << message;                                  \
+                Logger::write((level), netx_log_site_, netx_log_stream_.str()); \
+            } catch (...) {                                                   \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#endif // LOGGER_HPP
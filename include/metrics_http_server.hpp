@@ -0,0 +1,40 @@
+// metrics_http_server.hpp
+#ifndef METRICS_HTTP_SERVER_HPP
+#define METRICS_HTTP_SERVER_HPP
+
+#include "event_fd_signal.hpp"
+
+#include <mutex>
+#include <thread>
+
+// Minimal scrape endpoint for MetricsRegistry. Listens on 127.0.0.1 only and
+// answers GET /metrics with the OpenMetrics text; anything else gets a 404.
+// One thread serves one connection at a time, which is plenty for a scraper.
+class MetricsHttpServer {
+public:
+    static MetricsHttpServer& instance();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    /// Start listening and return the bound port; port 0 picks a free one.
+    /// Returns the current port if already running. Throws std::runtime_error.
+    int start(int port);
+    void stop();
+    int port() const;
+
+private:
+    MetricsHttpServer() = default;
+    ~MetricsHttpServer();
+
+    void serve(int listen_fd, int stop_fd);
+    static void handle(int client_fd);
+
+    mutable std::mutex mtx_;
+    std::thread thread_;
+    EventFdSignal stop_signal_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+};
+
+#endif // METRICS_HTTP_SERVER_HPP
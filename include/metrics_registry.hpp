@@ -0,0 +1,162 @@
+// metrics_registry.hpp
+#ifndef METRICS_REGISTRY_HPP
+#define METRICS_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class MetricType {
+    Counter,
+    Gauge,
+    Histogram,
+};
+
+// Label name/value pairs of one series, in the order they are rendered.
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Monotonic counter. Rendered as <name>_total.
+class MetricCounter {
+public:
+    void inc(std::uint64_t n = 1) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+class MetricGauge {
+public:
+    void set(std::int64_t v) noexcept { value_.store(v, std::memory_order_relaxed); }
+    void add(std::int64_t delta) noexcept { value_.fetch_add(delta, std::memory_order_relaxed); }
+    /// Raise to v if v is larger; for high watermarks.
+    void raise(std::int64_t v) noexcept;
+    std::int64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+// Duration histogram with fixed buckets from 100 us to 10 s. Observing is a
+// handful of relaxed atomic adds; buckets are cumulated when rendered.
+class MetricHistogram {
+public:
+    static constexpr std::size_t BUCKET_COUNT = 17;  // 16 bounds and +Inf
+
+    static std::uint64_t upper_bound_nanos(std::size_t bucket) noexcept;  // 0 for +Inf
+    static const char* upper_bound_label(std::size_t bucket) noexcept;
+
+    void observe_nanos(std::uint64_t nanos) noexcept;
+
+    std::uint64_t bucket(std::size_t i) const noexcept { return buckets_[i].load(std::memory_order_relaxed); }
+    std::uint64_t sum_nanos() const noexcept { return sum_nanos_.load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<std::uint64_t> sum_nanos_{0};
+};
+
+class MetricsRegistry;
+
+// Keeps a collect() callback registered. Once it is destroyed or reset the
+// callback is not running and will not run again.
+class MetricsRegistration {
+public:
+    MetricsRegistration() = default;
+    ~MetricsRegistration() { reset(); }
+
+    MetricsRegistration(MetricsRegistration&& other) noexcept;
+    MetricsRegistration& operator=(MetricsRegistration&& other) noexcept;
+    MetricsRegistration(const MetricsRegistration&) = delete;
+    MetricsRegistration& operator=(const MetricsRegistration&) = delete;
+
+    void reset() noexcept;
+
+private:
+    friend class MetricsRegistry;
+
+    MetricsRegistry* registry_ = nullptr;
+    std::string name_;
+    MetricLabels labels_;
+    std::uint64_t id_ = 0;
+};
+
+// Process-wide metric families, rendered as OpenMetrics text.
+//
+// Components own their series: counter(), gauge() and histogram() hand out
+// shared_ptrs and the registry keeps weak ones, so a series disappears with
+// the client or reactor that updates it. Updates never touch the registry.
+// Its mutex is only taken to register and to render, so a scrape reads
+// atomics and never waits on a session, queue or pool lock.
+//
+// Series are keyed by name and labels, and owners with the same labels share
+// them: asking again for a live series returns the same object, and collect()
+// callbacks registered under the same name and labels are summed. Two
+// clients for the same device therefore add up instead of shadowing each
+// other.
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    std::shared_ptr<MetricCounter> counter(
+        const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    std::shared_ptr<MetricGauge> gauge(
+        const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    std::shared_ptr<MetricHistogram> histogram(
+        const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /// A counter or gauge read by calling read() at render time, for values
+    /// that already live in an atomic elsewhere. read() runs under the
+    /// registry mutex and must not block. The series renders the sum of every
+    /// live collect() with the same name and labels.
+    MetricsRegistration collect(
+        MetricType type, const std::string& name, const std::string& help,
+        const MetricLabels& labels, std::function<double()> read);
+
+    /// OpenMetrics text exposition, ending in "# EOF". Drops series whose
+    /// owner is gone.
+    std::string render_openmetrics();
+
+private:
+    friend class MetricsRegistration;
+
+    struct Collector {
+        std::uint64_t id;
+        std::function<double()> read;
+    };
+
+    struct Series {
+        std::weak_ptr<MetricCounter> counter;
+        std::weak_ptr<MetricGauge> gauge;
+        std::weak_ptr<MetricHistogram> histogram;
+        std::vector<Collector> collectors;  // summed when rendered
+    };
+
+    struct Family {
+        MetricType type;
+        std::string help;
+        std::map<MetricLabels, Series> series;
+    };
+
+    MetricsRegistry() = default;
+
+    Family& family_locked(const std::string& name, const std::string& help, MetricType type);
+    void unregister(const std::string& name, const MetricLabels& labels, std::uint64_t id) noexcept;
+
+    std::mutex mtx_;
+    std::map<std::string, Family> families_;
+    std::uint64_t next_collector_id_ = 1;
+};
+
+#endif // METRICS_REGISTRY_HPP
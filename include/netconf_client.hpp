@@ -4,6 +4,13 @@
 #define NETCONF_CLIENT_HPP
 #include "notification_reactor.hpp"
 #include "notification_event_bus.hpp"
+#include "notification_ring.hpp"
+#include "notification_stream.hpp"
+#include "connect_stats.hpp"
+#include "metrics_registry.hpp"
+#include "netconf_framing.hpp"
+#include "rpc_stats.hpp"
+#include "thread_pool.hpp"
 #include <mutex>
 #include <condition_variable>
 #include <deque>
@@ -21,6 +28,9 @@
 #include <sys/epoll.h>
 #include <chrono>
 
+class NotificationWaiter;
+class Strand;
+
 // RAII Wrapper for an epoll file descriptor.
 class EpollRAII {
 public:
@@ -158,6 +168,20 @@ class SocketRAII {
     };
     using ChannelPtr = std::unique_ptr<LIBSSH2_CHANNEL, Libssh2ChannelDeleter>;
     
+// Where on_notification_input() takes notification bytes from: the SSH
+// channel when the reactor calls on_notification_ready(), or a capture file
+// in the replay benchmark.
+class NotificationInput {
+public:
+    virtual ~NotificationInput() = default;
+
+    /// Every byte available now; empty if there is none.
+    virtual std::string read() = 0;
+    /// Wait up to timeout_ms for more bytes. Returns >0 when read() has
+    /// more and 0 on timeout; throws if the input is gone.
+    virtual int poll(int timeout_ms) = 0;
+};
+
 //
 // NetconfClient class using RAII wrappers.
 //
@@ -224,10 +248,41 @@ public:
                                    const std::string& config,
                                    bool do_validate=false);
     std::string next_notification(int timeout_ms = 10);
+    std::vector<std::string> next_notifications(int max_items = 100, int timeout_ms = 10);
     std::vector<std::string> peek_notifications(int max_items = 100);
     std::size_t notification_queue_size();
-    void on_notification_ready(int fd);
+    void attach_notification_stream(std::shared_ptr<NotificationStream> stream);
+    void detach_notification_stream();
+
+    // Event-loop delivery. notification_ready_fd() becomes readable after
+    // arm_notification_ready_fd() once a notification is queued, or whenever
+    // the subscription ends. Arming returns true if items are already queued.
+    int notification_ready_fd();
+    bool arm_notification_ready_fd() noexcept;
+    void drain_notification_ready_fd() noexcept;
+    /// Non-blocking batch drain; never waits and does not require an active
+    /// subscription.
+    std::vector<std::string> try_next_notifications(std::size_t max_items);
+    /// Only one event-loop waiter may own the ready fd at a time.
+    bool claim_notification_ready_fd() noexcept;
+    void release_notification_ready_fd() noexcept;
+
+    /// Reactor callback; returns the bytes read from the channel.
+    std::size_t on_notification_ready(int fd);
+    /// on_notification_ready() with the bytes taken from input instead of
+    /// the channel: the same framing, guards, queueing and health events.
+    std::size_t on_notification_input(int fd, NotificationInput& input);
     void mark_notification_dead() noexcept;
+    /// Reactor hook: on_notification_ready(fd) took `took`, at or over
+    /// `threshold`; slow_calls counts those since the previous report.
+    void report_slow_notification_handler(int fd,
+                                          std::chrono::nanoseconds took,
+                                          std::chrono::nanoseconds threshold,
+                                          std::uint64_t slow_calls) noexcept;
+
+    const std::string& label() const noexcept { return label_; }
+    const std::string& hostname() const noexcept { return hostname_; }
+    int port() const noexcept { return port_; }
 
     // ----------------------- Synchronous Wrappers -------------------------
 
@@ -255,28 +310,44 @@ public:
     std::string receive_notification_sync();
 
     // ----------------------- Asynchronous Wrappers -------------------------
-    std::future<bool> connect_async();
-    std::future<void> disconnect_async();
-    std::future<std::string> send_rpc_async(const std::string& rpc);
-    std::future<std::string> get_async(const std::string& filter = "");
+    // RPC wrappers run on the client's strand; priority selects the pool lane.
+    std::future<bool> connect_async(TaskPriority priority = TaskPriority::Normal);
+    std::future<void> disconnect_async(TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> send_rpc_async(const std::string& rpc,
+                                            TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> get_async(const std::string& filter = "",
+                                       TaskPriority priority = TaskPriority::Normal);
     std::future<std::string> get_config_async(const std::string& source="running",
-                                              const std::string& filter="");
+                                              const std::string& filter="",
+                                              TaskPriority priority = TaskPriority::Normal);
     std::future<std::string> edit_config_async(const std::string& target,
                                                const std::string& config,
-                                               bool do_validate=false);
+                                               bool do_validate=false,
+                                               TaskPriority priority = TaskPriority::Normal);
     std::future<std::string> subscribe_async(const std::string& stream="NETCONF",
-                                             const std::string& filter="");
+                                             const std::string& filter="",
+                                             TaskPriority priority = TaskPriority::Normal);
     std::future<std::string> copy_config_async(const std::string& target,
-                                               const std::string& source);
-    std::future<std::string> delete_config_async(const std::string& target);
-    std::future<std::string> validate_async(const std::string& source="running");
-    std::future<std::string> lock_async(const std::string& target="running");
-    std::future<std::string> unlock_async(const std::string& target="running");
-    std::future<std::string> commit_async();
+                                               const std::string& source,
+                                               TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> delete_config_async(const std::string& target,
+                                                 TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> validate_async(const std::string& source="running",
+                                            TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> lock_async(const std::string& target="running",
+                                        TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> unlock_async(const std::string& target="running",
+                                          TaskPriority priority = TaskPriority::Normal);
+    std::future<std::string> commit_async(TaskPriority priority = TaskPriority::Normal);
     std::future<std::string> locked_edit_config_async(const std::string& target,
                                                       const std::string& config,
-                                                      bool do_validate=false);
+                                                      bool do_validate=false,
+                                                      TaskPriority priority = TaskPriority::Normal);
     std::future<std::string> next_notification_async(int timeout_ms = 10);
+    std::future<std::vector<std::string>> next_notifications_async(
+        int max_items = 100,
+        int timeout_ms = 10
+    );
     
     // Disconnect method (common to all modes)
     bool is_subscription_active() const;
@@ -285,11 +356,25 @@ public:
     void clear_notification_queue();
     void delete_subscription();
 
+    // Throws NetconfException if xml_reply is an <rpc-reply> carrying an
+    // <rpc-error>. Replies that do not parse are let through.
+    static void check_for_rpc_error(const std::string &xml_reply);
+
+    // Phase breakdown of the RPCs sent on this client's session, over the
+    // last one to two RpcStats::WINDOWs, plus the most recent RPC.
+    RpcStatsSnapshot rpc_stats() const;
+    void reset_rpc_stats();
+
+    // Phase timing of the last connection attempt of the RPC or notification
+    // session; done is false if there has been none.
+    ConnectTrace last_connect(bool notification_session = false) const;
+
 private:
     static std::string read_until_eom_blocking(
         LIBSSH2_CHANNEL *chan,
         LIBSSH2_SESSION *sess,
-        int read_timeout
+        int read_timeout,
+        RpcTrace* trace = nullptr
     );
     static std::string read_until_eom_non_blocking(
         LIBSSH2_CHANNEL *chan,
@@ -297,7 +382,8 @@ private:
         int soc_fd,
         int read_timeout,
         int notif_incomplete_max_kb = -1,
-        int notif_incomplete_timeout = -1
+        int notif_incomplete_timeout = -1,
+        RpcTrace* trace = nullptr
     );
     static std::string build_client_hello();
     static void send_client_hello_blocking(
@@ -313,18 +399,34 @@ private:
         LIBSSH2_CHANNEL *chan,
         LIBSSH2_SESSION *sess,
         const std::string& rpc,
-        int read_timeout
+        int read_timeout,
+        RpcTrace* trace = nullptr
     );
     static std::string send_rpc_non_blocking_func(
         LIBSSH2_CHANNEL *chan,
         LIBSSH2_SESSION *sess,
         int soc_fd,
         const std::string& rpc,
-        int read_timeout
+        int read_timeout,
+        RpcTrace* trace = nullptr
     );
-    static void check_for_rpc_error(const std::string &xml_reply);
     static std::string resolve_hostname_blocking(const std::string &hostname);
     static std::string resolve_hostname_non_blocking(const std::string &hostname, int timeout_seconds);
+    // Stamp the start of an RPC on the session; the queueing phases come from
+    // the strand task it runs in, if it is the first RPC of that task.
+    static RpcTrace begin_rpc_trace();
+    void finish_rpc_trace(RpcTrace& trace, bool failed, std::size_t reply_bytes = 0);
+    // Close trace, keep it as this client's last connect and add it to
+    // ConnectStats. error is null on success.
+    void finish_connect_trace(ConnectTrace& trace, const char* error) noexcept;
+    void register_metrics();
+    void require_active_notification_subscription() const;
+    // Per-client notification reads throw while a stream is attached.
+    void require_no_notification_stream() const;
+    void emit_queue_recovered_event_if_needed();
+    void register_notification_waiter(std::shared_ptr<NotificationWaiter> waiter, int timeout_ms);
+    void serve_notification_waiters();
+    void expire_notification_waiter(const std::weak_ptr<NotificationWaiter>& weak_waiter);
     NotificationHealthEvent make_notification_health_event_locked(
         const std::string& type,
         const std::string& message,
@@ -350,7 +452,20 @@ private:
     int notif_drop_event_threshold_;
     std::string resolved_host_;
 
-    std::mutex session_mutex_;
+    // Serializes every session operation of this client without pinning a
+    // pool worker per queued call.
+    std::shared_ptr<Strand> strand_;
+    RpcStats rpc_stats_;
+    // Exported through MetricsRegistry with device, host and port labels.
+    std::shared_ptr<MetricCounter> rpcs_metric_;
+    std::shared_ptr<MetricCounter> rpc_failures_metric_;
+    std::shared_ptr<MetricHistogram> rpc_duration_metric_;
+    // Collectors reading the notification counters below; cleared first in
+    // the destructor so no scrape reads a dying client.
+    std::vector<MetricsRegistration> metrics_registrations_;
+    mutable std::mutex connect_trace_mutex_;
+    ConnectTrace last_connect_;
+    ConnectTrace last_notif_connect_;
     std::mutex ssh_mutex_;
     std::mutex dns_mutex_;
 
@@ -363,6 +478,9 @@ private:
     //
     // Protected by _notif_queue_mtx.
     std::string _notif_rx_buffer;
+    // How far split_notification_frames() has searched _notif_rx_buffer.
+    // Reset with every clear() or move of the buffer.
+    NotificationScanState _notif_rx_scan;
     bool _notif_rx_partial_timer_active = false;
     std::chrono::steady_clock::time_point _notif_rx_partial_started_at{};
 
@@ -377,17 +495,38 @@ private:
     bool notif_is_connected_ = false;
     bool notif_is_blocking_  = false;
 
+    // Producer-side lock: held by the reactor while parsing and enqueueing.
+    // Consumers never take it on the fast path.
     std::mutex _notif_queue_mtx;
-    std::condition_variable  _notif_queue_cv;
-    std::deque<std::string>  _notif_queue;
 
-    // Protected by _notif_queue_mtx. Used for health events and debugging.
-    std::uint64_t _notif_enqueued_count = 0;
-    std::uint64_t _notif_dropped_queue_full_count = 0;
+    // Serializes consumers (next_notification, peek, clear) of the SPSC ring.
+    std::mutex _notif_consumer_mtx;
+    NotificationRing _notif_queue;
+
+    // Written under _notif_queue_mtx. Used for health events and debugging;
+    // atomic so MetricsRegistry can read them without the lock.
+    std::atomic<std::uint64_t> _notif_enqueued_count{0};
+    std::atomic<std::uint64_t> _notif_dropped_queue_full_count{0};
     std::uint64_t _notif_last_drop_event_count = 0;
-    std::uint64_t _notif_incomplete_count = 0;
-    std::size_t _notif_queue_high_watermark = 0;
-    bool _notif_queue_full_state = false;
+    std::atomic<std::uint64_t> _notif_incomplete_count{0};
+    std::atomic<std::size_t> _notif_queue_high_watermark{0};
+    // Set by the producer, cleared by whichever consumer observes free capacity.
+    std::atomic<bool> _notif_queue_full_state{false};
+
+    // When set, notifications are published to this merged stream instead of
+    // the per-client queue. Protected by _notif_queue_mtx; consumers check
+    // _notif_stream_attached instead.
+    std::shared_ptr<NotificationStream> _notif_stream;
+    std::atomic<bool> _notif_stream_attached{false};
+
+    std::atomic<bool> _notif_ready_fd_claimed{false};
+
+    // Async consumers registered by next_notification(s)_async(). Served by
+    // the reactor after it enqueues and expired by the DeadlineTimer; only
+    // non-empty while the ring is empty. Taken before _notif_consumer_mtx.
+    std::mutex _notif_waiters_mtx;
+    std::deque<std::shared_ptr<NotificationWaiter>> _notif_waiters;
+    std::atomic<std::size_t> _notif_waiter_count{0};
 
     // RAII-managed resources:
     SessionPtr session_;      // libssh2 session.
@@ -0,0 +1,403 @@
+// netconf_coro.hpp
+#ifndef NETCONF_CORO_HPP
+#define NETCONF_CORO_HPP
+
+// C++20 coroutine API over the future-returning NetconfClient methods.
+//
+// Requires a C++20 compiler. -DPYNETX_ENABLE_COROUTINES=ON sets
+// CMAKE_CXX_STANDARD to 20 for the whole project, so netx_core, the Python
+// module and the benchmarks are all built as C++20 then. Without the option
+// everything is C++14 and this header is unavailable.
+//
+//   CoTask<void> reconfigure(CoNetconfClient device, std::string config) {
+//       co_await device.lock("candidate");
+//       co_await device.edit_config("candidate", config);
+//       co_await device.commit();
+//       co_await device.unlock("candidate");
+//   }
+//
+//   std::future<void> done = co_spawn(reconfigure(device, config));
+//
+// A co_await on a client call suspends the coroutine frame; no thread waits
+// for the reply. The awaiter claims the call's CompletionHook, the same
+// mechanism the Python bindings use to resolve asyncio futures, and resumes
+// the coroutine on a pool worker once the strand has produced the result.
+// co_spawn() honours an open CompletionHook in turn, so a binding can hand a
+// whole coroutine sequence to wrap_future() like any other *_async call.
+//
+// Coroutine bodies run on pool workers: keep them non-blocking, and use the
+// *_async awaiters instead of *_sync calls.
+//
+// GCC 12.2 and older destroy a lambda written directly inside a co_await
+// operand twice (co_await await_future([p] { ... })). Bind such lambdas to a
+// local first; the CoNetconfClient methods are not affected.
+
+#if __cplusplus < 202002L
+#error "netconf_coro.hpp requires C++20 (configure with -DPYNETX_ENABLE_COROUTINES=ON)"
+#endif
+
+#include "completion_hook.hpp"
+#include "netconf_client.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_global.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ----------------------- Awaiting a std::future -------------------------
+
+// Awaits the std::future returned by make(). The future's producer (a pool
+// task, strand task or registered waiter) runs the CompletionHook opened in
+// await_suspend(); the hook and await_suspend() meet at a two-party
+// rendezvous so the frame is resumed exactly once, after the future is
+// stored. A future that did not take the hook is used as is when it is
+// already ready; a pending one makes co_await throw std::logic_error, since
+// nothing would ever resume the frame.
+template <class MakeFuture>
+class FutureAwaiter : public CompletionHook::Target {
+public:
+    using Future = std::invoke_result_t<MakeFuture&>;
+    using Value = decltype(std::declval<Future&>().get());
+
+    explicit FutureAwaiter(MakeFuture make) : make_(std::move(make)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+
+        bool hooked = false;
+        {
+            CompletionHook::Scope scope(CompletionHook::Callback::borrow(*this));
+            future_ = make_();
+            hooked = scope.taken();
+        }
+
+        if (!hooked) {
+            if (future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                return false;
+            }
+            throw std::logic_error("await_future: the future did not take the CompletionHook");
+        }
+
+        // Last to arrive resumes. If the result is already here, continue
+        // inline instead of bouncing through the pool.
+        return !last_to_arrive();
+    }
+
+    Value await_resume() { return future_.get(); }
+
+    void ready() override { arrive(); }
+
+private:
+    bool last_to_arrive() noexcept {
+        return arrivals_.fetch_add(1, std::memory_order_acq_rel) == 1;
+    }
+
+    void arrive() {
+        if (last_to_arrive()) {
+            // Completions fire on strand runners, reactor threads and the
+            // timer thread; never resume the coroutine body there.
+            std::coroutine_handle<> handle = handle_;
+            get_pool().post([handle]() { handle.resume(); });
+        }
+    }
+
+    MakeFuture make_;
+    Future future_;
+    std::coroutine_handle<> handle_;
+    std::atomic<int> arrivals_{0};
+};
+
+template <class MakeFuture>
+FutureAwaiter<MakeFuture> await_future(MakeFuture make) {
+    return FutureAwaiter<MakeFuture>(std::move(make));
+}
+
+// ----------------------- CoTask -------------------------
+
+template <class T>
+class CoTask;
+
+namespace coro_detail {
+
+    template <class T>
+    struct PromiseBase {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template <class Promise>
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<Promise> self
+            ) noexcept {
+                std::coroutine_handle<> next = self.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    template <class T>
+    struct Promise : PromiseBase<T> {
+        std::optional<T> value;
+
+        CoTask<T> get_return_object();
+
+        template <class U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+        T take() {
+            if (this->error) std::rethrow_exception(this->error);
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct Promise<void> : PromiseBase<void> {
+        CoTask<void> get_return_object();
+
+        void return_void() noexcept {}
+
+        void take() {
+            if (error) std::rethrow_exception(error);
+        }
+    };
+
+} // namespace coro_detail
+
+// Lazily started coroutine returning T. Awaiting it starts it and resumes the
+// awaiting coroutine when it finishes; co_spawn() runs it detached.
+template <class T = void>
+class [[nodiscard]] CoTask {
+public:
+    using promise_type = coro_detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit CoTask(Handle handle) noexcept : handle_(handle) {}
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask() {
+        if (handle_) handle_.destroy();
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    Handle handle_;
+};
+
+namespace coro_detail {
+
+    template <class T>
+    CoTask<T> Promise<T>::get_return_object() {
+        return CoTask<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline CoTask<void> Promise<void>::get_return_object() {
+        return CoTask<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+
+    // Eager, self-destroying driver used by co_spawn().
+    struct Detached {
+        struct promise_type {
+            Detached get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+
+    template <class T>
+    Detached drive(CoTask<T> task, std::promise<T> promise, CompletionHook::Callback on_ready) {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(task);
+                promise.set_value();
+            } else {
+                promise.set_value(co_await std::move(task));
+            }
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        if (on_ready) on_ready();
+    }
+
+} // namespace coro_detail
+
+/// Start task now, on the calling thread up to its first suspension, and
+/// return a future for its result. Claims the caller's CompletionHook like
+/// ThreadPool::enqueue(), so the future can be handed to wrap_future().
+template <class T>
+std::future<T> co_spawn(CoTask<T> task) {
+    std::promise<T> promise;
+    std::future<T> future = promise.get_future();
+    coro_detail::drive(std::move(task), std::move(promise), CompletionHook::take());
+    return future;
+}
+
+// ----------------------- Client awaiters -------------------------
+
+// Awaitable view of a NetconfClient. Each method forwards to the matching
+// *_async method, so calls keep the client's strand ordering and priority
+// lanes. Copies share the client.
+class CoNetconfClient {
+public:
+    explicit CoNetconfClient(std::shared_ptr<NetconfClient> client)
+        : client_(std::move(client)) {}
+
+    const std::shared_ptr<NetconfClient>& client() const noexcept { return client_; }
+
+    auto connect(TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, priority] { return c->connect_async(priority); });
+    }
+
+    auto disconnect(TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, priority] { return c->disconnect_async(priority); });
+    }
+
+    auto send_rpc(std::string rpc, TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, rpc = std::move(rpc), priority] {
+            return c->send_rpc_async(rpc, priority);
+        });
+    }
+
+    auto get(std::string filter = "", TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, filter = std::move(filter), priority] {
+            return c->get_async(filter, priority);
+        });
+    }
+
+    auto get_config(
+        std::string source = "running",
+        std::string filter = "",
+        TaskPriority priority = TaskPriority::Normal
+    ) const {
+        return await_future([c = client_, source = std::move(source),
+                             filter = std::move(filter), priority] {
+            return c->get_config_async(source, filter, priority);
+        });
+    }
+
+    auto edit_config(
+        std::string target,
+        std::string config,
+        bool do_validate = false,
+        TaskPriority priority = TaskPriority::Normal
+    ) const {
+        return await_future([c = client_, target = std::move(target),
+                             config = std::move(config), do_validate, priority] {
+            return c->edit_config_async(target, config, do_validate, priority);
+        });
+    }
+
+    auto copy_config(
+        std::string target,
+        std::string source,
+        TaskPriority priority = TaskPriority::Normal
+    ) const {
+        return await_future([c = client_, target = std::move(target),
+                             source = std::move(source), priority] {
+            return c->copy_config_async(target, source, priority);
+        });
+    }
+
+    auto delete_config(std::string target, TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, target = std::move(target), priority] {
+            return c->delete_config_async(target, priority);
+        });
+    }
+
+    auto validate(std::string source = "running", TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, source = std::move(source), priority] {
+            return c->validate_async(source, priority);
+        });
+    }
+
+    auto lock(std::string target = "running", TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, target = std::move(target), priority] {
+            return c->lock_async(target, priority);
+        });
+    }
+
+    auto unlock(std::string target = "running", TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, target = std::move(target), priority] {
+            return c->unlock_async(target, priority);
+        });
+    }
+
+    auto commit(TaskPriority priority = TaskPriority::Normal) const {
+        return await_future([c = client_, priority] { return c->commit_async(priority); });
+    }
+
+    auto subscribe(
+        std::string stream = "NETCONF",
+        std::string filter = "",
+        TaskPriority priority = TaskPriority::Normal
+    ) const {
+        return await_future([c = client_, stream = std::move(stream),
+                             filter = std::move(filter), priority] {
+            return c->subscribe_async(stream, filter, priority);
+        });
+    }
+
+    auto next_notification(int timeout_ms = 10) const {
+        return await_future([c = client_, timeout_ms] {
+            return c->next_notification_async(timeout_ms);
+        });
+    }
+
+    auto next_notifications(int max_items = 100, int timeout_ms = 10) const {
+        return await_future([c = client_, max_items, timeout_ms] {
+            return c->next_notifications_async(max_items, timeout_ms);
+        });
+    }
+
+private:
+    std::shared_ptr<NetconfClient> client_;
+};
+
+#endif // NETCONF_CORO_HPP
@@ -0,0 +1,57 @@
+// netconf_framing.hpp
+#ifndef NETCONF_FRAMING_HPP
+#define NETCONF_FRAMING_HPP
+
+// NETCONF 1.0 EOM framing shared by the RPC read loops and the notification
+// receive buffer. Nothing here touches a socket, so the benchmarks drive the
+// same code with synthetic replies and notification streams.
+
+#include <cstddef>
+#include <string>
+
+/// Append a chunk read from the channel to response and report whether the
+/// reply now holds the ]]>]]> marker. Only the new bytes, plus the few before
+/// them that could start a split marker, are searched.
+bool append_until_eom(std::string& response, const char* data, std::size_t size);
+
+/// True if frame_without_eom parses as XML with a <notification> root.
+bool is_valid_notification_document(const std::string& frame_without_eom);
+
+// Receives the pieces split_notification_frames() takes off the buffer.
+class NotificationFrameHandler {
+public:
+    virtual ~NotificationFrameHandler() = default;
+
+    // An ]]>]]>-delimited frame, marker removed. May be empty or malformed.
+    virtual void on_eom_frame(const std::string& frame_without_eom) = 0;
+    // A complete <notification> element with no EOM, followed by the start
+    // of the next notification.
+    virtual void on_recovered_frame(const std::string& frame_without_eom) = 0;
+    // An unfinished notification cut short by the start of the next one.
+    virtual void on_abandoned_partial(std::string partial) = 0;
+    // Non-whitespace bytes in front of the first notification start tag.
+    virtual void on_orphan_prefix(std::size_t bytes) = 0;
+};
+
+// Where split_notification_frames() stopped searching a buffer, so the next
+// call after more bytes arrive does not search the trailing partial again.
+// Belongs to one buffer: reset it whenever the buffer is cleared or replaced
+// other than by split_notification_frames().
+struct NotificationScanState {
+    std::size_t start_from = 0;        // first notification start tag
+    std::size_t eom_from = 0;          // ]]>]]> marker
+    std::size_t head = 0;              // where that start tag was found
+    std::size_t close_from = 0;        // close tag of that notification
+    std::size_t after_close_from = 0;  // next start tag after the close tag
+    std::size_t after_start_from = 0;  // next start tag inside an unclosed one
+};
+
+/// Take every complete frame off the front of buffer, leaving trailing
+/// partial bytes for the next read. Returns true if anything was consumed.
+/// Bytes that scan records as searched are not searched again, so a large
+/// notification arriving in many reads costs linear time.
+bool split_notification_frames(std::string& buffer,
+                               NotificationScanState& scan,
+                               NotificationFrameHandler& handler);
+
+#endif // NETCONF_FRAMING_HPP
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "async_waiter.hpp"
+#include "metrics_registry.hpp"
+
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -45,11 +49,25 @@ public:
     void clear();
 
 private:
-    NotificationEventBus() = default;
+    using Waiter = AsyncWaiter<NotificationHealthEvent>;
+
+    NotificationEventBus();
+
+    NotificationHealthEvent make_timeout_event_locked() const;
+    void expire_waiter(const std::weak_ptr<Waiter>& weak_waiter);
 
     std::mutex mtx_;
     std::condition_variable cv_;
     std::deque<NotificationHealthEvent> queue_;
+    // Async consumers waiting for the next event. Only non-empty while
+    // queue_ is empty; emit() hands events to them before queueing.
+    std::deque<std::shared_ptr<Waiter>> waiters_;
     std::int64_t dropped_events_ = 0;
     std::size_t max_queue_size_ = 10000;
+
+    // Exported through MetricsRegistry. Unlike dropped_events_, the dropped
+    // counter is not reset by clear().
+    std::shared_ptr<MetricCounter> emitted_metric_;
+    std::shared_ptr<MetricCounter> dropped_metric_;
+    std::shared_ptr<MetricGauge> pending_metric_;
 };
\ No newline at end of file
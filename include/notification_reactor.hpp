@@ -1,14 +1,50 @@
 #ifndef NOTIFICATION_REACTOR_HPP
 #define NOTIFICATION_REACTOR_HPP
 
+#include "latency_histogram.hpp"
+#include "metrics_registry.hpp"
+
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 class NetconfClient;
 
+// One notification session as seen by the reactor that watches it.
+struct ReactorHandlerStats {
+    int fd = -1;
+    std::string label;
+    std::string hostname;
+    int port = 0;
+    std::uint64_t calls = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t slow = 0;       // calls at or over the slow-handler threshold
+    double busy_seconds = 0;      // total time inside on_notification_ready()
+    LatencySummary handler;       // per call
+};
+
+struct ReactorStatsSnapshot {
+    static constexpr std::size_t MAX_EVENTS = 64;  // per epoll_wait
+
+    int reactor = 0;
+    double uptime_seconds = 0;
+    double busy_seconds = 0;      // sum of the handlers; busy / uptime is the load
+    std::uint64_t wakeups = 0;
+    std::uint64_t events = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t max_bytes_per_wakeup = 0;
+    // events_per_wakeup[n]: wakeups whose epoll_wait returned n events.
+    std::array<std::uint64_t, MAX_EVENTS + 1> events_per_wakeup{};
+    LatencySummary dispatch_lag;  // epoll_wait returned -> handler started
+    std::vector<ReactorHandlerStats> handlers;  // busiest first
+};
+
 class NotificationReactor {
 public:
     static NotificationReactor& instance();
@@ -25,14 +61,68 @@ public:
     void add(int fd, std::weak_ptr<NetconfClient> client);
     void remove(int fd);
 
+    ReactorStatsSnapshot snapshot() const;
+
+    /// A handler call taking at least this long emits a
+    /// "slow_notification_handler" health event for its device, at most one
+    /// per session per second. Zero (the default) disables the events; the
+    /// timings are always kept. Applies to every reactor.
+    static void set_slow_handler_threshold(std::chrono::microseconds threshold);
+    static std::chrono::microseconds slow_handler_threshold();
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    // Per-session timings. Guarded by _stats_mtx, except the slow-event
+    // bookkeeping which only the reactor thread touches.
+    struct Handler {
+        std::string label;
+        std::string hostname;
+        int port = 0;
+        std::uint64_t calls = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t slow = 0;
+        std::uint64_t busy_nanos = 0;
+        LatencyHistogram histogram;
+
+        Clock::time_point last_slow_event{};
+        std::uint64_t slow_since_event = 0;
+
+        std::shared_ptr<MetricHistogram> duration_metric;
+        std::shared_ptr<MetricCounter> bytes_metric;
+        std::shared_ptr<MetricCounter> slow_metric;
+    };
+
+    struct Watched {
+        std::weak_ptr<NetconfClient> client;
+        std::shared_ptr<Handler> stats;
+    };
+
     void loop();
     // reactor loop state
     int _epoll_fd;
     std::thread _reactor_thread;
     std::atomic<bool> _running{false};
-    std::mutex _mtx;
-    std::unordered_map<int,std::weak_ptr<NetconfClient>> _handlers;
+    mutable std::mutex _mtx;
+    std::unordered_map<int,Watched> _handlers;
+
+    const int _id;
+    const Clock::time_point _started;
+
+    // Reactor-wide timings, committed once per wakeup.
+    mutable std::mutex _stats_mtx;
+    std::uint64_t _busy_nanos = 0;
+    std::uint64_t _bytes = 0;
+    std::uint64_t _max_bytes_per_wakeup = 0;
+    std::array<std::uint64_t, ReactorStatsSnapshot::MAX_EVENTS + 1> _events_per_wakeup{};
+    LatencyHistogram _dispatch_lag;
+
+    // Exported through MetricsRegistry with a reactor="<id>" label.
+    std::shared_ptr<MetricCounter> _wakeups_metric;
+    std::shared_ptr<MetricCounter> _events_metric;
+    std::shared_ptr<MetricCounter> _bytes_metric;
+    std::shared_ptr<MetricGauge> _fds_metric;
+    std::shared_ptr<MetricHistogram> _dispatch_lag_metric;
 };
 
-#endif // NOTIFICATION_REACTOR_HPP
\ No newline at end of file
+#endif // NOTIFICATION_REACTOR_HPP
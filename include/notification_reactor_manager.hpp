@@ -33,6 +33,9 @@ public:
   /// Unregister an FD
   void remove(int fd);
 
+  /// Timings of every reactor, in reactor order.
+  std::vector<ReactorStatsSnapshot> stats();
+
 private:
   NotificationReactorManager() = default;
 
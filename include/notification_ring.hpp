@@ -0,0 +1,96 @@
+// notification_ring.hpp
+#ifndef NOTIFICATION_RING_HPP
+#define NOTIFICATION_RING_HPP
+
+#include "event_fd_signal.hpp"
+#include "futex_event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Bounded lock-free single-producer/single-consumer ring of notification
+// payloads.
+//
+// The notification reactor that owns a subscription FD is the only producer.
+// Consumer-side calls (try_pop, snapshot, clear) must be serialized by the
+// caller, but they never share a lock with the producer.
+//
+// When the ring is full the producer spills into a mutex-protected overflow
+// deque, so unbounded client queues keep their semantics. The producer keeps
+// spilling until the consumer has drained the overflow, which preserves FIFO
+// order across ring and overflow.
+//
+// The slot array is allocated by the first push, so clients that never
+// subscribe pay nothing for it, and it is capped at MAX_CAPACITY slots: a
+// larger queue limit is served by the overflow deque past that point.
+//
+// Blocking waits park on a FutexEvent. The producer only issues the wake
+// syscall when a consumer is actually parked. Event-loop consumers use the
+// readable() eventfd instead, which is only written when armed.
+class NotificationRing {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+    static constexpr std::size_t MAX_CAPACITY = 4096;
+
+    explicit NotificationRing(std::size_t capacity = DEFAULT_CAPACITY);
+
+    NotificationRing(const NotificationRing&) = delete;
+    NotificationRing& operator=(const NotificationRing&) = delete;
+
+    /// Ring capacity for a client queue limit (-1 means unbounded).
+    static std::size_t capacity_for_queue_limit(int max_size);
+
+    // ----------------------- Producer side -------------------------
+    void push(std::string&& item);
+
+    // ----------------------- Consumer side -------------------------
+    bool try_pop(std::string& out);
+    /// Move up to max_items queued payloads onto out; returns the count moved.
+    std::size_t pop_bulk(std::vector<std::string>& out, std::size_t max_items);
+    void snapshot(std::vector<std::string>& out, std::size_t limit) const;
+    void clear();
+
+    // ----------------------- Any thread -------------------------
+    /// Park until an item is available or the deadline passes.
+    /// Returns true when the ring was observed non-empty.
+    bool wait_until(std::chrono::steady_clock::time_point deadline);
+    std::size_t size() const noexcept;
+    bool empty() const noexcept { return size() == 0; }
+    void wake_all() noexcept;
+    /// eventfd signalled on push when armed, and on every wake_all().
+    EventFdSignal& readable() noexcept { return readable_; }
+
+private:
+    void signal_one() noexcept;
+
+    // Written by the producer before the tail_ release store that publishes
+    // the first item; consumers only index it when head_ != tail_.
+    std::unique_ptr<std::string[]> slots_;
+    const std::size_t capacity_;
+    const std::size_t mask_;
+
+    // Producer and consumer indices are padded onto separate cache lines.
+    // Explicit padding instead of alignas(): clients are heap allocated and
+    // C++14 operator new does not honour over-alignment.
+    char pad0_[64];
+    std::atomic<std::size_t> tail_{0};
+    char pad1_[64 - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> head_{0};
+    char pad2_[64 - sizeof(std::atomic<std::size_t>)];
+
+    FutexEvent ready_;
+    EventFdSignal readable_;
+
+    mutable std::mutex spill_mtx_;
+    std::deque<std::string> spill_;
+    std::atomic<std::size_t> spill_size_{0};
+};
+
+#endif // NOTIFICATION_RING_HPP
@@ -0,0 +1,124 @@
+// notification_stream.hpp
+#ifndef NOTIFICATION_STREAM_HPP
+#define NOTIFICATION_STREAM_HPP
+
+#include "async_waiter.hpp"
+#include "futex_event.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One notification delivered through a merged stream, tagged with the client
+// that received it.
+struct NotificationRecord {
+    std::string label;
+    std::string hostname;
+    int port = 0;
+    std::string payload;
+};
+
+// Merged multi-producer/single-consumer notification stream.
+//
+// Any number of clients can be attached to one stream. Every notification
+// reactor then publishes into the same intrusive lock-free list instead of the
+// per-client queues, so one consumer can follow a whole fleet without per-client
+// polling or one waiting task per device.
+//
+// Memory is bounded by a byte budget over queued payloads. When the budget is
+// exhausted new records are dropped and counted; queued records are never
+// evicted. The dropped count only grows.
+//
+// Consumer-side calls (next_batch, clear) are serialized internally.
+// next_batch_async() registers a waiter that the producer completes right
+// after publishing, or the DeadlineTimer on timeout, instead of holding a pool
+// thread.
+class NotificationStream : public std::enable_shared_from_this<NotificationStream> {
+public:
+    static constexpr std::int64_t DEFAULT_MAX_BYTES = 64LL * 1024 * 1024;
+
+    /// Process-wide named streams. "default" is the global stream.
+    /// max_bytes > 0 (re)sets the budget; -1 keeps the current budget.
+    static std::shared_ptr<NotificationStream> get(
+        const std::string& name = "default",
+        std::int64_t max_bytes = -1
+    );
+
+    explicit NotificationStream(std::string name, std::int64_t max_bytes = DEFAULT_MAX_BYTES);
+    ~NotificationStream();
+
+    NotificationStream(const NotificationStream&) = delete;
+    NotificationStream& operator=(const NotificationStream&) = delete;
+
+    // ----------------------- Producer side (any thread) -------------------------
+    /// Returns false when the record was dropped because of the byte budget.
+    /// Async waiters are not served here, because producers publish under
+    /// their own locks: when waiters_pending is set, the producer calls
+    /// serve_waiters() once those are released.
+    bool publish(NotificationRecord record, bool& waiters_pending) noexcept;
+    /// Hand queued records to registered next_batch_async() waiters.
+    void serve_waiters() noexcept;
+
+    // ----------------------- Consumer side -------------------------
+    std::vector<NotificationRecord> next_batch(int max_items = 100, int timeout_ms = 10);
+    std::future<std::vector<NotificationRecord>> next_batch_async(
+        int max_items = 100,
+        int timeout_ms = 10
+    );
+    void clear();
+
+    const std::string& name() const noexcept { return name_; }
+    void set_max_bytes(std::int64_t max_bytes);
+    std::int64_t max_bytes() const noexcept;
+    std::size_t pending_count() const noexcept;
+    std::int64_t pending_bytes() const noexcept;
+    std::uint64_t published_count() const noexcept;
+    std::uint64_t dropped_count() const noexcept;
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        NotificationRecord record;
+    };
+
+    struct Waiter : AsyncWaiter<std::vector<NotificationRecord>> {
+        explicit Waiter(std::size_t limit) : limit(limit) {}
+        const std::size_t limit;
+    };
+
+    static std::int64_t record_bytes(const NotificationRecord& record) noexcept;
+    bool linked_locked() const noexcept;
+    std::size_t drain_locked(std::vector<NotificationRecord>& out, std::size_t max_items);
+    void expire_waiter(const std::weak_ptr<Waiter>& weak_waiter);
+
+    const std::string name_;
+    std::atomic<std::int64_t> max_bytes_;
+
+    // Producers swing head_; the consumer owns tail_ (a stub node).
+    std::atomic<Node*> head_;
+    Node* tail_;
+    std::mutex consumer_mtx_;
+
+    std::atomic<std::int64_t> bytes_{0};
+    std::atomic<std::size_t> count_{0};
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    FutexEvent ready_;
+
+    // Async consumers, served in FIFO order. Lock order: waiters_mtx_, then
+    // consumer_mtx_. waiter_count_ lets publish() skip the lock when idle.
+    std::mutex waiters_mtx_;
+    std::deque<std::shared_ptr<Waiter>> waiters_;
+    std::atomic<std::size_t> waiter_count_{0};
+};
+
+#endif // NOTIFICATION_STREAM_HPP
@@ -0,0 +1,64 @@
+// notification_waiter.hpp
+#ifndef NOTIFICATION_WAITER_HPP
+#define NOTIFICATION_WAITER_HPP
+
+#include "async_waiter.hpp"
+#include "deadline_timer.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+// An async consumer parked on a client's notification queue.
+//
+// next_notification_async() and next_notifications_async() register one of
+// these instead of blocking a pool worker. The notification reactor delivers
+// up to limit items right after enqueueing; the DeadlineTimer delivers an
+// empty batch when the timeout expires.
+class NotificationWaiter {
+public:
+    explicit NotificationWaiter(std::size_t limit) : limit(limit) {}
+    virtual ~NotificationWaiter() = default;
+
+    /// items is empty on timeout.
+    virtual void deliver(std::vector<std::string> items) = 0;
+    virtual void fail(std::exception_ptr error) = 0;
+
+    const std::size_t limit;
+    DeadlineTimer::Handle timer;
+};
+
+class SingleNotificationWaiter : public NotificationWaiter {
+public:
+    SingleNotificationWaiter() : NotificationWaiter(1) {}
+
+    std::future<std::string> future() { return waiter_.future(); }
+
+    void deliver(std::vector<std::string> items) override {
+        waiter_.complete(items.empty() ? std::string{} : std::move(items.front()));
+    }
+
+    void fail(std::exception_ptr error) override { waiter_.fail(std::move(error)); }
+
+private:
+    AsyncWaiter<std::string> waiter_;
+};
+
+class BatchNotificationWaiter : public NotificationWaiter {
+public:
+    explicit BatchNotificationWaiter(std::size_t limit) : NotificationWaiter(limit) {}
+
+    std::future<std::vector<std::string>> future() { return waiter_.future(); }
+
+    void deliver(std::vector<std::string> items) override { waiter_.complete(std::move(items)); }
+
+    void fail(std::exception_ptr error) override { waiter_.fail(std::move(error)); }
+
+private:
+    AsyncWaiter<std::vector<std::string>> waiter_;
+};
+
+#endif // NOTIFICATION_WAITER_HPP
@@ -0,0 +1,137 @@
+// pool_task.hpp
+#ifndef POOL_TASK_HPP
+#define POOL_TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only type-erased void() callable for the thread pool.
+//
+// Callables up to INLINE_CAPACITY bytes with a non-throwing move constructor
+// are stored in place, so wrapping a typical *_async lambda (a shared_ptr to
+// the client, a couple of strings and the promise) does not allocate. Larger
+// callables fall back to one heap allocation.
+class PoolTask {
+public:
+    static constexpr std::size_t INLINE_CAPACITY = 192;
+
+    PoolTask() noexcept = default;
+
+    template <
+        class F,
+        class = typename std::enable_if<
+            !std::is_same<typename std::decay<F>::type, PoolTask>::value
+        >::type
+    >
+    PoolTask(F&& f) {
+        using Fn = typename std::decay<F>::type;
+        construct<Fn>(std::forward<F>(f), std::integral_constant<bool, fits_inline<Fn>()>());
+    }
+
+    PoolTask(PoolTask&& other) noexcept {
+        move_from(other);
+    }
+
+    PoolTask& operator=(PoolTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    PoolTask(const PoolTask&) = delete;
+    PoolTask& operator=(const PoolTask&) = delete;
+
+    ~PoolTask() { reset(); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void operator()() { ops_->invoke(storage()); }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage());
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*relocate)(void* dst, void* src) noexcept;  // move + destroy src
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <class Fn>
+    static constexpr bool fits_inline() {
+        return sizeof(Fn) <= INLINE_CAPACITY &&
+            alignof(Fn) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template <class Fn>
+    struct InlineOps {
+        static void invoke(void* p) { (*static_cast<Fn*>(p))(); }
+        static void relocate(void* dst, void* src) noexcept {
+            ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        }
+        static void destroy(void* p) noexcept { static_cast<Fn*>(p)->~Fn(); }
+        static const Ops table;
+    };
+
+    template <class Fn>
+    struct HeapOps {
+        static Fn*& ptr(void* p) noexcept { return *static_cast<Fn**>(p); }
+        static void invoke(void* p) { (*ptr(p))(); }
+        static void relocate(void* dst, void* src) noexcept {
+            ::new (dst) Fn*(ptr(src));
+        }
+        static void destroy(void* p) noexcept { delete ptr(p); }
+        static const Ops table;
+    };
+
+    template <class Fn, class F>
+    void construct(F&& f, std::true_type /*inline*/) {
+        ::new (storage()) Fn(std::forward<F>(f));
+        ops_ = &InlineOps<Fn>::table;
+    }
+
+    template <class Fn, class F>
+    void construct(F&& f, std::false_type /*heap*/) {
+        ::new (storage()) Fn*(new Fn(std::forward<F>(f)));
+        ops_ = &HeapOps<Fn>::table;
+    }
+
+    void move_from(PoolTask& other) noexcept {
+        if (other.ops_) {
+            other.ops_->relocate(storage(), other.storage());
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    void* storage() noexcept { return &storage_; }
+
+    typename std::aligned_storage<INLINE_CAPACITY, alignof(std::max_align_t)>::type storage_;
+    const Ops* ops_ = nullptr;
+};
+
+template <class Fn>
+const PoolTask::Ops PoolTask::InlineOps<Fn>::table = {
+    &PoolTask::InlineOps<Fn>::invoke,
+    &PoolTask::InlineOps<Fn>::relocate,
+    &PoolTask::InlineOps<Fn>::destroy,
+};
+
+template <class Fn>
+const PoolTask::Ops PoolTask::HeapOps<Fn>::table = {
+    &PoolTask::HeapOps<Fn>::invoke,
+    &PoolTask::HeapOps<Fn>::relocate,
+    &PoolTask::HeapOps<Fn>::destroy,
+};
+
+#endif // POOL_TASK_HPP
@@ -0,0 +1,50 @@
+// pooled_allocator.hpp
+#ifndef POOLED_ALLOCATOR_HPP
+#define POOLED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+// Size-class block cache behind PooledAllocator.
+//
+// Each thread keeps a small free list per size class. Every block remembers
+// the cache it was allocated from and goes back there when freed: on the
+// owning thread straight onto its free list (up to a cap), on any other
+// thread onto a lock-free return list that the owner takes over when its
+// free list runs dry. A promise allocated by the submitting thread and
+// released on a worker or reactor thread is therefore reused by the next
+// submission instead of piling up where it was freed. Caches of exited
+// threads are adopted by new threads. Requests larger than the biggest class
+// go straight to operator new.
+class BlockCache {
+public:
+    static void* allocate(std::size_t bytes);
+    static void deallocate(void* ptr, std::size_t bytes) noexcept;
+};
+
+// Minimal C++14 allocator over BlockCache. Used for std::promise shared state
+// so that steady-state ThreadPool::enqueue() does not touch the global heap.
+template <class T>
+struct PooledAllocator {
+    using value_type = T;
+
+    PooledAllocator() noexcept = default;
+    template <class U>
+    PooledAllocator(const PooledAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(BlockCache::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        BlockCache::deallocate(ptr, n * sizeof(T));
+    }
+};
+
+template <class T, class U>
+bool operator==(const PooledAllocator<T>&, const PooledAllocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const PooledAllocator<T>&, const PooledAllocator<U>&) noexcept { return false; }
+
+#endif // POOLED_ALLOCATOR_HPP
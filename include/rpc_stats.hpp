@@ -0,0 +1,100 @@
+// rpc_stats.hpp
+#ifndef RPC_STATS_HPP
+#define RPC_STATS_HPP
+
+#include "latency_histogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Where the time of one RPC on a client's session went.
+//
+//   strand_wait  behind earlier calls of the same client
+//   pool_queue   runner posted, waiting for a pool worker (0 for *_sync)
+//   write        writing the request into the channel
+//   first_byte   request written, waiting for the device to answer
+//   transfer     first reply bytes to ]]>]]>
+//   error_check  check_for_rpc_error() on the reply
+//   total        submitted to finished
+enum class RpcPhase : int {
+    StrandWait = 0,
+    PoolQueue,
+    Write,
+    FirstByte,
+    Transfer,
+    ErrorCheck,
+    Total,
+};
+
+constexpr std::size_t RPC_PHASE_COUNT = 7;
+
+const char* rpc_phase_name(RpcPhase phase);
+
+// Monotonic timestamps of one RPC. A default time_point means the RPC never
+// reached that point: it failed earlier, or (submitted, scheduled) it was
+// not the first RPC of its strand task and so did not queue for it.
+struct RpcTrace {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point submitted;
+    Clock::time_point scheduled;
+    Clock::time_point started;
+    Clock::time_point written;
+    Clock::time_point first_byte;
+    Clock::time_point received;
+    Clock::time_point finished;
+    bool failed = false;
+
+    /// Nanoseconds spent in phase, or -1 if it was not reached.
+    std::int64_t phase_nanos(RpcPhase phase) const noexcept;
+};
+
+struct RpcStatsSnapshot {
+    std::uint64_t rpcs = 0;    // since the client was created or reset
+    std::uint64_t failed = 0;
+    double window_seconds = 0; // span the phase summaries cover
+    std::array<LatencySummary, RPC_PHASE_COUNT> phases{};
+    bool has_last = false;
+    bool last_failed = false;
+    std::array<std::int64_t, RPC_PHASE_COUNT> last_nanos{};
+};
+
+// Per-client rolling phase histograms.
+//
+// Each phase has a current and a previous window of WINDOW length. A snapshot
+// merges both, so it always covers between one and two windows of recent
+// RPCs; older ones age out. The histograms are only allocated on the first
+// record(), so clients that never send an RPC stay small.
+class RpcStats {
+public:
+    using Clock = RpcTrace::Clock;
+    static constexpr std::chrono::seconds WINDOW{60};
+
+    void record(const RpcTrace& trace);
+    RpcStatsSnapshot snapshot() const;
+    void reset();
+
+private:
+    struct Windows {
+        std::array<LatencyHistogram, RPC_PHASE_COUNT> current;
+        std::array<LatencyHistogram, RPC_PHASE_COUNT> previous;
+        Clock::time_point current_started;
+        Clock::time_point previous_started;
+        bool has_previous = false;
+    };
+
+    void rotate_locked(Windows& windows, Clock::time_point now) const;
+
+    mutable std::mutex mtx_;
+    mutable std::unique_ptr<Windows> windows_;
+    std::uint64_t rpcs_ = 0;
+    std::uint64_t failed_ = 0;
+    RpcTrace last_;
+    bool has_last_ = false;
+};
+
+#endif // RPC_STATS_HPP
@@ -0,0 +1,176 @@
+// strand.hpp
+#ifndef STRAND_HPP
+#define STRAND_HPP
+
+#include "pool_task.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+// Serial executor on top of the global thread pool.
+//
+// Tasks posted to one strand run one at a time in FIFO order. At most one pool
+// worker is ever busy with a given strand: the strand schedules a single
+// runner, and the runner re-submits itself while work remains instead of
+// holding the worker. Other strands can use the pool in between.
+//
+// enqueue() callers never block on the strand; the internal mutex only guards
+// the queue and is never held while a task runs.
+//
+// Each runner is posted with the most urgent priority among the queued tasks,
+// so an interactive call behind bulk work still gets an interactive worker.
+// A call more urgent than the lane a runner is already queued in posts a
+// promoted runner; the superseded one does nothing when it runs. Tasks
+// themselves keep FIFO order.
+//
+// Queued tasks count against the pool's queue limit (see
+// ThreadPool::set_queue_limit), so enqueue() rejects normal and bulk work
+// once the pool and strand backlog together reach it.
+//
+// Queued tasks live in an intrusive list of entries that are recycled through
+// a small per-strand free list, so steady-state enqueue() does not allocate.
+//
+// dispatch() runs a call on the caller's own thread instead. The caller takes
+// its turn in the same FIFO: when the strand is idle it runs immediately,
+// otherwise the runner hands the strand over once earlier tasks are done. No
+// pool worker runs or waits for the call, and a dispatch() made from inside a
+// task of the same strand runs directly instead of deadlocking.
+//
+// A dispatch() made from a pool worker cannot wait for a runner: with every
+// worker busy, nothing would run it. Such a caller takes the strand as soon
+// as no task is running on it and runs the earlier tasks inline, in order,
+// before its own call.
+class Strand : public std::enable_shared_from_this<Strand> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // When the running task was enqueued, and when it reached the front of the
+    // strand: its runner was posted to the pool, or its dispatch() caller got
+    // the strand. The gap is time spent behind earlier calls.
+    struct TaskTiming {
+        Clock::time_point enqueued;
+        Clock::time_point scheduled;
+    };
+
+    // Idle entries kept for reuse per strand.
+    static constexpr std::size_t FREE_ENTRIES = 8;
+
+    Strand() = default;
+    ~Strand();
+
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+
+    template<class F>
+    auto enqueue(F&& f, TaskPriority priority = TaskPriority::Normal)
+      -> std::future<typename std::result_of<F()>::type>
+    {
+        using Ret = typename std::result_of<F()>::type;
+        if (rejects(priority)) {
+            return ThreadPool::rejected<Ret>();
+        }
+
+        std::future<Ret> fut;
+        push(ThreadPool::package(std::forward<F>(f), fut), priority);
+        return fut;
+    }
+
+    /// Run f on the calling thread, serialized with every other call on this
+    /// strand. Blocks until f has run; exceptions propagate to the caller.
+    template<class F>
+    auto dispatch(F&& f) -> typename std::result_of<F()>::type
+    {
+        if (runningHere()) {
+            return f();
+        }
+        Turn turn(*this);
+        return f();
+    }
+
+    /// Timing of the task or dispatch() call running on this thread. Returns
+    /// true once per task; later calls, and calls outside a strand, get false.
+    static bool takeTaskTiming(TaskTiming& out) noexcept;
+
+private:
+    // A dispatch() caller parked in acquire().
+    struct Waiter;
+
+    struct Entry {
+        PoolTask task;
+        TaskPriority priority = TaskPriority::Normal;
+        std::shared_ptr<Waiter> waiter;  // set for a dispatch() caller's turn
+        Clock::time_point enqueued;
+        Entry* next = nullptr;
+    };
+
+    // Holds the strand for a dispatch() caller for its lifetime.
+    class Turn {
+    public:
+        explicit Turn(Strand& strand);
+        ~Turn();
+
+        Turn(const Turn&) = delete;
+        Turn& operator=(const Turn&) = delete;
+
+    private:
+        Strand& strand_;
+        const Strand* outer_;
+        TaskTiming outerTiming_;
+        bool outerTimingValid_;
+    };
+
+    static bool rejects(TaskPriority priority);
+    bool runningHere() const noexcept;
+    void push(PoolTask task, TaskPriority priority);
+    void runNext(Clock::time_point posted, std::uint64_t runner);
+    void runTask(PoolTask& task, Clock::time_point enqueued,
+                 Clock::time_point scheduled) noexcept;
+    void acquire();
+    bool runAhead(const std::shared_ptr<Waiter>& waiter);
+    void release() noexcept;
+    void appendLocked(PoolTask task, TaskPriority priority,
+                      std::shared_ptr<Waiter> waiter, Clock::time_point enqueued);
+    void popLocked(PoolTask& task, std::shared_ptr<Waiter>& waiter,
+                   Clock::time_point& enqueued) noexcept;
+    TaskPriority urgentLocked() const noexcept;
+    bool promoteLocked(TaskPriority priority) noexcept;
+    void postPromoted(TaskPriority priority, TaskPriority previous,
+                      std::uint64_t runner, Clock::time_point posted) noexcept;
+    void syncBacklogLocked() noexcept;
+
+    std::mutex mtx_;
+    // FIFO of queued entries, and recycled ones.
+    Entry* head_ = nullptr;
+    Entry* tail_ = nullptr;
+    Entry* free_ = nullptr;
+    std::size_t freeCount_ = 0;
+    // Queued entries per TaskPriority, for urgentLocked(), and in total.
+    std::size_t queuedByPriority_[3] = {};
+    std::size_t queued_ = 0;
+    // The strand is owned: a runner is queued on or running in the pool, or a
+    // dispatch() caller is running.
+    bool scheduled_ = false;
+    // A runner is submitted but has not taken its entry yet. That entry is
+    // already counted by the pool as the runner itself.
+    bool runnerQueued_ = false;
+    // Id of the last runner posted, and the lane it went to. A promoted
+    // runner is posted next to the queued one; the first of them to run
+    // raises liveRunner_ past both, and a pool-worker dispatch() caller that
+    // takes the strand does the same. Runners below liveRunner_ do nothing.
+    std::uint64_t runner_ = 0;
+    std::uint64_t liveRunner_ = 0;
+    TaskPriority runnerPriority_ = TaskPriority::Normal;
+    // Queued dispatch() callers that run earlier tasks themselves.
+    std::size_t helpers_ = 0;
+    // Entries reported to ThreadPool::addStrandBacklog().
+    std::size_t backlog_ = 0;
+};
+
+#endif // STRAND_HPP
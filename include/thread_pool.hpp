@@ -2,109 +2,277 @@
 #ifndef THREAD_POOL_HPP
 #define THREAD_POOL_HPP
 
+#include "completion_hook.hpp"
+#include "futex_event.hpp"
+#include "logger.hpp"
+#include "pool_task.hpp"
+#include "pooled_allocator.hpp"
+#include "work_stealing_queue.hpp"
+
 #include <vector>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
-#include <iostream>
-#include <condition_variable>
 #include <future>
 #include <functional>
 #include <atomic>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Scheduling class of a pool task. Interactive tasks are taken before
+// anything else and bypass the queue-depth limit; bulk tasks run when no
+// normal work is available, plus a periodic turn so they cannot starve.
+enum class TaskPriority {
+    Interactive,
+    Normal,
+    Bulk,
+};
+
+/// "interactive", "normal" or "bulk"; throws std::invalid_argument otherwise.
+TaskPriority task_priority_from_string(const std::string& name);
+
+// What a full pool does with non-interactive submissions.
+enum class AdmissionPolicy {
+    Reject,  // fail the returned future with ThreadPoolFullError
+    Defer,   // hold the task outside the queues until depth drops
+};
+
+class ThreadPoolFullError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
 
+// Work-stealing thread pool.
+//
+// Every worker owns a lock-free queue. Submissions from a worker thread go to
+// that worker's own queue; submissions from other threads are spread over the
+// workers. A worker that runs dry steals from randomly chosen victims before
+// parking, so a short task never waits behind a long blocking RPC while
+// another worker is idle.
+//
+// The pool can be resized while in use. Growing starts workers in free slots;
+// shrinking lets surplus workers finish their current task, move anything
+// left in their queue to the shared overflow list and exit. Worker slots and
+// their queues live as long as the pool, so late submissions into a retired
+// slot are still found by stealing.
+//
+// Interactive and bulk tasks use two shared lanes next to the per-worker
+// (normal) queues. An optional limit on queued tasks provides admission
+// control for normal and bulk work.
 class ThreadPool {
 public:
-    explicit ThreadPool(size_t nThreads)
-    : stop_{false}
-    {
-    workers_.reserve(nThreads);
-    for (size_t i = 0; i < nThreads; ++i) {
-        // actually create a Worker
-        workers_.emplace_back(std::make_unique<Worker>());
-        // then start its thread
-        threads_.emplace_back([this, i] {
-        auto &worker = *workers_[i];
-        for (;;) {
-            std::function<void()> task;
-            {
-            std::unique_lock<std::mutex> lock(worker.mtx);
-            worker.cv.wait(lock, [&]{
-                return stop_.load() || !worker.tasks.empty();
-            });
-            if (stop_.load() && worker.tasks.empty())
-                return;
-            task = std::move(worker.tasks.front());
-            worker.tasks.pop();
-            }
-            worker.inflight.fetch_sub(1, std::memory_order_relaxed);
-            try {
-                task();
-            } catch (const std::exception& e) {
-                std::cerr << "ThreadPool worker swallowed exception: "
-                        << e.what() << std::endl;
-            } catch (...) {
-                std::cerr << "ThreadPool worker swallowed unknown exception"
-                        << std::endl;
-            }
-        }
-        });
-    }
-    }
+    static constexpr size_t WORKER_QUEUE_CAPACITY = 1024;
+    static constexpr size_t MAX_WORKERS = 1024;
+    // Every Nth take a worker checks the bulk lane before its own queue.
+    static constexpr unsigned BULK_TURN_INTERVAL = 16;
+    // Yields an idle worker spends while queued_ says work is on its way
+    // before it parks, and how long it stays parked at most.
+    static constexpr unsigned IDLE_SPINS = 64;
+    static constexpr int IDLE_PARK_US = 200;
 
-    ~ThreadPool() {
-        stop_.store(true);
-        // wake up all threads
-        for (auto &w : workers_) w->cv.notify_all();
-        for (auto &t : threads_)
-            if (t.joinable()) t.join();
-    }
+    explicit ThreadPool(size_t nThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
 
-    // enqueue: pick the worker with the smallest inflight count
     template<class F>
-    auto enqueue(F&& f)
+    auto enqueue(F&& f, TaskPriority priority = TaskPriority::Normal)
       -> std::future<typename std::result_of<F()>::type>
     {
         using Ret = typename std::result_of<F()>::type;
-        auto taskPtr = std::make_shared<std::packaged_task<Ret()>>(std::forward<F>(f));
-        std::future<Ret> fut = taskPtr->get_future();
-
-        // pick least-loaded queue
-        size_t best = 0;
-        size_t bestCount = SIZE_MAX;
-        for (size_t i = 0; i < workers_.size(); ++i) {
-            size_t cnt = workers_[i]->inflight.load(std::memory_order_relaxed);
-            if (cnt < bestCount) {
-                bestCount = cnt;
-                best = i;
-            }
+        if (rejects(priority)) {
+            return rejected<Ret>();
         }
 
-        auto &worker = *workers_[best];
-        {
-            std::lock_guard<std::mutex> lock(worker.mtx);
-            if (stop_.load()) {
-                std::cout << "ThreadPool is stopped" << std::endl;
-            }
-            worker.tasks.emplace([taskPtr](){ (*taskPtr)(); });
-            // increment to account for this new task
-            worker.inflight.fetch_add(1, std::memory_order_relaxed);
+        std::future<Ret> fut;
+        PoolTask task = package(std::forward<F>(f), fut);
+
+        if (stop_.load()) {
+            NETX_LOG(LogLevel::Warning, "ThreadPool is stopped");
         }
-        worker.cv.notify_one();
+
+        submit(std::move(task), priority);
         return fut;
     }
 
+    /// A future that already failed with ThreadPoolFullError. Runs the
+    /// caller's CompletionHook like a completed task would.
+    template<class Ret>
+    static std::future<Ret> rejected() {
+        std::promise<Ret> promise;
+        std::future<Ret> fut = promise.get_future();
+        promise.set_exception(std::make_exception_ptr(
+            ThreadPoolFullError("Thread pool queue is full; submission rejected")
+        ));
+        CompletionHook::Callback onReady = CompletionHook::take();
+        if (onReady) onReady();
+        return fut;
+    }
+
+    /// Wrap f in a task that fulfils fut and then runs the caller's
+    /// CompletionHook, without submitting it. Used by Strand.
+    template<class F>
+    static PoolTask package(F&& f, std::future<typename std::result_of<F()>::type>& fut) {
+        using Ret = typename std::result_of<F()>::type;
+        using Fn = typename std::decay<F>::type;
+
+        // The shared state comes from the per-thread block cache and the
+        // callable is stored inline in the task, so steady-state submission
+        // does not touch the global heap.
+        std::promise<Ret> promise(std::allocator_arg, PooledAllocator<char>());
+        fut = promise.get_future();
+
+        return PoolTask(PromiseTask<Fn, Ret>{
+            Fn(std::forward<F>(f)),
+            std::move(promise),
+            // Runs after the promise has made the future ready.
+            CompletionHook::take()
+        });
+    }
+
+    /// Submit a task that has no future of its own. Never rejected; it may
+    /// be deferred under AdmissionPolicy::Defer.
+    void post(PoolTask task, TaskPriority priority = TaskPriority::Normal) {
+        submit(std::move(task), priority);
+    }
+
+    /// Limit queued (submitted, not yet started) tasks. 0 disables the limit.
+    /// Calls waiting in a Strand count against it too. Interactive tasks are
+    /// always admitted.
+    void set_queue_limit(size_t maxQueued, AdmissionPolicy policy);
+
+    /// True when a submission with this priority would be rejected now.
+    bool rejects(TaskPriority priority) const noexcept;
+
+    /// Tasks waiting to start, including deferred ones and strand backlog.
+    size_t queued() const noexcept;
+
+    /// Track calls held in a Strand queue that no submitted runner stands for
+    /// yet. Strand keeps this up to date; the pool only reads it.
+    void addStrandBacklog(size_t n) noexcept { strandBacklog_.fetch_add(n, std::memory_order_relaxed); }
+    void subStrandBacklog(size_t n) noexcept { strandBacklog_.fetch_sub(n, std::memory_order_relaxed); }
+
+    /// Change the number of active workers without blocking on running tasks.
+    void resize(size_t nThreads);
+
+    size_t size() const noexcept { return active_.load(std::memory_order_acquire); }
+
+    /// True when called from one of this pool's worker threads.
+    bool onWorker() const noexcept;
+
+    /// Tasks waiting for admission under AdmissionPolicy::Defer.
+    size_t deferred() const noexcept { return deferredSize_.load(std::memory_order_relaxed); }
+
+    /// Tasks run, and tasks taken from another worker's queue, since start.
+    /// Summed over per-worker counters, so reading never contends with workers.
+    uint64_t executedCount() const noexcept;
+    uint64_t stolenCount() const noexcept;
+
 private:
-  struct Worker {
-    std::queue<std::function<void()>> tasks;
-    std::mutex mtx;
-    std::condition_variable cv;
-    std::atomic<size_t> inflight{0};
-  };
-
-  std::vector<std::unique_ptr<Worker>> workers_;
-  std::vector<std::thread> threads_;
-  std::atomic<bool> stop_;
+    using Task = PoolTask;
+
+    template <class Fn, class Ret>
+    struct PromiseTask {
+        Fn fn;
+        std::promise<Ret> promise;
+        CompletionHook::Callback onReady;
+
+        void operator()() {
+            try {
+                fulfil(promise, fn);
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+            if (onReady) onReady();
+        }
+    };
+
+    template <class Ret, class Fn>
+    static void fulfil(std::promise<Ret>& promise, Fn& fn) { promise.set_value(fn()); }
+
+    template <class Fn>
+    static void fulfil(std::promise<void>& promise, Fn& fn) { fn(); promise.set_value(); }
+
+    struct Worker {
+        explicit Worker(uint64_t seed)
+            : queue(WORKER_QUEUE_CAPACITY), rng(seed | 1) {}
+
+        WorkStealingQueue<Task> queue;
+        uint64_t rng; // victim selection, owner thread only
+        unsigned takes = 0; // bulk turn counter, owner thread only
+
+        // Written by the owner thread only; read by executedCount() and
+        // stolenCount().
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+
+        // Guarded by resizeMtx_.
+        std::thread thread;
+        bool exited = false;
+    };
+
+    // Shared MPMC queue for one priority class, with a locked spill list.
+    struct Lane {
+        Lane() : queue(WORKER_QUEUE_CAPACITY) {}
+
+        void push(Task task);
+        bool take(Task& out);
+
+        WorkStealingQueue<Task> queue;
+        std::mutex overflowMtx;
+        std::deque<Task> overflow;
+        std::atomic<size_t> overflowSize{0};
+    };
+
+    void submit(Task task, TaskPriority priority);
+    void publish(Task task, TaskPriority priority);
+    void admitDeferredLocked();
+    void workerLoop(size_t index);
+    bool tryTake(size_t index, Task& out);
+    bool retireIfSurplus(size_t index);
+    void startWorker(size_t index);
+    size_t pickVictim(Worker& self, size_t slots) noexcept;
+
+    // Sized to MAX_WORKERS up front and never reallocated. Slot i is written
+    // once, before slots_ is raised past i.
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t> slots_{0};   // slots ever used; stealing sweeps these
+    std::atomic<size_t> active_{0};  // workers [0, active_) take new work
+    std::mutex resizeMtx_;
+
+    // Used only when a worker queue is full.
+    std::mutex overflowMtx_;
+    std::deque<Task> overflow_;
+    std::atomic<size_t> overflowSize_{0};
+
+    Lane interactive_;
+    Lane bulk_;
+
+    // Submitted but not yet taken. Incremented before a task is published,
+    // so it never underflows; idle workers park until it is non-zero.
+    std::atomic<size_t> queued_{0};
+
+    // Admission control. Deferred tasks are not counted in queued_ and are
+    // published in FIFO order as workers take tasks.
+    std::atomic<size_t> maxQueued_{0};
+    std::atomic<AdmissionPolicy> policy_{AdmissionPolicy::Reject};
+    std::mutex deferredMtx_;
+    std::deque<std::pair<Task, TaskPriority>> deferred_;
+    std::atomic<size_t> deferredSize_{0};
+    // Calls waiting in strands, see addStrandBacklog(). Deferral looks at
+    // queued_ alone: the backlog drains through strand runners, which must
+    // still be admitted.
+    std::atomic<size_t> strandBacklog_{0};
+    FutexEvent workReady_;
+    // Bumped after every publish, so a worker parked while queued_ > 0 wakes
+    // for new work instead of waiting for queued_ to drop to zero.
+    std::atomic<uint32_t> publishes_{0};
+
+    std::atomic<bool> stop_;
 };
 
 #endif // THREAD_POOL_HPP
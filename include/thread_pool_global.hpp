@@ -5,5 +5,6 @@ void init_global_pool(int nThreads);
 class ThreadPool; // forward-declare
 
 ThreadPool& get_pool();
+int global_pool_size();
 
 #endif
@@ -0,0 +1,107 @@
+// trace_recorder.hpp
+#ifndef TRACE_RECORDER_HPP
+#define TRACE_RECORDER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Opt-in span tracing, dumped as Chrome trace-event JSON for Perfetto or
+// chrome://tracing.
+//
+// Each thread records into its own fixed-size ring, whose lock only a start
+// or a dump ever competes for; when a ring is full the oldest spans are
+// overwritten. While tracing is off every call site costs one relaxed load
+// and a branch that is always predicted not taken.
+//
+// category, name and value_name must be string literals (or otherwise outlive
+// the dump). detail, such as a device label, is copied and cut to 47 bytes.
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t DEFAULT_EVENTS_PER_THREAD = 32768;
+
+    static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Discard earlier spans and start recording. Throws
+    /// std::invalid_argument if events_per_thread is 0.
+    static void start(std::size_t events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+    /// Stop recording; the spans stay available to dump.
+    static void stop() noexcept;
+
+    static void record(const char* category,
+                       const char* name,
+                       Clock::time_point start,
+                       Clock::time_point end,
+                       const char* detail = nullptr,
+                       const char* value_name = nullptr,
+                       std::int64_t value = 0) noexcept;
+    /// Like record(), for time the recording thread did not spend itself,
+    /// such as an RPC waiting in a queue. Shown on its own async track, so it
+    /// may overlap the thread's spans.
+    static void record_async(const char* category,
+                             const char* name,
+                             Clock::time_point start,
+                             Clock::time_point end,
+                             const char* detail = nullptr) noexcept;
+
+    /// Name shown for the calling thread's track. Cheap; call once per thread.
+    static void set_thread_name(const std::string& name);
+
+    /// {"traceEvents": [...]} with every span still buffered.
+    static std::string chrome_json();
+    /// Write chrome_json() to path and return the number of spans written.
+    /// Throws std::runtime_error if the file cannot be written.
+    static std::size_t write_chrome_json(const std::string& path);
+
+private:
+    static void append_event(const char* category, const char* name,
+                             Clock::time_point start, Clock::time_point end,
+                             const char* detail, const char* value_name,
+                             std::int64_t value, bool async) noexcept;
+
+    static std::atomic<bool> enabled_;
+};
+
+// Records [construction, destruction) as one span if tracing was on when it
+// was constructed.
+class TraceSpan {
+public:
+    TraceSpan(const char* category,
+              const char* name,
+              const char* detail = nullptr,
+              const char* value_name = nullptr,
+              std::int64_t value = 0) noexcept
+        : category_(category), name_(name), detail_(detail),
+          value_name_(value_name), value_(value)
+    {
+        if (TraceRecorder::enabled()) {
+            start_ = TraceRecorder::Clock::now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (start_ != TraceRecorder::Clock::time_point{}) {
+            TraceRecorder::record(category_, name_, start_, TraceRecorder::Clock::now(),
+                                  detail_, value_name_, value_);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void set_value(std::int64_t value) noexcept { value_ = value; }
+
+private:
+    const char* category_;
+    const char* name_;
+    const char* detail_;
+    const char* value_name_;
+    std::int64_t value_;
+    TraceRecorder::Clock::time_point start_{};
+};
+
+#endif // TRACE_RECORDER_HPP
@@ -0,0 +1,60 @@
+// usdt_probes.hpp
+#ifndef USDT_PROBES_HPP
+#define USDT_PROBES_HPP
+
+// USDT probes of the "pynetx" provider. They are compiled in only when the
+// project is configured with -DPYNETX_ENABLE_USDT=ON, which needs sys/sdt.h
+// (systemtap-sdt-dev / systemtap-sdt-devel). Each probe is then a single nop
+// until bpftrace or perf attaches to it; without the option the macros
+// only name their arguments inside sizeof, which evaluates nothing.
+//
+// Arguments are evaluated whenever a compiled-in probe site runs, so pass
+// only values that are already at hand. Strings are NUL-terminated C
+// strings; bpftrace reads them with str(argN).
+//
+//   rpc__start          label, fd, request bytes
+//   rpc__end            label, fd, reply bytes, failed (0/1), nanoseconds
+//   connect__phase      label, notification session (0/1), phase entered,
+//                       nanoseconds spent in the phase it leaves
+//   connect__end        label, notification session (0/1), failed (0/1),
+//                       failure kind, nanoseconds
+//   notification__enqueue  label, fd, bytes, queue depth after the push
+//   notification__drop  label, fd, bytes, notifications dropped so far
+//   reactor__wakeup     reactor id, events, bytes read
+//   reactor__handler    label, fd, bytes read, nanoseconds
+//   pool__task__start   worker index
+//   pool__task__end     worker index; time it against pool__task__start
+//                       on the same tid
+//
+// Example:
+//
+//   bpftrace -e 'usdt:./pyNetX*.so:pynetx:rpc__end
+//                { @us[str(arg0)] = hist(arg4 / 1000); }'
+
+#if defined(PYNETX_ENABLE_USDT)
+
+#include <sys/sdt.h>
+
+#define PYNETX_PROBE1(name, a1) DTRACE_PROBE1(pynetx, name, a1)
+#define PYNETX_PROBE2(name, a1, a2) DTRACE_PROBE2(pynetx, name, a1, a2)
+#define PYNETX_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(pynetx, name, a1, a2, a3)
+#define PYNETX_PROBE4(name, a1, a2, a3, a4) DTRACE_PROBE4(pynetx, name, a1, a2, a3, a4)
+#define PYNETX_PROBE5(name, a1, a2, a3, a4, a5) DTRACE_PROBE5(pynetx, name, a1, a2, a3, a4, a5)
+
+#else
+
+// Values computed only for a probe stay "used" without being evaluated.
+#define PYNETX_PROBE_UNUSED(a) ((void)sizeof(a))
+#define PYNETX_PROBE1(name, a1) PYNETX_PROBE_UNUSED(a1)
+#define PYNETX_PROBE2(name, a1, a2) \
+    (PYNETX_PROBE_UNUSED(a1), PYNETX_PROBE_UNUSED(a2))
+#define PYNETX_PROBE3(name, a1, a2, a3) \
+    (PYNETX_PROBE_UNUSED(a1), PYNETX_PROBE_UNUSED(a2), PYNETX_PROBE_UNUSED(a3))
+#define PYNETX_PROBE4(name, a1, a2, a3, a4) \
+    (PYNETX_PROBE3(name, a1, a2, a3), PYNETX_PROBE_UNUSED(a4))
+#define PYNETX_PROBE5(name, a1, a2, a3, a4, a5) \
+    (PYNETX_PROBE4(name, a1, a2, a3, a4), PYNETX_PROBE_UNUSED(a5))
+
+#endif
+
+#endif // USDT_PROBES_HPP
@@ -0,0 +1,122 @@
+// work_stealing_queue.hpp
+#ifndef WORK_STEALING_QUEUE_HPP
+#define WORK_STEALING_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free multi-producer/multi-consumer queue (Vyukov's sequence
+// ring), one per thread-pool worker.
+//
+// Tasks are mostly submitted from threads outside the pool (asyncio loop
+// threads), so every queue accepts concurrent producers. The owning worker
+// and idle thieves pop from the same end without a lock; a failed try_push()
+// tells the pool to use its overflow list instead.
+template <class T>
+class WorkStealingQueue {
+public:
+    explicit WorkStealingQueue(std::size_t capacity)
+        : cells_(round_up_pow2(capacity < 2 ? 2 : capacity)),
+          mask_(cells_.size() - 1)
+    {
+        for (std::size_t i = 0; i < cells_.size(); ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    WorkStealingQueue(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+    /// Moves from item only on success.
+    bool try_push(T& item) {
+        Cell* cell = nullptr;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            const std::intptr_t diff =
+                static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(item);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        Cell* cell = nullptr;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            const std::intptr_t diff =
+                static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->value);
+        // Release captured state now rather than when the slot is reused.
+        cell->value = T();
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Racy estimate; only for heuristics.
+    std::size_t size_approx() const noexcept {
+        const std::size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq{0};
+        T value{};
+    };
+
+    static std::size_t round_up_pow2(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::vector<Cell> cells_;
+    const std::size_t mask_;
+
+    // Producer and consumer positions live on separate cache lines.
+    char pad0_[64];
+    std::atomic<std::size_t> enqueue_pos_{0};
+    char pad1_[64 - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> dequeue_pos_{0};
+    char pad2_[64 - sizeof(std::atomic<std::size_t>)];
+};
+
+#endif // WORK_STEALING_QUEUE_HPP
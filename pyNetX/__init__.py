@@ -4,13 +4,37 @@ from .pyNetX import (
     NetconfAuthError,
     NetconfChannelError,
     NetconfConnectionRefusedError,
+    ThreadPoolFullError,
     NotificationHealthEvent,
+    NotificationIterator,
+    NotificationRecord,
+    NotificationStream,
+    notification_stream,
     set_threadpool_size,
+    get_threadpool_size,
+    set_threadpool_queue_limit,
     set_notification_reactor_count,
+    set_reactor_slow_handler_threshold,
+    reactor_stats,
     next_notification_event,
     next_notification_event_async,
     pending_notification_event_count,
     clear_notification_events,
+    connect_stats,
+    reset_connect_stats,
+    metrics_text,
+    start_metrics_server,
+    stop_metrics_server,
+    start_tracing,
+    stop_tracing,
+    dump_trace,
+    start_capture,
+    stop_capture,
+    set_log_level,
+    set_log_rate_limit,
+    set_log_handler,
+    flush_logs,
+    log_stats,
 )
 
 __all__ = [
@@ -19,11 +43,35 @@ __all__ = [
     "NetconfAuthError",
     "NetconfChannelError",
     "NetconfConnectionRefusedError",
+    "ThreadPoolFullError",
     "NotificationHealthEvent",
+    "NotificationIterator",
+    "NotificationRecord",
+    "NotificationStream",
+    "notification_stream",
     "set_threadpool_size",
+    "get_threadpool_size",
+    "set_threadpool_queue_limit",
     "set_notification_reactor_count",
+    "set_reactor_slow_handler_threshold",
+    "reactor_stats",
     "next_notification_event",
     "next_notification_event_async",
     "pending_notification_event_count",
     "clear_notification_events",
+    "connect_stats",
+    "reset_connect_stats",
+    "metrics_text",
+    "start_metrics_server",
+    "stop_metrics_server",
+    "start_tracing",
+    "stop_tracing",
+    "dump_trace",
+    "start_capture",
+    "stop_capture",
+    "set_log_level",
+    "set_log_rate_limit",
+    "set_log_handler",
+    "flush_logs",
+    "log_stats",
 ]
\ No newline at end of file
@@ -1,18 +1,41 @@
 # Stub File for pyNetX.
 
-from typing import Awaitable, Any
+from typing import AsyncIterator, Awaitable, Any, Callable, Literal
+
+Priority = Literal["interactive", "normal", "bulk"]
 
 def set_threadpool_size(n: int) -> None: ...
+def get_threadpool_size() -> int: ...
+def set_threadpool_queue_limit(max_queued: int, policy: Literal["reject", "defer"] = "reject") -> None: ...
 def set_notification_reactor_count(n: int) -> None: ...
+def set_reactor_slow_handler_threshold(threshold_ms: float) -> None: ...
+def reactor_stats() -> list[dict[str, Any]]: ...
 def next_notification_event(timeout_ms: int = -1) -> "NotificationHealthEvent": ...
 def next_notification_event_async(timeout_ms: int = -1) -> Awaitable["NotificationHealthEvent"]: ...
 def pending_notification_event_count() -> int: ...
 def clear_notification_events() -> None: ...
+def connect_stats() -> dict[str, Any]: ...
+def reset_connect_stats() -> None: ...
+def metrics_text() -> str: ...
+def start_metrics_server(port: int = 0) -> int: ...
+def stop_metrics_server() -> None: ...
+def start_tracing(events_per_thread: int = 32768) -> None: ...
+def stop_tracing() -> None: ...
+def dump_trace(path: str) -> int: ...
+def start_capture(path: str) -> None: ...
+def stop_capture() -> dict[str, int]: ...
+def set_log_level(level: int) -> None: ...
+def set_log_rate_limit(per_site_per_second: int) -> None: ...
+def set_log_handler(handler: Callable[[int, str], Any] | None) -> None: ...
+def flush_logs(timeout_ms: int = 1000) -> bool: ...
+def log_stats() -> dict[str, int]: ...
+def notification_stream(name: str = "default", max_bytes: int = -1) -> "NotificationStream": ...
 
 class NetconfException(RuntimeError): ...
 class NetconfConnectionRefusedError(ConnectionError): ...
 class NetconfAuthError(PermissionError): ...
 class NetconfChannelError(OSError): ...
+class ThreadPoolFullError(NetconfException): ...
 
 class NotificationHealthEvent:
     valid: bool
@@ -34,6 +57,29 @@ class NotificationHealthEvent:
     health_events_dropped: int
     def as_dict(self) -> dict[str, Any]: ...
 
+class NotificationRecord:
+    label: str
+    hostname: str
+    port: int
+    payload: str
+    def as_dict(self) -> dict[str, Any]: ...
+
+class NotificationStream:
+    @property
+    def name(self) -> str: ...
+    max_bytes: int
+    def next_batch(self, max_items: int = 100, timeout_ms: int = 10) -> list[NotificationRecord]: ...
+    def next_batch_async(self, max_items: int = 100, timeout_ms: int = 10) -> Awaitable[list[NotificationRecord]]: ...
+    def pending_count(self) -> int: ...
+    def pending_bytes(self) -> int: ...
+    def published_count(self) -> int: ...
+    def dropped_count(self) -> int: ...
+    def clear(self) -> None: ...
+
+class NotificationIterator(AsyncIterator[str]):
+    def __aiter__(self) -> "NotificationIterator": ...
+    def __anext__(self) -> Awaitable[str]: ...
+
 class NetconfClient:
     def __init__(
         self,
@@ -73,22 +119,30 @@ class NetconfClient:
     def commit_sync(self) -> str: ...
     def locked_edit_config_sync(self, target: str, config: str, do_validate: bool = False) -> str: ...
     # Asynchronous methods
-    def connect_async(self) -> Awaitable[bool]: ...
+    def connect_async(self, priority: Priority = "normal") -> Awaitable[bool]: ...
     def is_subscription_active(self) -> bool: ...
-    def disconnect_async(self) -> Awaitable[None]: ...
-    def send_rpc_async(self, rpc: str) -> Awaitable[str]: ...
+    def rpc_stats(self) -> dict[str, Any]: ...
+    def reset_rpc_stats(self) -> None: ...
+    def last_connect(self) -> dict[str, dict[str, Any] | None]: ...
+    def disconnect_async(self, priority: Priority = "normal") -> Awaitable[None]: ...
+    def send_rpc_async(self, rpc: str, priority: Priority = "normal") -> Awaitable[str]: ...
     def next_notification(self, timeout_ms: int = 10) -> str: ...
     def next_notification_async(self, timeout_ms: int = 10) -> Awaitable[str]: ...
+    def next_notifications(self, max_items: int = 100, timeout_ms: int = 10) -> list[str]: ...
+    def next_notifications_async(self, max_items: int = 100, timeout_ms: int = 10) -> Awaitable[list[str]]: ...
+    def notifications(self, max_batch: int = 100) -> NotificationIterator: ...
     def peek_notifications(self, max_items: int = 100) -> list[str]: ...
     def notification_queue_size(self) -> int: ...
-    def get_async(self, filter: str = "") -> Awaitable[str]: ...
-    def get_config_async(self, source: str = "running", filter: str = "") -> Awaitable[str]: ...
-    def copy_config_async(self, target: str, source: str) -> Awaitable[str]: ...
-    def delete_config_async(self, target: str) -> Awaitable[str]: ...
-    def validate_async(self, source: str = "running") -> Awaitable[str]: ...
-    def edit_config_async(self, target: str, config: str, do_validate: bool = False) -> Awaitable[str]: ...
-    def subscribe_async(self, stream: str = "NETCONF", filter: str = "") -> Awaitable[str]: ...
-    def lock_async(self, target: str = "running") -> Awaitable[str]: ...
-    def unlock_async(self, target: str = "running") -> Awaitable[str]: ...
-    def commit_async(self) -> Awaitable[str]: ...
-    def locked_edit_config_async(self, target: str, config: str, do_validate: bool = False) -> Awaitable[str]: ...
+    def attach_notification_stream(self, stream: NotificationStream) -> None: ...
+    def detach_notification_stream(self) -> None: ...
+    def get_async(self, filter: str = "", priority: Priority = "normal") -> Awaitable[str]: ...
+    def get_config_async(self, source: str = "running", filter: str = "", priority: Priority = "normal") -> Awaitable[str]: ...
+    def copy_config_async(self, target: str, source: str, priority: Priority = "normal") -> Awaitable[str]: ...
+    def delete_config_async(self, target: str, priority: Priority = "normal") -> Awaitable[str]: ...
+    def validate_async(self, source: str = "running", priority: Priority = "normal") -> Awaitable[str]: ...
+    def edit_config_async(self, target: str, config: str, do_validate: bool = False, priority: Priority = "normal") -> Awaitable[str]: ...
+    def subscribe_async(self, stream: str = "NETCONF", filter: str = "", priority: Priority = "normal") -> Awaitable[str]: ...
+    def lock_async(self, target: str = "running", priority: Priority = "normal") -> Awaitable[str]: ...
+    def unlock_async(self, target: str = "running", priority: Priority = "normal") -> Awaitable[str]: ...
+    def commit_async(self, priority: Priority = "normal") -> Awaitable[str]: ...
+    def locked_edit_config_async(self, target: str, config: str, do_validate: bool = False, priority: Priority = "normal") -> Awaitable[str]: ...
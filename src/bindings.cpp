@@ -3,17 +3,24 @@
 #include "netconf_client.hpp"
 #include "notification_reactor_manager.hpp"
 #include "notification_event_bus.hpp"
+#include "notification_stream.hpp"
 #include "thread_pool.hpp"
 #include "thread_pool_global.hpp"
+#include "channel_capture.hpp"
+#include "completion_hook.hpp"
+#include "event_fd_signal.hpp"
+#include "logger.hpp"
+#include "metrics_http_server.hpp"
+#include "metrics_registry.hpp"
+#include "trace_recorder.hpp"
 #include <future>
 #include <thread>
-#include <iostream>
 #include <libssh2.h>
 #include <chrono>
-#include <condition_variable>
+#include <deque>
 #include <functional>
-#include <iterator>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 namespace py = pybind11;
@@ -42,6 +49,9 @@ void register_exceptions(py::module_ &m) {
     static py::exception<NetconfException> netconfBase(
         m, "NetconfException", PyExc_RuntimeError
     );
+    static py::exception<ThreadPoolFullError> poolFull(
+        m, "ThreadPoolFullError", netconfBase.ptr()
+    );
 }
 
 
@@ -51,21 +61,6 @@ inline bool fut_pending(const py::object &f)
 }
 
 
-inline void reset_py_objects_safely(
-    std::shared_ptr<py::object>& loop_ptr,
-    std::shared_ptr<py::object>& py_future_ptr
-) noexcept {
-    try {
-        py::gil_scoped_acquire acquire;
-        loop_ptr.reset();
-        py_future_ptr.reset();
-    } catch (...) {
-        // Never allow cleanup of Python references from a detached C++ thread
-        // to terminate the process.
-    }
-}
-
-
 inline py::object python_exception_from_cpp_exception(const std::exception& e) {
     py::module_ pyNetX = py::module_::import("pyNetX");
 
@@ -81,6 +76,9 @@ inline py::object python_exception_from_cpp_exception(const std::exception& e) {
     if (dynamic_cast<const NetconfException*>(&e)) {
         return pyNetX.attr("NetconfException")(e.what());
     }
+    if (dynamic_cast<const ThreadPoolFullError*>(&e)) {
+        return pyNetX.attr("ThreadPoolFullError")(e.what());
+    }
 
     auto builtins = py::module_::import("builtins");
     return builtins.attr("RuntimeError")(e.what());
@@ -89,259 +87,497 @@ inline py::object python_exception_from_cpp_exception(const std::exception& e) {
 
 namespace {
 
-    constexpr auto ASYNC_FUTURE_POLL_INTERVAL = std::chrono::milliseconds(50);
+    class LoopCompletionQueue;
+
+    // One C++ future waiting to be delivered to its asyncio future. It is the
+    // CompletionHook target itself: ready() runs on the thread that completed
+    // the future and queues it for its loop; resolve() runs on the event loop
+    // thread with the GIL held.
+    class PendingCompletion
+        : public CompletionHook::Target,
+          public std::enable_shared_from_this<PendingCompletion> {
+    public:
+        explicit PendingCompletion(std::shared_ptr<LoopCompletionQueue> queue)
+            : queue_(std::move(queue)) {}
+
+        virtual ~PendingCompletion() = default;
+        virtual void resolve() = 0;
+
+        void ready() override;
+
+    private:
+        std::shared_ptr<LoopCompletionQueue> queue_;
+    };
+
+    template <typename T>
+    void set_future_result(py::object& py_future, const std::shared_future<T>& future) {
+        py_future.attr("set_result")(future.get());
+    }
+
+    inline void set_future_result(py::object& py_future, const std::shared_future<void>& future) {
+        future.get();
+        py_future.attr("set_result")(py::none());
+    }
 
-    class AsyncFutureDispatcher {
+    template <typename T>
+    class FutureCompletion : public PendingCompletion {
     public:
-        static AsyncFutureDispatcher& instance() {
-            // Intentionally leaked: avoids Python-finalization order problems with
-            // a global C++ object whose thread may still hold Python references.
-            static AsyncFutureDispatcher* dispatcher = new AsyncFutureDispatcher();
-            return *dispatcher;
+        FutureCompletion(std::shared_ptr<LoopCompletionQueue> queue, py::object py_future)
+            : PendingCompletion(std::move(queue)), py_future_(std::move(py_future)) {}
+
+        ~FutureCompletion() override {
+            // The last reference can be dropped by a worker thread, e.g. when a
+            // task is discarded without running.
+            if (!py_future_) {
+                return;
+            }
+            try {
+                py::gil_scoped_acquire acquire;
+                py_future_ = py::object();
+            } catch (...) {
+                // Never let Python cleanup terminate a C++ thread.
+            }
         }
 
-        void add(std::function<bool()> poller) {
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                pending_.emplace_back(std::move(poller));
+        void set_future(std::shared_future<T> future) { future_ = std::move(future); }
+        const std::shared_future<T>& future() const noexcept { return future_; }
+
+        void resolve() override {
+            if (!fut_pending(py_future_)) {
+                return;
+            }
+
+            try {
+                set_future_result(py_future_, future_);
+            } catch (const std::exception& e) {
+                py_future_.attr("set_exception")(python_exception_from_cpp_exception(e));
             }
-            cv_.notify_one();
         }
 
     private:
-        AsyncFutureDispatcher()
-            : worker_([this]() { run(); })
-        {
-            // The dispatcher owns process-lifetime state through the leaked
-            // singleton above. Detaching avoids a join during interpreter shutdown.
-            worker_.detach();
-        }
+        std::shared_future<T> future_;
+        py::object py_future_;
+    };
 
-        void run() {
-            std::vector<std::function<bool()>> batch;
+    // Per-event-loop completion queue.
+    //
+    // Worker threads push completions without the GIL and write the eventfd
+    // only on the empty -> non-empty transition. The loop watches the eventfd
+    // with add_reader() and resolves every queued completion in one callback,
+    // under the GIL the loop thread already holds.
+    class LoopCompletionQueue {
+    public:
+        static std::shared_ptr<LoopCompletionQueue> for_loop(const py::object& loop) {
+            // Intentionally leaked, like the other process-wide registries.
+            // Entries go away with their loop.
+            static py::object* queues = new py::object(
+                py::module_::import("weakref").attr("WeakKeyDictionary")()
+            );
 
-            for (;;) {
-                {
-                    std::unique_lock<std::mutex> lock(mutex_);
+            py::object existing = queues->attr("get")(loop);
+            if (!existing.is_none()) {
+                auto* holder = static_cast<std::shared_ptr<LoopCompletionQueue>*>(
+                    existing.cast<py::capsule>()
+                );
+                return *holder;
+            }
 
-                    if (pending_.empty()) {
-                        cv_.wait(lock, [this]() { return !pending_.empty(); });
-                    } else {
-                        cv_.wait_for(lock, ASYNC_FUTURE_POLL_INTERVAL);
-                    }
+            auto queue = std::make_shared<LoopCompletionQueue>();
+            loop.attr("add_reader")(
+                queue->wakeup_.fd(),
+                py::cpp_function([queue]() { queue->drain(); })
+            );
 
-                    batch.swap(pending_);
+            py::capsule holder(
+                new std::shared_ptr<LoopCompletionQueue>(queue),
+                [](void* ptr) {
+                    delete static_cast<std::shared_ptr<LoopCompletionQueue>*>(ptr);
                 }
+            );
+            (*queues)[loop] = holder;
 
-                std::vector<std::function<bool()>> still_pending;
-                still_pending.reserve(batch.size());
-
-                for (auto& poller : batch) {
-                    bool done = true;
-
-                    try {
-                        done = poller();
-                    } catch (const std::exception& e) {
-                        std::cerr << "pyNetX async dispatcher dropped a poller: "
-                                << e.what() << std::endl;
-                    } catch (...) {
-                        std::cerr << "pyNetX async dispatcher dropped a poller with unknown error"
-                                << std::endl;
-                    }
-
-                    if (!done) {
-                        still_pending.emplace_back(std::move(poller));
-                    }
+            return queue;
+        }
+
+        void push(std::shared_ptr<PendingCompletion> completion) noexcept {
+            try {
+                bool was_empty = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    was_empty = ready_.empty();
+                    ready_.push_back(std::move(completion));
                 }
+                if (was_empty) {
+                    wakeup_.notify(true);
+                }
+            } catch (const std::exception& e) {
+                NETX_LOG(LogLevel::Error, "pyNetX: failed to queue async completion: "
+                         << e.what());
+            }
+        }
 
-                batch.clear();
+    private:
+        void drain() {
+            wakeup_.drain();
 
-                if (!still_pending.empty()) {
-                    std::lock_guard<std::mutex> lock(mutex_);
-                    pending_.insert(
-                        pending_.end(),
-                        std::make_move_iterator(still_pending.begin()),
-                        std::make_move_iterator(still_pending.end())
-                    );
+            std::vector<std::shared_ptr<PendingCompletion>> batch;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                batch.swap(ready_);
+            }
+            TraceSpan span("async", "resolve_futures", nullptr, "futures",
+                           static_cast<std::int64_t>(batch.size()));
+
+            for (auto& completion : batch) {
+                try {
+                    completion->resolve();
+                } catch (const std::exception& e) {
+                    NETX_LOG(LogLevel::Error, "pyNetX: failed to complete future: "
+                             << e.what());
                 }
             }
         }
 
         std::mutex mutex_;
-        std::condition_variable cv_;
-        std::vector<std::function<bool()>> pending_;
-        std::thread worker_;
+        std::vector<std::shared_ptr<PendingCompletion>> ready_;
+        EventFdSignal wakeup_;
     };
 
+    void PendingCompletion::ready() {
+        queue_->push(shared_from_this());
+    }
+
 } // namespace
 
 
-// ---- Utility: wrap std::future<T> into an asyncio Future ----
-template <typename T>
-py::object wrap_future(std::future<T> fut)
+// ---- Utility: run a C++ async call and expose its std::future as an asyncio Future ----
+// make_future() is called with a CompletionHook open, so the thread pool pushes
+// the completion to this loop's queue as soon as the task finishes.
+template <typename MakeFuture>
+py::object wrap_future(MakeFuture make_future)
 {
-    std::shared_future<T> sfut = fut.share();
-    py::object asyncio = py::module::import("asyncio");
+    using Future = decltype(make_future());
+    using T = decltype(std::declval<Future&>().get());
+
+    py::object asyncio = py::module_::import("asyncio");
     py::object loop = asyncio.attr("get_running_loop")();
     py::object py_future = loop.attr("create_future")();
 
-    auto loop_ptr = std::make_shared<py::object>(loop);
-    auto py_future_ptr = std::make_shared<py::object>(py_future);
+    auto completion = std::make_shared<FutureCompletion<T>>(
+        LoopCompletionQueue::for_loop(loop), py_future
+    );
 
-    AsyncFutureDispatcher::instance().add(
-        [sfut = std::move(sfut), loop_ptr, py_future_ptr]() mutable -> bool {
-            if (sfut.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
-                return false;
-            }
+    bool hooked = false;
+    {
+        CompletionHook::Scope scope(completion);
+        completion->set_future(make_future().share());
+        hooked = scope.taken();
+    }
 
-            try {
-                py::gil_scoped_acquire acquire;
+    if (!hooked) {
+        // Every *_async call hands its hook to the pool, a strand or a
+        // registered waiter. A future that bypassed them is only accepted if
+        // it is already done; nothing would wake the loop for a pending one,
+        // and parking a pool worker on it would starve real work.
+        if (completion->future().wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            completion->resolve();
+        } else {
+            py_future.attr("set_exception")(py::module_::import("builtins").attr("RuntimeError")(
+                "pyNetX: async call returned a future without a completion hook"
+            ));
+        }
+    }
 
-                if (!fut_pending(*py_future_ptr)) {
-                    reset_py_objects_safely(loop_ptr, py_future_ptr);
-                    return true;
-                }
+    return py_future;
+}
 
-                try {
-                    T result = sfut.get();
-
-                    auto callback = py::cpp_function(
-                        [py_future_ptr, result](py::args) {
-                            if (fut_pending(*py_future_ptr)) {
-                                (*py_future_ptr).attr("set_result")(result);
-                            }
-                        }
-                    );
-
-                    try {
-                        (*loop_ptr).attr("call_soon_threadsafe")(callback);
-                    } catch (const std::exception& e) {
-                        std::cerr << "pyNetX: call_soon_threadsafe(set_result) failed: "
-                                  << e.what() << std::endl;
-                    }
+// ---- Utility: latency summaries and stats snapshots as dicts ----
+// Latencies are microseconds; a phase that was never reached is None.
+py::dict latency_summary_to_dict(const LatencySummary& summary)
+{
+    py::dict doc;
+    doc["count"] = summary.count;
+    doc["mean_us"] = summary.mean_us;
+    doc["p50_us"] = summary.p50_us;
+    doc["p90_us"] = summary.p90_us;
+    doc["p99_us"] = summary.p99_us;
+    doc["p999_us"] = summary.p999_us;
+    doc["max_us"] = summary.max_us;
+    return doc;
+}
 
-                } catch (const std::exception& e) {
-                    py::object exception_obj = python_exception_from_cpp_exception(e);
-
-                    auto callback = py::cpp_function(
-                        [py_future_ptr, exception_obj](py::args) {
-                            if (fut_pending(*py_future_ptr)) {
-                                (*py_future_ptr).attr("set_exception")(exception_obj);
-                            }
-                        }
-                    );
-
-                    try {
-                        (*loop_ptr).attr("call_soon_threadsafe")(callback);
-                    } catch (const std::exception& inner) {
-                        std::cerr << "pyNetX: call_soon_threadsafe(set_exception) failed: "
-                                  << inner.what() << std::endl;
-                    }
-                }
+py::dict rpc_stats_to_dict(const RpcStatsSnapshot& stats)
+{
+    py::dict phases;
+    py::dict last;
+    for (std::size_t i = 0; i < RPC_PHASE_COUNT; ++i) {
+        const char* name = rpc_phase_name(static_cast<RpcPhase>(i));
+        phases[name] = latency_summary_to_dict(stats.phases[i]);
+
+        if (stats.has_last && stats.last_nanos[i] >= 0) {
+            last[name] = static_cast<double>(stats.last_nanos[i]) / 1000.0;
+        } else {
+            last[name] = py::none();
+        }
+    }
 
-                reset_py_objects_safely(loop_ptr, py_future_ptr);
-                return true;
+    py::dict doc;
+    doc["rpcs"] = stats.rpcs;
+    doc["failed"] = stats.failed;
+    doc["window_seconds"] = stats.window_seconds;
+    doc["phases"] = phases;
+    if (stats.has_last) {
+        last["failed"] = stats.last_failed;
+        doc["last"] = last;
+    } else {
+        doc["last"] = py::none();
+    }
+    return doc;
+}
 
-            } catch (const std::exception& e) {
-                std::cerr << "pyNetX async dispatcher failed to complete future: "
-                          << e.what() << std::endl;
-                reset_py_objects_safely(loop_ptr, py_future_ptr);
-                return true;
-            } catch (...) {
-                std::cerr << "pyNetX async dispatcher failed to complete future with unknown exception"
-                          << std::endl;
-                reset_py_objects_safely(loop_ptr, py_future_ptr);
-                return true;
-            }
+py::dict connect_trace_to_dict(const ConnectTrace& trace)
+{
+    py::dict phases;
+    for (std::size_t i = 0; i < CONNECT_PHASE_COUNT; ++i) {
+        const char* name = connect_phase_name(static_cast<ConnectPhase>(i));
+        if (trace.phase_nanos[i] >= 0) {
+            phases[name] = static_cast<double>(trace.phase_nanos[i]) / 1000.0;
+        } else {
+            phases[name] = py::none();
         }
-    );
+    }
 
-    return py_future;
+    py::dict doc;
+    doc["session"] = trace.notification_session ? "notification" : "rpc";
+    doc["ok"] = !trace.failed;
+    doc["total_us"] = static_cast<double>(trace.total_nanos()) / 1000.0;
+    doc["phases"] = phases;
+    if (trace.failed) {
+        doc["failed_phase"] = connect_phase_name(trace.phase);
+        doc["failure"] = connect_failure_name(trace.failure);
+        doc["error"] = trace.message;
+    } else {
+        doc["failed_phase"] = py::none();
+        doc["failure"] = py::none();
+        doc["error"] = py::none();
+    }
+    return doc;
 }
 
+py::dict connect_record_to_dict(const ConnectRecord& record)
+{
+    py::dict doc = connect_trace_to_dict(record.trace);
+    doc["label"] = record.label;
+    doc["host"] = record.hostname;
+    doc["port"] = record.port;
+    return doc;
+}
 
-// Specialization for std::future<void>
-template <>
-py::object wrap_future<void>(std::future<void> fut)
+py::dict connect_stats_to_dict(const ConnectStatsSnapshot& stats)
 {
-    std::shared_future<void> sfut = fut.share();
-    py::object asyncio = py::module::import("asyncio");
-    py::object loop = asyncio.attr("get_running_loop")();
-    py::object py_future = loop.attr("create_future")();
+    py::dict phases;
+    py::dict failures;
+    for (std::size_t i = 0; i < CONNECT_PHASE_COUNT; ++i) {
+        const char* name = connect_phase_name(static_cast<ConnectPhase>(i));
+        phases[name] = latency_summary_to_dict(stats.phases[i]);
+
+        // Only the phases and kinds that actually failed.
+        py::dict kinds;
+        for (std::size_t k = 1; k < CONNECT_FAILURE_COUNT; ++k) {
+            if (stats.failures[i][k] != 0) {
+                kinds[connect_failure_name(static_cast<ConnectFailure>(k))] = stats.failures[i][k];
+            }
+        }
+        if (!kinds.empty()) {
+            failures[name] = kinds;
+        }
+    }
+
+    py::list slowest;
+    for (const auto& record : stats.slowest) {
+        slowest.append(connect_record_to_dict(record));
+    }
+    py::list recent_failures;
+    for (const auto& record : stats.recent_failures) {
+        recent_failures.append(connect_record_to_dict(record));
+    }
+
+    py::dict doc;
+    doc["attempts"] = stats.attempts;
+    doc["succeeded"] = stats.succeeded;
+    doc["failed"] = stats.failed;
+    doc["phases"] = phases;
+    doc["total"] = latency_summary_to_dict(stats.total);
+    doc["failures"] = failures;
+    doc["slowest"] = slowest;
+    doc["recent_failures"] = recent_failures;
+    return doc;
+}
+
+py::dict reactor_stats_to_dict(const ReactorStatsSnapshot& stats)
+{
+    // Only the batch sizes that occurred.
+    py::dict events_per_wakeup;
+    for (std::size_t n = 1; n < stats.events_per_wakeup.size(); ++n) {
+        if (stats.events_per_wakeup[n] != 0) {
+            events_per_wakeup[py::int_(n)] = stats.events_per_wakeup[n];
+        }
+    }
+
+    py::list handlers;
+    for (const auto& handler : stats.handlers) {
+        py::dict doc;
+        doc["fd"] = handler.fd;
+        doc["label"] = handler.label;
+        doc["host"] = handler.hostname;
+        doc["port"] = handler.port;
+        doc["calls"] = handler.calls;
+        doc["bytes"] = handler.bytes;
+        doc["slow"] = handler.slow;
+        doc["busy_s"] = handler.busy_seconds;
+        doc["handler"] = latency_summary_to_dict(handler.handler);
+        handlers.append(doc);
+    }
+
+    py::dict doc;
+    doc["reactor"] = stats.reactor;
+    doc["uptime_s"] = stats.uptime_seconds;
+    doc["busy_s"] = stats.busy_seconds;
+    doc["load"] = stats.uptime_seconds > 0 ? stats.busy_seconds / stats.uptime_seconds : 0.0;
+    doc["wakeups"] = stats.wakeups;
+    doc["events"] = stats.events;
+    doc["events_per_wakeup"] = events_per_wakeup;
+    doc["bytes"] = stats.bytes;
+    doc["mean_bytes_per_wakeup"] =
+        stats.wakeups > 0 ? static_cast<double>(stats.bytes) / static_cast<double>(stats.wakeups) : 0.0;
+    doc["max_bytes_per_wakeup"] = stats.max_bytes_per_wakeup;
+    doc["dispatch_lag"] = latency_summary_to_dict(stats.dispatch_lag);
+    doc["handlers"] = handlers;
+    return doc;
+}
+
+
+// ---- Async iterator over one client's notification queue ----
+// Waiting is driven by the queue's eventfd through loop.add_reader(): the
+// reactor writes the eventfd when it enqueues for an armed waiter, so no pool
+// thread is parked and no dispatcher polling interval is involved. Items are
+// drained in batches and handed out one per __anext__().
+class NotificationAsyncIterator
+    : public std::enable_shared_from_this<NotificationAsyncIterator> {
+public:
+    NotificationAsyncIterator(std::shared_ptr<NetconfClient> client, std::size_t max_batch)
+        : client_(std::move(client)), max_batch_(max_batch) {}
+
+    py::object anext() {
+        py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+        py::object future = loop.attr("create_future")();
+
+        if (take_buffered(future)) {
+            return future;
+        }
+
+        if (!client_->is_subscription_active()) {
+            PyErr_SetNone(PyExc_StopAsyncIteration);
+            throw py::error_already_set();
+        }
+
+        if (!client_->claim_notification_ready_fd()) {
+            throw NetconfException(
+                "Another notifications() consumer is already waiting on this client"
+            );
+        }
 
-    auto loop_ptr = std::make_shared<py::object>(loop);
-    auto py_future_ptr = std::make_shared<py::object>(py_future);
+        int fd = -1;
+        try {
+            fd = client_->notification_ready_fd();
 
-    AsyncFutureDispatcher::instance().add(
-        [sfut = std::move(sfut), loop_ptr, py_future_ptr]() mutable -> bool {
-            if (sfut.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
-                return false;
+            // Arm before registering: anything enqueued from here on writes
+            // the eventfd, and anything enqueued earlier is seen by this check.
+            if (client_->arm_notification_ready_fd() && take_buffered(future)) {
+                client_->release_notification_ready_fd();
+                return future;
             }
 
+            auto self = shared_from_this();
+            loop.attr("add_reader")(fd, py::cpp_function([self, future]() {
+                self->on_readable(future);
+            }));
+        } catch (...) {
+            client_->release_notification_ready_fd();
+            throw;
+        }
+
+        // Single cleanup point for result, exception and cancellation.
+        auto client = client_;
+        future.attr("add_done_callback")(py::cpp_function([client, loop, fd](py::object) {
             try {
-                py::gil_scoped_acquire acquire;
+                loop.attr("remove_reader")(fd);
+            } catch (const std::exception& e) {
+                NETX_LOG(LogLevel::Error, "pyNetX: remove_reader(notification fd) failed: "
+                         << e.what());
+            }
+            client->release_notification_ready_fd();
+        }));
 
-                if (!fut_pending(*py_future_ptr)) {
-                    reset_py_objects_safely(loop_ptr, py_future_ptr);
-                    return true;
-                }
+        return future;
+    }
 
-                try {
-                    sfut.get();
-
-                    auto callback = py::cpp_function(
-                        [py_future_ptr](py::args) {
-                            if (fut_pending(*py_future_ptr)) {
-                                (*py_future_ptr).attr("set_result")(py::none());
-                            }
-                        }
-                    );
-
-                    try {
-                        (*loop_ptr).attr("call_soon_threadsafe")(callback);
-                    } catch (const std::exception& e) {
-                        std::cerr << "pyNetX: call_soon_threadsafe(set_result void) failed: "
-                                  << e.what() << std::endl;
-                    }
+private:
+    bool take_buffered(py::object& future) {
+        if (buffered_.empty()) {
+            std::vector<std::string> batch;
+            {
+                py::gil_scoped_release release;
+                batch = client_->try_next_notifications(max_batch_);
+            }
+            for (auto& item : batch) {
+                buffered_.push_back(std::move(item));
+            }
+        }
 
-                } catch (const std::exception& e) {
-                    py::object exception_obj = python_exception_from_cpp_exception(e);
-
-                    auto callback = py::cpp_function(
-                        [py_future_ptr, exception_obj](py::args) {
-                            if (fut_pending(*py_future_ptr)) {
-                                (*py_future_ptr).attr("set_exception")(exception_obj);
-                            }
-                        }
-                    );
-
-                    try {
-                        (*loop_ptr).attr("call_soon_threadsafe")(callback);
-                    } catch (const std::exception& inner) {
-                        std::cerr << "pyNetX: call_soon_threadsafe(set_exception void) failed: "
-                                  << inner.what() << std::endl;
-                    }
-                }
+        if (buffered_.empty()) {
+            return false;
+        }
 
-                reset_py_objects_safely(loop_ptr, py_future_ptr);
-                return true;
+        future.attr("set_result")(buffered_.front());
+        buffered_.pop_front();
+        return true;
+    }
 
-            } catch (const std::exception& e) {
-                std::cerr << "pyNetX async dispatcher failed to complete void future: "
-                          << e.what() << std::endl;
-                reset_py_objects_safely(loop_ptr, py_future_ptr);
-                return true;
-            } catch (...) {
-                std::cerr << "pyNetX async dispatcher failed to complete void future with unknown exception"
-                          << std::endl;
-                reset_py_objects_safely(loop_ptr, py_future_ptr);
-                return true;
+    void on_readable(py::object future) {
+        client_->drain_notification_ready_fd();
+
+        if (!fut_pending(future)) {
+            return;
+        }
+
+        try {
+            if (take_buffered(future)) {
+                return;
+            }
+
+            if (!client_->is_subscription_active()) {
+                future.attr("set_exception")(
+                    py::reinterpret_borrow<py::object>(PyExc_StopAsyncIteration)()
+                );
+                return;
+            }
+
+            // Spurious or stolen wakeup: re-arm and keep the reader registered.
+            if (client_->arm_notification_ready_fd()) {
+                take_buffered(future);
+            }
+        } catch (const std::exception& e) {
+            if (fut_pending(future)) {
+                future.attr("set_exception")(python_exception_from_cpp_exception(e));
             }
         }
-    );
+    }
 
-    return py_future;
-}
+    std::shared_ptr<NetconfClient> client_;
+    std::size_t max_batch_;
+    std::deque<std::string> buffered_;
+};
 
 
 PYBIND11_MODULE(pyNetX, m) {
@@ -352,7 +588,31 @@ PYBIND11_MODULE(pyNetX, m) {
     m.def("set_threadpool_size", [](int n){
         init_global_pool(n);
     }, py::arg("n"),
-    "Set the size of the global thread pool for all NetconfClient async operations."
+    "Set the size of the global thread pool for all NetconfClient async operations. "
+    "The pool is resized in place: queued work is kept and running tasks are not waited for."
+    );
+    m.def("get_threadpool_size", &global_pool_size,
+        "Return the number of active workers in the global thread pool."
+    );
+    m.def("set_threadpool_queue_limit", [](long long max_queued, const std::string& policy) {
+        if (max_queued < 0) {
+            throw std::invalid_argument("max_queued must be >= 0");
+        }
+        AdmissionPolicy admission;
+        if (policy == "reject") {
+            admission = AdmissionPolicy::Reject;
+        } else if (policy == "defer") {
+            admission = AdmissionPolicy::Defer;
+        } else {
+            throw std::invalid_argument("policy must be 'reject' or 'defer'");
+        }
+        get_pool().set_queue_limit(static_cast<size_t>(max_queued), admission);
+    }, py::arg("max_queued"), py::arg("policy") = "reject",
+    "Limit tasks queued in the global thread pool, including calls waiting "
+    "behind a busy client; 0 removes the limit. "
+    "Interactive-priority calls are always admitted. With policy='reject' other "
+    "calls fail with ThreadPoolFullError; with policy='defer' they wait outside "
+    "the pool queues until the depth drops."
     );
     m.def("set_notification_reactor_count",
         [](size_t n){
@@ -361,6 +621,30 @@ PYBIND11_MODULE(pyNetX, m) {
         py::arg("num_reactors"),
         "Reconfigure the number of notification-reactor threads on the fly."
     );
+    m.def("set_reactor_slow_handler_threshold",
+        [](double threshold_ms) {
+            if (threshold_ms < 0) {
+                throw std::invalid_argument("threshold_ms must not be negative");
+            }
+            NotificationReactor::set_slow_handler_threshold(
+                std::chrono::microseconds(static_cast<std::int64_t>(threshold_ms * 1000.0)));
+        },
+        py::arg("threshold_ms"),
+        "Emit a 'slow_notification_handler' health event when one notification "
+        "read holds a reactor for at least threshold_ms; 0 disables the events."
+    );
+    m.def("reactor_stats", []() {
+        std::vector<ReactorStatsSnapshot> stats;
+        {
+            py::gil_scoped_release release;
+            stats = NotificationReactorManager::instance().stats();
+        }
+        py::list out;
+        for (const auto& reactor : stats) {
+            out.append(reactor_stats_to_dict(reactor));
+        }
+        return out;
+    });
     m.doc() = "NETCONF client with async non blocking capabilities.";
 
     register_exceptions(m);
@@ -411,7 +695,7 @@ PYBIND11_MODULE(pyNetX, m) {
     }, py::arg("timeout_ms") = -1);
 
     m.def("next_notification_event_async", [](int timeout_ms) {
-        return wrap_future(NotificationEventBus::instance().next_event_async(timeout_ms));
+        return wrap_future([&]() { return NotificationEventBus::instance().next_event_async(timeout_ms); });
     }, py::arg("timeout_ms") = -1);
 
     m.def("pending_notification_event_count", []() {
@@ -424,6 +708,207 @@ PYBIND11_MODULE(pyNetX, m) {
         NotificationEventBus::instance().clear();
     });
 
+    m.def("connect_stats", []() {
+        ConnectStatsSnapshot stats;
+        {
+            py::gil_scoped_release release;
+            stats = ConnectStats::instance().snapshot();
+        }
+        return connect_stats_to_dict(stats);
+    });
+
+    m.def("reset_connect_stats", []() {
+        ConnectStats::instance().reset();
+    }, py::call_guard<py::gil_scoped_release>());
+
+    m.def("metrics_text", []() {
+        std::string text;
+        {
+            py::gil_scoped_release release;
+            text = MetricsRegistry::instance().render_openmetrics();
+        }
+        return text;
+    });
+
+    m.def("start_metrics_server", [](int port) {
+        return MetricsHttpServer::instance().start(port);
+    }, py::arg("port") = 0, py::call_guard<py::gil_scoped_release>());
+
+    m.def("stop_metrics_server", []() {
+        MetricsHttpServer::instance().stop();
+    }, py::call_guard<py::gil_scoped_release>());
+
+    m.def("start_tracing", [](std::size_t events_per_thread) {
+        TraceRecorder::start(events_per_thread);
+    }, py::arg("events_per_thread") = TraceRecorder::DEFAULT_EVENTS_PER_THREAD,
+    py::call_guard<py::gil_scoped_release>(),
+    "Discard earlier spans and record pool tasks, RPC phases, reactor wakeups, "
+    "notification framing and asyncio completions into per-thread rings."
+    );
+
+    m.def("stop_tracing", []() {
+        TraceRecorder::stop();
+    });
+
+    m.def("dump_trace", [](const std::string& path) {
+        return TraceRecorder::write_chrome_json(path);
+    }, py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+    "Write the buffered spans as Chrome trace-event JSON; returns the span count."
+    );
+
+    m.def("start_capture", [](const std::string& path) {
+        ChannelCapture::start(path);
+    }, py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+    "Record every read from RPC and notification channels, with timestamps, into "
+    "path for benchmarks/capture_replay. Truncates path."
+    );
+
+    m.def("stop_capture", []() {
+        ChannelCapture::Totals totals;
+        {
+            py::gil_scoped_release release;
+            totals = ChannelCapture::stop();
+        }
+        py::dict out;
+        out["records"] = totals.records;
+        out["bytes"] = totals.bytes;
+        return out;
+    }, "Stop capturing and close the file; returns the records and bytes written.");
+
+    m.def("set_log_level", [](int level) {
+        if (level < 0) {
+            throw std::invalid_argument("level must not be negative");
+        }
+        Logger::set_level(static_cast<LogLevel>(level));
+    }, py::arg("level"),
+    "Drop native log messages below level, a Python logging level such as "
+    "logging.WARNING. The default is logging.INFO."
+    );
+
+    m.def("set_log_rate_limit", [](long long per_site_per_second) {
+        if (per_site_per_second < 0) {
+            throw std::invalid_argument("per_site_per_second must be >= 0");
+        }
+        Logger::set_rate_limit(static_cast<std::uint32_t>(per_site_per_second));
+    }, py::arg("per_site_per_second"),
+    "Let at most this many messages per second through from each native log "
+    "statement; 0 turns the limit off. Held-back messages are counted in the next one."
+    );
+
+    m.def("set_log_handler", [](py::object handler) {
+        if (handler.is_none()) {
+            py::gil_scoped_release release;
+            Logger::set_sink(nullptr);
+            return;
+        }
+        if (!PyCallable_Check(handler.ptr())) {
+            throw std::invalid_argument("handler must be callable or None");
+        }
+
+        // The handler is dropped by whichever thread replaces the sink.
+        std::shared_ptr<py::object> callable(new py::object(std::move(handler)), [](py::object* obj) {
+            if (!Py_IsInitialized()) {
+                return;  // leak rather than touch a finalized interpreter
+            }
+            py::gil_scoped_acquire acquire;
+            delete obj;
+        });
+
+        Logger::Sink sink = [callable](LogLevel level, const std::string& message) {
+            if (!Py_IsInitialized()) {
+                throw std::runtime_error("interpreter is finalized");
+            }
+            py::gil_scoped_acquire acquire;
+            try {
+                (*callable)(static_cast<int>(level), message);
+            } catch (py::error_already_set& e) {
+                // Fall back to stderr for this message.
+                throw std::runtime_error(e.what());
+            }
+        };
+
+        py::gil_scoped_release release;
+        Logger::set_sink(std::move(sink));
+    }, py::arg("handler"),
+    "Send native log messages to handler(level, message) instead of stderr, e.g. "
+    "logging.getLogger('pyNetX').log. Called from the log writer thread; None "
+    "restores stderr."
+    );
+
+    m.def("flush_logs", [](long long timeout_ms) {
+        return Logger::flush(timeout_ms);
+    }, py::arg("timeout_ms") = 1000, py::call_guard<py::gil_scoped_release>(),
+    "Wait until native log messages logged so far have been written; False on timeout."
+    );
+
+    m.def("log_stats", []() {
+        const LogStats stats = Logger::stats();
+        py::dict out;
+        out["written"] = stats.written;
+        out["dropped"] = stats.dropped;
+        out["suppressed"] = stats.suppressed;
+        out["level"] = static_cast<int>(stats.level);
+        out["rate_limit"] = stats.rate_limit;
+        return out;
+    });
+
+    // Hand pending messages to the Python handler and detach it while the
+    // interpreter can still run it.
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() {
+        py::gil_scoped_release release;
+        Logger::flush(200);
+        Logger::set_sink(nullptr);
+    }));
+
+    py::class_<NotificationAsyncIterator, std::shared_ptr<NotificationAsyncIterator>>(
+        m, "NotificationIterator")
+        .def("__aiter__", [](std::shared_ptr<NotificationAsyncIterator>& self) {
+            return self;
+        })
+        .def("__anext__", &NotificationAsyncIterator::anext);
+
+    py::class_<NotificationRecord>(m, "NotificationRecord")
+        .def_readonly("label", &NotificationRecord::label)
+        .def_readonly("hostname", &NotificationRecord::hostname)
+        .def_readonly("port", &NotificationRecord::port)
+        .def_readonly("payload", &NotificationRecord::payload)
+        .def("as_dict", [](const NotificationRecord& record) {
+            py::dict doc;
+            doc["label"] = record.label;
+            doc["hostname"] = record.hostname;
+            doc["port"] = record.port;
+            doc["payload"] = record.payload;
+            return doc;
+        });
+
+    py::class_<NotificationStream, std::shared_ptr<NotificationStream>>(m, "NotificationStream")
+        .def_property_readonly("name", &NotificationStream::name)
+        .def_property("max_bytes", &NotificationStream::max_bytes, &NotificationStream::set_max_bytes)
+        // The record list is converted after the GIL is re-acquired, once per batch.
+        .def("next_batch", &NotificationStream::next_batch,
+            py::arg("max_items") = 100,
+            py::arg("timeout_ms") = 10,
+            py::call_guard<py::gil_scoped_release>())
+        .def("next_batch_async", [](
+            std::shared_ptr<NotificationStream>& self,
+            int max_items,
+            int timeout_ms
+        ) {
+            return wrap_future([&]() { return self->next_batch_async(max_items, timeout_ms); });
+        }, py::arg("max_items") = 100, py::arg("timeout_ms") = 10)
+        .def("pending_count", &NotificationStream::pending_count)
+        .def("pending_bytes", &NotificationStream::pending_bytes)
+        .def("published_count", &NotificationStream::published_count)
+        .def("dropped_count", &NotificationStream::dropped_count)
+        .def("clear", &NotificationStream::clear,
+            py::call_guard<py::gil_scoped_release>());
+
+    m.def("notification_stream", [](const std::string& name, std::int64_t max_bytes) {
+        return NotificationStream::get(name, max_bytes);
+    }, py::arg("name") = "default", py::arg("max_bytes") = -1,
+    "Get or create a process-wide merged notification stream."
+    );
+
     // Bind NetconfClient with shared_ptr for proper lifetime management.
     py::class_<NetconfClient, std::shared_ptr<NetconfClient>>(m, "NetconfClient")
         .def(py::init([](const std::string &hostname,
@@ -471,26 +956,32 @@ PYBIND11_MODULE(pyNetX, m) {
         // Synchronous methods
         // Deprecated synchronous flow methods.
         // These remain available in 2.0.5 for compatibility, but pyNetX is
-        // moving toward an async-focused API.
+        // moving toward an async-focused API. They run on the calling thread
+        // with the GIL released.
         .def("connect_sync", [](NetconfClient& self) {
             warn_sync_api_deprecated("connect_sync");
+            py::gil_scoped_release release;
             return self.connect_sync();
         })
         .def("disconnect_sync", [](NetconfClient& self) {
             warn_sync_api_deprecated("disconnect_sync");
+            py::gil_scoped_release release;
             return self.disconnect_sync();
         })
         .def("delete_subscription", &NetconfClient::delete_notification_session)
         .def("send_rpc_sync", [](NetconfClient& self, const std::string& rpc) {
             warn_sync_api_deprecated("send_rpc_sync");
+            py::gil_scoped_release release;
             return self.send_rpc_sync(rpc);
         }, py::arg("rpc"))
         .def("receive_notification_sync", [](NetconfClient& self) {
             warn_sync_api_deprecated("receive_notification_sync");
+            py::gil_scoped_release release;
             return self.receive_notification_sync();
         })
         .def("get_sync", [](NetconfClient& self, const std::string& filter) {
             warn_sync_api_deprecated("get_sync");
+            py::gil_scoped_release release;
             return self.get_sync(filter);
         }, py::arg("filter") = "")
         .def("get_config_sync", [](
@@ -499,6 +990,7 @@ PYBIND11_MODULE(pyNetX, m) {
             const std::string& filter
         ) {
             warn_sync_api_deprecated("get_config_sync");
+            py::gil_scoped_release release;
             return self.get_config_sync(source, filter);
         }, py::arg("source") = "running", py::arg("filter") = "")
         .def("copy_config_sync", [](
@@ -507,14 +999,17 @@ PYBIND11_MODULE(pyNetX, m) {
             const std::string& source
         ) {
             warn_sync_api_deprecated("copy_config_sync");
+            py::gil_scoped_release release;
             return self.copy_config_sync(target, source);
         }, py::arg("target"), py::arg("source"))
         .def("delete_config_sync", [](NetconfClient& self, const std::string& target) {
             warn_sync_api_deprecated("delete_config_sync");
+            py::gil_scoped_release release;
             return self.delete_config_sync(target);
         }, py::arg("target"))
         .def("validate_sync", [](NetconfClient& self, const std::string& source) {
             warn_sync_api_deprecated("validate_sync");
+            py::gil_scoped_release release;
             return self.validate_sync(source);
         }, py::arg("source") = "running")
         .def("edit_config_sync", [](
@@ -524,6 +1019,7 @@ PYBIND11_MODULE(pyNetX, m) {
             bool do_validate
         ) {
             warn_sync_api_deprecated("edit_config_sync");
+            py::gil_scoped_release release;
             return self.edit_config_sync(target, config, do_validate);
         }, py::arg("target"), py::arg("config"), py::arg("do_validate") = false)
         .def("subscribe_sync", [](
@@ -532,18 +1028,22 @@ PYBIND11_MODULE(pyNetX, m) {
             const std::string& filter
         ) {
             warn_sync_api_deprecated("subscribe_sync");
+            py::gil_scoped_release release;
             return self.subscribe_sync(stream, filter);
         }, py::arg("stream") = "NETCONF", py::arg("filter") = "")
         .def("lock_sync", [](NetconfClient& self, const std::string& target) {
             warn_sync_api_deprecated("lock_sync");
+            py::gil_scoped_release release;
             return self.lock_sync(target);
         }, py::arg("target") = "running")
         .def("unlock_sync", [](NetconfClient& self, const std::string& target) {
             warn_sync_api_deprecated("unlock_sync");
+            py::gil_scoped_release release;
             return self.unlock_sync(target);
         }, py::arg("target") = "running")
         .def("commit_sync", [](NetconfClient& self) {
             warn_sync_api_deprecated("commit_sync");
+            py::gil_scoped_release release;
             return self.commit_sync();
         })
         .def("locked_edit_config_sync", [](
@@ -553,18 +1053,26 @@ PYBIND11_MODULE(pyNetX, m) {
             bool do_validate
         ) {
             warn_sync_api_deprecated("locked_edit_config_sync");
+            py::gil_scoped_release release;
             return self.locked_edit_config_sync(target, config, do_validate);
         }, py::arg("target"), py::arg("config"), py::arg("do_validate") = false)
         // Asynchronous methods
-        .def("connect_async", [](std::shared_ptr<NetconfClient> &self) {
-            return wrap_future(self->connect_async());
-        })
-        .def("disconnect_async", [](std::shared_ptr<NetconfClient> &self) {
-            return wrap_future(self->disconnect_async());
-        })
-        .def("send_rpc_async", [](std::shared_ptr<NetconfClient> &self, const std::string &rpc) {
-            return wrap_future(self->send_rpc_async(rpc));
-        }, py::arg("rpc"))
+        .def("connect_async", [](std::shared_ptr<NetconfClient> &self,
+                                 const std::string &priority) {
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->connect_async(lane); });
+        }, py::arg("priority") = "normal")
+        .def("disconnect_async", [](std::shared_ptr<NetconfClient> &self,
+                                    const std::string &priority) {
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->disconnect_async(lane); });
+        }, py::arg("priority") = "normal")
+        .def("send_rpc_async", [](std::shared_ptr<NetconfClient> &self,
+                                  const std::string &rpc,
+                                  const std::string &priority) {
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->send_rpc_async(rpc, lane); });
+        }, py::arg("rpc"), py::arg("priority") = "normal")
         .def("next_notification", &NetconfClient::next_notification,
             py::arg("timeout_ms") = 10,
             py::call_guard<py::gil_scoped_release>())
@@ -572,8 +1080,29 @@ PYBIND11_MODULE(pyNetX, m) {
             std::shared_ptr<NetconfClient> &self,
             int timeout_ms
         ) {
-            return wrap_future(self->next_notification_async(timeout_ms));
+            return wrap_future([&]() { return self->next_notification_async(timeout_ms); });
         }, py::arg("timeout_ms") = 10)
+        // The list is converted after the GIL is re-acquired, once per batch.
+        .def("next_notifications", &NetconfClient::next_notifications,
+            py::arg("max_items") = 100,
+            py::arg("timeout_ms") = 10,
+            py::call_guard<py::gil_scoped_release>())
+        .def("next_notifications_async", [](
+            std::shared_ptr<NetconfClient> &self,
+            int max_items,
+            int timeout_ms
+        ) {
+            return wrap_future([&]() { return self->next_notifications_async(max_items, timeout_ms); });
+        }, py::arg("max_items") = 100, py::arg("timeout_ms") = 10)
+        .def("notifications", [](std::shared_ptr<NetconfClient>& self, int max_batch) {
+            if (max_batch <= 0) {
+                throw NetconfException("max_batch must be greater than 0");
+            }
+            return std::make_shared<NotificationAsyncIterator>(
+                self,
+                static_cast<std::size_t>(max_batch)
+            );
+        }, py::arg("max_batch") = 100)
         .def("peek_notifications", [](NetconfClient& self, int max_items) {
             py::gil_scoped_release release;
             return self.peek_notifications(max_items);
@@ -582,55 +1111,115 @@ PYBIND11_MODULE(pyNetX, m) {
             py::gil_scoped_release release;
             return self.notification_queue_size();
         })
+        .def("attach_notification_stream", &NetconfClient::attach_notification_stream,
+            py::arg("stream"),
+            "Publish this client's notifications into stream instead of its own queue. "
+            "While attached, next_notification(s), their async variants and "
+            "notifications() raise NetconfException, and pending async waits fail.")
+        .def("detach_notification_stream", &NetconfClient::detach_notification_stream,
+            "Stop publishing into the attached stream; notifications go back to the "
+            "client's own queue.")
         .def("is_subscription_active", &NetconfClient::is_subscription_active)
-        .def("get_async", [](std::shared_ptr<NetconfClient> &self, const std::string &filter) {
-            return wrap_future(self->get_async(filter));
-        }, py::arg("filter") = "")
+        .def("rpc_stats", [](NetconfClient& self) {
+            RpcStatsSnapshot stats;
+            {
+                py::gil_scoped_release release;
+                stats = self.rpc_stats();
+            }
+            return rpc_stats_to_dict(stats);
+        })
+        .def("reset_rpc_stats", &NetconfClient::reset_rpc_stats,
+            py::call_guard<py::gil_scoped_release>())
+        .def("last_connect", [](NetconfClient& self) {
+            ConnectTrace rpc;
+            ConnectTrace notification;
+            {
+                py::gil_scoped_release release;
+                rpc = self.last_connect(false);
+                notification = self.last_connect(true);
+            }
+            auto to_object = [](const ConnectTrace& trace) -> py::object {
+                if (!trace.done) {
+                    return py::none();
+                }
+                return connect_trace_to_dict(trace);
+            };
+            py::dict doc;
+            doc["rpc"] = to_object(rpc);
+            doc["notification"] = to_object(notification);
+            return doc;
+        })
+        .def("get_async", [](std::shared_ptr<NetconfClient> &self,
+                             const std::string &filter,
+                             const std::string &priority) {
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->get_async(filter, lane); });
+        }, py::arg("filter") = "", py::arg("priority") = "normal")
         .def("get_config_async", [](std::shared_ptr<NetconfClient> &self,
                                     const std::string &source,
-                                    const std::string &filter){
-            return wrap_future(self->get_config_async(source, filter));
-        }, py::arg("source") = "running", py::arg("filter") = "")
+                                    const std::string &filter,
+                                    const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->get_config_async(source, filter, lane); });
+        }, py::arg("source") = "running", py::arg("filter") = "", py::arg("priority") = "normal")
         .def("copy_config_async", [](std::shared_ptr<NetconfClient> &self,
                                      const std::string &target,
-                                     const std::string &source){
-            return wrap_future(self->copy_config_async(target, source));
-        })
+                                     const std::string &source,
+                                     const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->copy_config_async(target, source, lane); });
+        }, py::arg("target"), py::arg("source"), py::arg("priority") = "normal")
         .def("delete_config_async", [](std::shared_ptr<NetconfClient> &self,
-                                       const std::string &target){
-            return wrap_future(self->delete_config_async(target));
-        })
+                                       const std::string &target,
+                                       const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->delete_config_async(target, lane); });
+        }, py::arg("target"), py::arg("priority") = "normal")
         .def("validate_async", [](std::shared_ptr<NetconfClient> &self,
-                                  const std::string &source){
-            return wrap_future(self->validate_async(source));
-        }, py::arg("source") = "running")
+                                  const std::string &source,
+                                  const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->validate_async(source, lane); });
+        }, py::arg("source") = "running", py::arg("priority") = "normal")
         .def("edit_config_async", [](std::shared_ptr<NetconfClient> &self,
                                      const std::string &target,
                                      const std::string &config,
-                                     bool do_validate){
-            return wrap_future(self->edit_config_async(target, config, do_validate));
-        }, py::arg("target"), py::arg("config"), py::arg("do_validate") = false)
+                                     bool do_validate,
+                                     const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->edit_config_async(target, config, do_validate, lane); });
+        }, py::arg("target"), py::arg("config"), py::arg("do_validate") = false, py::arg("priority") = "normal")
         .def("subscribe_async", [](std::shared_ptr<NetconfClient> &self,
                                    const std::string &stream,
-                                   const std::string &filter){
-            return wrap_future(self->subscribe_async(stream, filter));
-        }, py::arg("stream") = "NETCONF", py::arg("filter") = "")
+                                   const std::string &filter,
+                                   const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->subscribe_async(stream, filter, lane); });
+        }, py::arg("stream") = "NETCONF", py::arg("filter") = "", py::arg("priority") = "normal")
         .def("lock_async", [](std::shared_ptr<NetconfClient> &self,
-                              const std::string &target){
-            return wrap_future(self->lock_async(target));
-        }, py::arg("target") = "running")
+                              const std::string &target,
+                              const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->lock_async(target, lane); });
+        }, py::arg("target") = "running", py::arg("priority") = "normal")
         .def("unlock_async", [](std::shared_ptr<NetconfClient> &self,
-                                const std::string &target){
-            return wrap_future(self->unlock_async(target));
-        }, py::arg("target") = "running")
-        .def("commit_async", [](std::shared_ptr<NetconfClient> &self){
-            return wrap_future(self->commit_async());
-        })
+                                const std::string &target,
+                                const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->unlock_async(target, lane); });
+        }, py::arg("target") = "running", py::arg("priority") = "normal")
+        .def("commit_async", [](std::shared_ptr<NetconfClient> &self,
+                                const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->commit_async(lane); });
+        }, py::arg("priority") = "normal")
         .def("locked_edit_config_async", [](std::shared_ptr<NetconfClient> &self,
                                             const std::string &target,
                                             const std::string &config,
-                                            bool do_validate){
-            return wrap_future(self->locked_edit_config_async(target, config, do_validate));
-        }, py::arg("target"), py::arg("config"), py::arg("do_validate") = false)
+                                            bool do_validate,
+                                            const std::string &priority){
+            const TaskPriority lane = task_priority_from_string(priority);
+            return wrap_future([&]() { return self->locked_edit_config_async(target, config, do_validate, lane); });
+        }, py::arg("target"), py::arg("config"), py::arg("do_validate") = false, py::arg("priority") = "normal")
     ;
 }
@@ -0,0 +1,183 @@
+#include "channel_capture.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+std::atomic<bool> ChannelCapture::enabled_{false};
+
+namespace {
+    constexpr char MAGIC[8] = {'P', 'N', 'X', 'C', 'A', 'P', '0', '1'};
+    constexpr std::size_t HEADER_SIZE = 20;
+    constexpr std::size_t FILE_BUFFER_SIZE = 1 << 20;
+
+    struct Writer {
+        std::mutex mtx;
+        std::FILE* file = nullptr;
+        std::vector<char> buffer;
+        std::chrono::steady_clock::time_point started;
+        ChannelCapture::Totals totals;
+        bool exit_hook = false;
+    };
+
+    Writer& writer() {
+        // Leaked so reads during static destruction find a valid lock.
+        static Writer* instance = new Writer();
+        return *instance;
+    }
+
+    template <typename T>
+    void put(char*& out, T value) {
+        std::memcpy(out, &value, sizeof(value));
+        out += sizeof(value);
+    }
+
+    template <typename T>
+    T get(const char*& in) {
+        T value;
+        std::memcpy(&value, in, sizeof(value));
+        in += sizeof(value);
+        return value;
+    }
+
+    void close_locked(Writer& w) noexcept {
+        if (w.file) {
+            std::fclose(w.file);
+            w.file = nullptr;
+        }
+    }
+}
+
+void ChannelCapture::start(const std::string& path) {
+    Writer& w = writer();
+    std::lock_guard<std::mutex> lock(w.mtx);
+    enabled_.store(false, std::memory_order_relaxed);
+    close_locked(w);
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot open capture file " + path + ": " + std::strerror(errno));
+    }
+    w.buffer.resize(FILE_BUFFER_SIZE);
+    std::setvbuf(file, w.buffer.data(), _IOFBF, w.buffer.size());
+    if (std::fwrite(MAGIC, 1, sizeof(MAGIC), file) != sizeof(MAGIC)) {
+        std::fclose(file);
+        throw std::runtime_error("cannot write capture file " + path);
+    }
+
+    if (!w.exit_hook) {
+        // Flush the stdio buffer if the process exits mid-capture.
+        std::atexit([] { ChannelCapture::stop(); });
+        w.exit_hook = true;
+    }
+
+    w.file = file;
+    w.started = std::chrono::steady_clock::now();
+    w.totals = Totals{};
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+ChannelCapture::Totals ChannelCapture::stop() noexcept {
+    Writer& w = writer();
+    std::lock_guard<std::mutex> lock(w.mtx);
+    enabled_.store(false, std::memory_order_relaxed);
+    close_locked(w);
+    return w.totals;
+}
+
+void ChannelCapture::record(Channel channel, const std::string& label, int fd,
+                            const char* data, std::size_t size) noexcept {
+    if (size == 0) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const std::size_t label_size = std::min<std::size_t>(label.size(), UINT16_MAX);
+
+    Writer& w = writer();
+    std::lock_guard<std::mutex> lock(w.mtx);
+    if (!w.file) {
+        return;
+    }
+
+    char header[HEADER_SIZE];
+    char* out = header;
+    put<std::uint64_t>(out, static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - w.started).count()));
+    put<std::uint8_t>(out, static_cast<std::uint8_t>(channel));
+    put<std::uint8_t>(out, 0);
+    put<std::uint16_t>(out, static_cast<std::uint16_t>(label_size));
+    put<std::int32_t>(out, fd);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(size));
+
+    const bool ok =
+        std::fwrite(header, 1, sizeof(header), w.file) == sizeof(header) &&
+        std::fwrite(label.data(), 1, label_size, w.file) == label_size &&
+        std::fwrite(data, 1, size, w.file) == size;
+    if (!ok) {
+        // Disk full or similar; a torn file is worse than a short one.
+        enabled_.store(false, std::memory_order_relaxed);
+        close_locked(w);
+        return;
+    }
+    ++w.totals.records;
+    w.totals.bytes += size;
+}
+
+void ChannelCapture::record_rpc(const char* data, std::size_t size) noexcept {
+    const Scope* scope = current();
+    if (scope) {
+        record(Channel::Rpc, scope->label_, scope->fd_, data, size);
+    }
+}
+
+// ----------------------- CaptureReader -------------------------
+
+CaptureReader::CaptureReader(const std::string& path)
+    : file_(std::fopen(path.c_str(), "rb"))
+{
+    if (!file_) {
+        throw std::runtime_error("cannot open capture file " + path + ": " + std::strerror(errno));
+    }
+    char magic[sizeof(MAGIC)];
+    if (std::fread(magic, 1, sizeof(magic), file_) != sizeof(magic) ||
+        std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::fclose(file_);
+        throw std::runtime_error(path + " is not a pyNetX capture file");
+    }
+}
+
+CaptureReader::~CaptureReader() {
+    std::fclose(file_);
+}
+
+bool CaptureReader::next(CaptureRecord& out) {
+    char header[HEADER_SIZE];
+    const std::size_t got = std::fread(header, 1, sizeof(header), file_);
+    if (got == 0) {
+        return false;
+    }
+    if (got != sizeof(header)) {
+        throw std::runtime_error("capture file ends inside a record header");
+    }
+
+    const char* in = header;
+    out.nanos = static_cast<std::int64_t>(get<std::uint64_t>(in));
+    out.channel = static_cast<ChannelCapture::Channel>(get<std::uint8_t>(in));
+    get<std::uint8_t>(in);
+    const std::uint16_t label_size = get<std::uint16_t>(in);
+    out.fd = get<std::int32_t>(in);
+    const std::uint32_t data_size = get<std::uint32_t>(in);
+
+    out.label.resize(label_size);
+    out.data.resize(data_size);
+    if (std::fread(&out.label[0], 1, label_size, file_) != label_size ||
+        std::fread(&out.data[0], 1, data_size, file_) != data_size) {
+        throw std::runtime_error("capture file ends inside a record");
+    }
+    return true;
+}
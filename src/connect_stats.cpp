@@ -0,0 +1,169 @@
+#include "connect_stats.hpp"
+#include "usdt_probes.hpp"
+
+#include <algorithm>
+
+constexpr std::size_t ConnectStats::SLOWEST_KEPT;
+constexpr std::size_t ConnectStats::RECENT_FAILURES_KEPT;
+
+namespace {
+    bool slower(const ConnectRecord& a, const ConnectRecord& b) {
+        return a.trace.total_nanos() > b.trace.total_nanos();
+    }
+}
+
+const char* connect_phase_name(ConnectPhase phase) {
+    switch (phase) {
+        case ConnectPhase::Dns: return "dns";
+        case ConnectPhase::Tcp: return "tcp";
+        case ConnectPhase::Handshake: return "handshake";
+        case ConnectPhase::Auth: return "auth";
+        case ConnectPhase::Channel: return "channel";
+        case ConnectPhase::Subsystem: return "subsystem";
+        case ConnectPhase::Hello: return "hello";
+    }
+    return "unknown";
+}
+
+const char* connect_failure_name(ConnectFailure failure) {
+    switch (failure) {
+        case ConnectFailure::None: return "none";
+        case ConnectFailure::Timeout: return "timeout";
+        case ConnectFailure::Refused: return "refused";
+        case ConnectFailure::Rejected: return "rejected";
+        case ConnectFailure::Error: return "error";
+    }
+    return "unknown";
+}
+
+// ----------------------- ConnectTrace -------------------------
+
+ConnectTrace::ConnectTrace(bool notification_session, std::chrono::milliseconds budget)
+    : notification_session(notification_session),
+      started(Clock::now()),
+      phase_started_(started),
+      phase_budget_(budget)
+{
+    phase_nanos.fill(-1);
+}
+
+void ConnectTrace::close_phase(Clock::time_point now) {
+    phase_nanos[static_cast<std::size_t>(phase)] =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - phase_started_).count();
+}
+
+void ConnectTrace::enter(ConnectPhase next, std::chrono::milliseconds budget) {
+    const auto now = Clock::now();
+    close_phase(now);
+    PYNETX_PROBE4(connect__phase, label.c_str(), notification_session ? 1 : 0,
+                  connect_phase_name(next), phase_nanos[static_cast<std::size_t>(phase)]);
+    phase = next;
+    phase_started_ = now;
+    phase_budget_ = budget;
+}
+
+void ConnectTrace::succeed() {
+    finished = Clock::now();
+    close_phase(finished);
+    done = true;
+}
+
+void ConnectTrace::fail(const std::string& error) {
+    finished = Clock::now();
+    done = true;
+    failed = true;
+    message = error;
+    if (failure == ConnectFailure::None) {
+        // A non-positive budget, such as an infinite read_timeout, is no
+        // budget at all.
+        failure = phase_budget_.count() > 0 && finished - phase_started_ >= phase_budget_
+            ? ConnectFailure::Timeout
+            : ConnectFailure::Error;
+    }
+}
+
+std::int64_t ConnectTrace::total_nanos() const noexcept {
+    if (!done) {
+        return -1;
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count();
+}
+
+// ----------------------- ConnectStats -------------------------
+
+ConnectStats& ConnectStats::instance() {
+    static ConnectStats stats;
+    return stats;
+}
+
+void ConnectStats::record(
+    const std::string& label,
+    const std::string& hostname,
+    int port,
+    const ConnectTrace& trace
+) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++attempts_;
+
+    for (std::size_t i = 0; i < CONNECT_PHASE_COUNT; ++i) {
+        if (trace.phase_nanos[i] >= 0) {
+            phases_[i].record(static_cast<std::uint64_t>(trace.phase_nanos[i]));
+        }
+    }
+
+    if (trace.failed) {
+        ++failed_;
+        ++failures_[static_cast<std::size_t>(trace.phase)][static_cast<std::size_t>(trace.failure)];
+        recent_failures_.push_back(ConnectRecord{label, hostname, port, trace});
+        if (recent_failures_.size() > RECENT_FAILURES_KEPT) {
+            recent_failures_.pop_front();
+        }
+    } else {
+        ++succeeded_;
+        total_.record(static_cast<std::uint64_t>(std::max<std::int64_t>(0, trace.total_nanos())));
+    }
+
+    // Keep the SLOWEST_KEPT slowest attempts; slowest_.front() is the fastest
+    // of them.
+    if (slowest_.size() < SLOWEST_KEPT) {
+        slowest_.push_back(ConnectRecord{label, hostname, port, trace});
+        std::push_heap(slowest_.begin(), slowest_.end(), slower);
+    } else if (trace.total_nanos() > slowest_.front().trace.total_nanos()) {
+        std::pop_heap(slowest_.begin(), slowest_.end(), slower);
+        slowest_.back() = ConnectRecord{label, hostname, port, trace};
+        std::push_heap(slowest_.begin(), slowest_.end(), slower);
+    }
+}
+
+ConnectStatsSnapshot ConnectStats::snapshot() const {
+    ConnectStatsSnapshot out;
+    std::lock_guard<std::mutex> lock(mtx_);
+    out.attempts = attempts_;
+    out.succeeded = succeeded_;
+    out.failed = failed_;
+    for (std::size_t i = 0; i < CONNECT_PHASE_COUNT; ++i) {
+        out.phases[i] = summarize_latency(phases_[i]);
+    }
+    out.total = summarize_latency(total_);
+    out.failures = failures_;
+    out.slowest = slowest_;
+    std::sort(out.slowest.begin(), out.slowest.end(), slower);
+    out.recent_failures.assign(recent_failures_.begin(), recent_failures_.end());
+    return out;
+}
+
+void ConnectStats::reset() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    attempts_ = 0;
+    succeeded_ = 0;
+    failed_ = 0;
+    for (auto& h : phases_) {
+        h.clear();
+    }
+    total_.clear();
+    for (auto& row : failures_) {
+        row.fill(0);
+    }
+    slowest_.clear();
+    recent_failures_.clear();
+}
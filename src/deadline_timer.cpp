@@ -0,0 +1,86 @@
+#include "deadline_timer.hpp"
+#include "logger.hpp"
+
+
+DeadlineTimer& DeadlineTimer::instance() {
+    // Intentionally leaked: waiters may still be registered while the
+    // interpreter shuts down.
+    static DeadlineTimer* timer = new DeadlineTimer();
+    return *timer;
+}
+
+DeadlineTimer::DeadlineTimer()
+    : thread_([this] { run(); })
+{
+    thread_.detach();
+}
+
+DeadlineTimer::Handle DeadlineTimer::schedule(Clock::time_point deadline, Callback callback) {
+    Handle handle;
+    bool earliest = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        handle.deadline = deadline;
+        handle.id = next_id_++;
+        auto it = timers_.emplace(Key(deadline, handle.id), std::move(callback)).first;
+        earliest = it == timers_.begin();
+    }
+
+    if (earliest) {
+        cv_.notify_one();
+    }
+    return handle;
+}
+
+bool DeadlineTimer::cancel(const Handle& handle) {
+    if (handle.id == 0) {
+        return false;
+    }
+
+    Callback discarded;
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto it = timers_.find(Key(handle.deadline, handle.id));
+    if (it == timers_.end()) {
+        return false;
+    }
+    // The callback is destroyed after the lock is released. If the timer
+    // thread was sleeping on this deadline it recomputes it on next wakeup.
+    discarded = std::move(it->second);
+    timers_.erase(it);
+    return true;
+}
+
+std::size_t DeadlineTimer::pending() const {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return timers_.size();
+}
+
+void DeadlineTimer::run() {
+    std::unique_lock<std::mutex> lk(mtx_);
+    for (;;) {
+        if (timers_.empty()) {
+            cv_.wait(lk);
+            continue;
+        }
+
+        auto it = timers_.begin();
+        if (Clock::now() < it->first.first) {
+            cv_.wait_until(lk, it->first.first);
+            continue;
+        }
+
+        Callback callback = std::move(it->second);
+        timers_.erase(it);
+
+        lk.unlock();
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            NETX_LOG(LogLevel::Error, "DeadlineTimer callback threw: " << e.what());
+        } catch (...) {
+            NETX_LOG(LogLevel::Error, "DeadlineTimer callback threw unknown exception");
+        }
+        callback = nullptr;
+        lk.lock();
+    }
+}
@@ -0,0 +1,87 @@
+#include "event_fd_signal.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+EventFdSignal::~EventFdSignal() {
+    const int fd = fd_.load(std::memory_order_relaxed);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+int EventFdSignal::fd() {
+    int fd = fd_.load(std::memory_order_acquire);
+    if (fd >= 0) {
+        return fd;
+    }
+
+    std::lock_guard<std::mutex> lk(open_mtx_);
+
+    fd = fd_.load(std::memory_order_relaxed);
+    if (fd >= 0) {
+        return fd;
+    }
+
+    fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(
+            std::string("eventfd failed: ") + std::strerror(errno)
+        );
+    }
+
+    fd_.store(fd, std::memory_order_release);
+    return fd;
+}
+
+void EventFdSignal::arm() noexcept {
+    armed_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void EventFdSignal::notify(bool force) noexcept {
+    if (force) {
+        armed_.store(false, std::memory_order_relaxed);
+        write_one();
+        return;
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!armed_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (!armed_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    write_one();
+}
+
+void EventFdSignal::drain() noexcept {
+    const int fd = fd_.load(std::memory_order_acquire);
+    if (fd < 0) {
+        return;
+    }
+
+    std::uint64_t value = 0;
+    while (::read(fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+    }
+}
+
+void EventFdSignal::write_one() noexcept {
+    const int fd = fd_.load(std::memory_order_acquire);
+    if (fd < 0) {
+        return;
+    }
+
+    // EAGAIN only happens when the counter is saturated, which still reads as
+    // readable, so there is nothing to retry.
+    const std::uint64_t one = 1;
+    while (::write(fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
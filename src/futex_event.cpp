@@ -0,0 +1,47 @@
+#include "futex_event.hpp"
+
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+    static_assert(
+        sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+        "futex word must be a plain 32-bit integer"
+    );
+
+    std::uint32_t* futex_word(std::atomic<std::uint32_t>& word) {
+        return reinterpret_cast<std::uint32_t*>(&word);
+    }
+}
+
+void FutexEvent::park(std::uint32_t seq, std::chrono::nanoseconds timeout) noexcept {
+    struct timespec ts{};
+    struct timespec* ts_ptr = nullptr;
+
+    if (timeout.count() >= 0) {
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000LL);
+        ts_ptr = &ts;
+    }
+
+    // EAGAIN (word changed), EINTR and ETIMEDOUT all mean "re-check".
+    syscall(SYS_futex, futex_word(seq_), FUTEX_WAIT_PRIVATE, seq, ts_ptr, nullptr, 0);
+}
+
+void FutexEvent::notify_one() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    seq_.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, futex_word(seq_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void FutexEvent::notify_all() noexcept {
+    seq_.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, futex_word(seq_), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
@@ -0,0 +1,98 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr int LatencyHistogram::SUB_BUCKET_BITS;
+constexpr int LatencyHistogram::UNIT_SHIFT;
+constexpr std::size_t LatencyHistogram::BUCKET_COUNT;
+
+namespace {
+    constexpr std::uint64_t SUB_BUCKETS = 1u << LatencyHistogram::SUB_BUCKET_BITS;
+
+    int highest_bit(std::uint64_t v) noexcept {
+        return 63 - __builtin_clzll(v);
+    }
+}
+
+std::size_t LatencyHistogram::bucket_for(std::uint64_t nanos) noexcept {
+    const std::uint64_t units = nanos >> UNIT_SHIFT;
+    if (units < SUB_BUCKETS) {
+        return static_cast<std::size_t>(units);
+    }
+    const int msb = highest_bit(units);
+    const std::uint64_t sub = (units >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    const std::size_t bucket = static_cast<std::size_t>(
+        SUB_BUCKETS + static_cast<std::uint64_t>(msb - SUB_BUCKET_BITS) * SUB_BUCKETS + sub
+    );
+    return std::min(bucket, BUCKET_COUNT - 1);
+}
+
+std::uint64_t LatencyHistogram::bucket_upper_bound(std::size_t bucket) noexcept {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<std::uint64_t>(bucket + 1) << UNIT_SHIFT;
+    }
+    const std::size_t octave = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    const std::uint64_t sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+    return ((SUB_BUCKETS + sub + 1) << octave) << UNIT_SHIFT;
+}
+
+void LatencyHistogram::record(std::uint64_t nanos) noexcept {
+    ++counts_[bucket_for(nanos)];
+    ++count_;
+    sum_ += nanos;
+    max_ = std::max(max_, nanos);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::clear() noexcept {
+    counts_.fill(0);
+    count_ = 0;
+    sum_ = 0;
+    max_ = 0;
+}
+
+double LatencyHistogram::mean() const noexcept {
+    return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+}
+
+std::uint64_t LatencyHistogram::value_at_quantile(double q) const noexcept {
+    if (count_ == 0) {
+        return 0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    const std::uint64_t rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_)))
+    );
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(i), max_);
+        }
+    }
+    return max_;
+}
+
+LatencySummary summarize_latency(const LatencyHistogram& histogram) {
+    auto to_us = [](std::uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+
+    LatencySummary summary;
+    summary.count = histogram.count();
+    summary.mean_us = histogram.mean() / 1000.0;
+    summary.p50_us = to_us(histogram.value_at_quantile(0.50));
+    summary.p90_us = to_us(histogram.value_at_quantile(0.90));
+    summary.p99_us = to_us(histogram.value_at_quantile(0.99));
+    summary.p999_us = to_us(histogram.value_at_quantile(0.999));
+    summary.max_us = to_us(histogram.max());
+    return summary;
+}
@@ -0,0 +1,297 @@
+#include "logger.hpp"
+#include "futex_event.hpp"
+#include "metrics_registry.hpp"
+
+#include <time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+constexpr std::uint32_t Logger::DEFAULT_RATE_LIMIT;
+std::atomic<int> Logger::level_{static_cast<int>(LogLevel::Info)};
+std::atomic<std::uint32_t> Logger::rate_limit_{Logger::DEFAULT_RATE_LIMIT};
+
+namespace {
+    constexpr std::size_t RING_SIZE = 1024;  // power of two
+    constexpr std::size_t TEXT_SIZE = 240;
+    constexpr std::int64_t WINDOW_NANOS = 1000000000LL;
+    constexpr std::int64_t EXIT_FLUSH_MS = 200;
+
+    std::int64_t steady_nanos() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct Slot {
+        std::atomic<std::size_t> seq{0};
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point when;
+        std::uint64_t suppressed = 0;
+        std::size_t length = 0;
+        char text[TEXT_SIZE];
+    };
+
+    // Bounded multi-producer ring (Vyukov): a slot's seq says whether it is
+    // free for the producer claiming position pos (seq == pos) or holds a
+    // message for the consumer (seq == pos + 1). The writer thread is the
+    // only consumer.
+    struct State {
+        Slot slots[RING_SIZE];
+        std::atomic<std::size_t> head{0};  // next position to claim
+        std::size_t tail = 0;              // next position to write; writer only
+
+        std::atomic<std::uint64_t> enqueued{0};
+        std::atomic<std::uint64_t> written{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> suppressed{0};
+        std::atomic<bool> exiting{false};
+
+        FutexEvent ready;    // writer parks here
+        FutexEvent drained;  // flush() parks here
+
+        std::mutex sink_mtx;
+        Logger::Sink sink;
+
+        std::shared_ptr<MetricCounter> dropped_metric;
+        std::shared_ptr<MetricCounter> suppressed_metric;
+
+        State() {
+            for (std::size_t i = 0; i < RING_SIZE; ++i) {
+                slots[i].seq.store(i, std::memory_order_relaxed);
+            }
+            dropped_metric = MetricsRegistry::instance().counter(
+                "pynetx_log_messages_dropped",
+                "Log messages dropped because the log ring was full", {});
+            suppressed_metric = MetricsRegistry::instance().counter(
+                "pynetx_log_messages_suppressed",
+                "Log messages held back by the per-site rate limit", {});
+
+            std::thread(&State::run, this).detach();
+            std::atexit([] { exit_flush(); });
+        }
+
+        bool has_message() const noexcept {
+            const Slot& slot = slots[tail & (RING_SIZE - 1)];
+            return slot.seq.load(std::memory_order_acquire) == tail + 1;
+        }
+
+        bool push(LogLevel level, std::uint64_t suppressed_before, const std::string& message) noexcept {
+            std::size_t pos = head.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;) {
+                slot = &slots[pos & (RING_SIZE - 1)];
+                const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+                const std::intptr_t diff =
+                    static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;  // full
+                } else {
+                    pos = head.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->level = level;
+            slot->when = std::chrono::system_clock::now();
+            slot->suppressed = suppressed_before;
+            if (message.size() < TEXT_SIZE) {
+                slot->length = message.size();
+                std::memcpy(slot->text, message.data(), message.size());
+            } else {
+                slot->length = TEXT_SIZE;
+                std::memcpy(slot->text, message.data(), TEXT_SIZE - 3);
+                std::memcpy(slot->text + TEXT_SIZE - 3, "...", 3);
+            }
+            slot->seq.store(pos + 1, std::memory_order_release);
+
+            enqueued.fetch_add(1, std::memory_order_relaxed);
+            ready.notify_one();
+            return true;
+        }
+
+        void run() {
+            for (;;) {
+                ready.wait([this] { return has_message(); });
+
+                std::uint64_t n = 0;
+                while (has_message()) {
+                    Slot& slot = slots[tail & (RING_SIZE - 1)];
+                    std::string text(slot.text, slot.length);
+                    if (slot.suppressed > 0) {
+                        text += " (" + std::to_string(slot.suppressed) +
+                                " similar messages suppressed)";
+                    }
+                    const LogLevel level = slot.level;
+                    const auto when = slot.when;
+                    slot.seq.store(tail + RING_SIZE, std::memory_order_release);
+                    ++tail;
+
+                    deliver(level, when, text);
+                    ++n;
+                }
+
+                written.fetch_add(n, std::memory_order_release);
+                drained.notify_all();
+            }
+        }
+
+        void deliver(LogLevel level,
+                     std::chrono::system_clock::time_point when,
+                     const std::string& text) noexcept {
+            try {
+                std::lock_guard<std::mutex> lock(sink_mtx);
+                if (sink) {
+                    sink(level, text);
+                    return;
+                }
+            } catch (...) {
+                // A failing handler must not stop the writer; fall back to stderr.
+            }
+            write_stderr(level, when, text);
+        }
+
+        static void write_stderr(LogLevel level,
+                                 std::chrono::system_clock::time_point when,
+                                 const std::string& text) noexcept {
+            const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                when.time_since_epoch()).count();
+            const time_t secs = static_cast<time_t>(millis / 1000);
+            struct tm utc{};
+            gmtime_r(&secs, &utc);
+
+            char prefix[64];
+            const std::size_t stamp = std::strftime(prefix, sizeof(prefix), "%Y-%m-%dT%H:%M:%S", &utc);
+            std::snprintf(prefix + stamp, sizeof(prefix) - stamp, ".%03dZ pyNetX %s: ",
+                          static_cast<int>(millis % 1000), log_level_name(level));
+
+            std::string line = prefix;
+            line += text;
+            line += '\n';
+
+            std::size_t off = 0;
+            while (off < line.size()) {
+                const ssize_t n = ::write(STDERR_FILENO, line.data() + off, line.size() - off);
+                if (n <= 0) {
+                    return;
+                }
+                off += static_cast<std::size_t>(n);
+            }
+        }
+
+        static void exit_flush() noexcept;
+    };
+
+    State& state() {
+        // Leaked: reactors and pool workers can log during static destruction.
+        static State* instance = new State();
+        return *instance;
+    }
+
+    void State::exit_flush() noexcept {
+        Logger::flush(EXIT_FLUSH_MS);
+        // From here on, write synchronously: the writer thread may not get
+        // scheduled again before the process ends.
+        state().exiting.store(true, std::memory_order_release);
+    }
+}
+
+const char* log_level_name(LogLevel level) noexcept {
+    switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error: return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+bool LogSite::admit(std::int64_t now_nanos, std::uint32_t limit) noexcept {
+    std::int64_t start = window_start_.load(std::memory_order_relaxed);
+    if (now_nanos - start >= WINDOW_NANOS &&
+        window_start_.compare_exchange_strong(start, now_nanos, std::memory_order_relaxed)) {
+        in_window_.store(0, std::memory_order_relaxed);
+    }
+    if (in_window_.fetch_add(1, std::memory_order_relaxed) < limit) {
+        return true;
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::set_level(LogLevel level) noexcept {
+    level_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::set_rate_limit(std::uint32_t per_site_per_second) noexcept {
+    rate_limit_.store(per_site_per_second, std::memory_order_relaxed);
+}
+
+void Logger::set_sink(Sink sink) {
+    State& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.sink_mtx);
+        s.sink.swap(sink);
+    }
+    // The previous sink is destroyed here, outside sink_mtx.
+}
+
+bool Logger::flush(std::int64_t timeout_ms) {
+    State& s = state();
+    const std::uint64_t target = s.enqueued.load(std::memory_order_relaxed);
+    return s.drained.wait_until(
+        [&s, target] { return s.written.load(std::memory_order_acquire) >= target; },
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms));
+}
+
+LogStats Logger::stats() noexcept {
+    State& s = state();
+    LogStats out;
+    out.written = s.written.load(std::memory_order_relaxed);
+    out.dropped = s.dropped.load(std::memory_order_relaxed);
+    out.suppressed = s.suppressed.load(std::memory_order_relaxed);
+    out.level = static_cast<LogLevel>(level_.load(std::memory_order_relaxed));
+    out.rate_limit = rate_limit();
+    return out;
+}
+
+bool Logger::admit(LogSite& site) noexcept {
+    const std::uint32_t limit = rate_limit();
+    if (limit == 0 || site.admit(steady_nanos(), limit)) {
+        return true;
+    }
+    State& s = state();
+    s.suppressed.fetch_add(1, std::memory_order_relaxed);
+    s.suppressed_metric->inc();
+    return false;
+}
+
+void Logger::write(LogLevel level, LogSite& site, const std::string& message) noexcept {
+    State& s = state();
+    const std::uint64_t suppressed = site.take_suppressed();
+
+    if (s.exiting.load(std::memory_order_acquire)) {
+        try {
+            std::string text = message;
+            if (suppressed > 0) {
+                text += " (" + std::to_string(suppressed) + " similar messages suppressed)";
+            }
+            State::write_stderr(level, std::chrono::system_clock::now(), text);
+        } catch (...) {
+        }
+        return;
+    }
+
+    if (!s.push(level, suppressed, message)) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        s.dropped_metric->inc();
+    }
+}
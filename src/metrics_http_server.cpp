@@ -0,0 +1,189 @@
+#include "metrics_http_server.hpp"
+#include "metrics_registry.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr std::size_t MAX_REQUEST_BYTES = 8192;
+    constexpr int CLIENT_IO_TIMEOUT_SEC = 2;
+
+    const char* const CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+    void send_all(int fd, const std::string& data) {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+    }
+
+    std::string response(const char* status, const char* content_type, const std::string& body) {
+        std::string out = "HTTP/1.1 ";
+        out += status;
+        out += "\r\nContent-Type: ";
+        out += content_type;
+        out += "\r\nContent-Length: " + std::to_string(body.size());
+        out += "\r\nConnection: close\r\n\r\n";
+        out += body;
+        return out;
+    }
+}
+
+MetricsHttpServer& MetricsHttpServer::instance() {
+    static MetricsHttpServer server;
+    return server;
+}
+
+MetricsHttpServer::~MetricsHttpServer() {
+    stop();
+}
+
+int MetricsHttpServer::start(int port) {
+    if (port < 0 || port > 65535) {
+        throw std::runtime_error("metrics port must be between 0 and 65535");
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (thread_.joinable()) {
+        return port_;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("metrics server: socket failed: " + std::string(strerror(errno)));
+    }
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, 16) < 0) {
+        const std::string err = strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("metrics server: cannot listen on 127.0.0.1:" +
+                                 std::to_string(port) + ": " + err);
+    }
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr), &len);
+
+    const int stop_fd = stop_signal_.fd();
+    stop_signal_.drain();
+
+    listen_fd_ = fd;
+    port_ = ntohs(addr.sin_port);
+    thread_ = std::thread(&MetricsHttpServer::serve, this, fd, stop_fd);
+    return port_;
+}
+
+void MetricsHttpServer::stop() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!thread_.joinable()) {
+        return;
+    }
+    stop_signal_.notify(true);
+    thread_.join();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    port_ = 0;
+}
+
+int MetricsHttpServer::port() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return port_;
+}
+
+void MetricsHttpServer::serve(int listen_fd, int stop_fd) {
+    struct pollfd fds[2] = {
+        {listen_fd, POLLIN, 0},
+        {stop_fd, POLLIN, 0},
+    };
+
+    for (;;) {
+        int rc = ::poll(fds, 2, -1);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents) {
+            return;
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+
+        int client = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        try {
+            handle(client);
+        } catch (...) {
+            // One bad scrape must not take the endpoint down.
+        }
+        ::close(client);
+    }
+}
+
+void MetricsHttpServer::handle(int client_fd) {
+    struct timeval timeout{};
+    timeout.tv_sec = CLIENT_IO_TIMEOUT_SEC;
+    ::setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buf[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t n = ::recv(client_fd, buf, sizeof(buf), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        request.append(buf, static_cast<std::size_t>(n));
+    }
+
+    const std::string line = request.substr(0, request.find("\r\n"));
+    const std::size_t path_start = line.find(' ');
+    const std::size_t path_end = line.find(' ', path_start == std::string::npos ? 0 : path_start + 1);
+    const std::string method = line.substr(0, path_start);
+    std::string path = path_start == std::string::npos
+        ? std::string()
+        : line.substr(path_start + 1, path_end - path_start - 1);
+    path = path.substr(0, path.find('?'));
+
+    if (method != "GET") {
+        send_all(client_fd, response("405 Method Not Allowed", "text/plain; charset=utf-8",
+                                     "only GET is supported\n"));
+        return;
+    }
+    if (path != "/metrics") {
+        send_all(client_fd, response("404 Not Found", "text/plain; charset=utf-8",
+                                     "try /metrics\n"));
+        return;
+    }
+    send_all(client_fd, response("200 OK", CONTENT_TYPE,
+                                 MetricsRegistry::instance().render_openmetrics()));
+}
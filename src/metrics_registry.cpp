@@ -0,0 +1,336 @@
+#include "metrics_registry.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+
+constexpr std::size_t MetricHistogram::BUCKET_COUNT;
+
+namespace {
+    constexpr std::uint64_t MICROS = 1000;
+    constexpr std::uint64_t MILLIS = 1000 * MICROS;
+    constexpr std::uint64_t SECONDS = 1000 * MILLIS;
+
+    constexpr std::uint64_t BOUNDS_NANOS[MetricHistogram::BUCKET_COUNT - 1] = {
+        100 * MICROS, 250 * MICROS, 500 * MICROS,
+        1 * MILLIS, 2500 * MICROS, 5 * MILLIS,
+        10 * MILLIS, 25 * MILLIS, 50 * MILLIS,
+        100 * MILLIS, 250 * MILLIS, 500 * MILLIS,
+        1 * SECONDS, 2500 * MILLIS, 5 * SECONDS, 10 * SECONDS,
+    };
+
+    const char* const BOUND_LABELS[MetricHistogram::BUCKET_COUNT] = {
+        "0.0001", "0.00025", "0.0005",
+        "0.001", "0.0025", "0.005",
+        "0.01", "0.025", "0.05",
+        "0.1", "0.25", "0.5",
+        "1.0", "2.5", "5.0", "10.0", "+Inf",
+    };
+
+    const char* type_name(MetricType type) {
+        switch (type) {
+            case MetricType::Counter: return "counter";
+            case MetricType::Gauge: return "gauge";
+            case MetricType::Histogram: return "histogram";
+        }
+        return "unknown";
+    }
+
+    void append_escaped(std::string& out, const std::string& value, bool quotes) {
+        for (char c : value) {
+            if (c == '\\') {
+                out += "\\\\";
+            } else if (c == '\n') {
+                out += "\\n";
+            } else if (quotes && c == '"') {
+                out += "\\\"";
+            } else {
+                out += c;
+            }
+        }
+    }
+
+    // {a="1",b="2"}, with an optional extra label appended (the histogram le).
+    void append_labels(std::string& out, const MetricLabels& labels,
+                       const char* extra_name = nullptr, const char* extra_value = nullptr) {
+        if (labels.empty() && !extra_name) {
+            return;
+        }
+        out += '{';
+        bool first = true;
+        for (const auto& label : labels) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            out += label.first;
+            out += "=\"";
+            append_escaped(out, label.second, true);
+            out += '"';
+        }
+        if (extra_name) {
+            if (!first) {
+                out += ',';
+            }
+            out += extra_name;
+            out += "=\"";
+            out += extra_value;
+            out += '"';
+        }
+        out += '}';
+    }
+
+    void append_sample(std::string& out, const std::string& name, const char* suffix,
+                       const MetricLabels& labels, const std::string& value,
+                       const char* extra_name = nullptr, const char* extra_value = nullptr) {
+        out += name;
+        out += suffix;
+        append_labels(out, labels, extra_name, extra_value);
+        out += ' ';
+        out += value;
+        out += '\n';
+    }
+
+    std::string format_double(double v) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.10g", v);
+        return buf;
+    }
+}
+
+// ----------------------- Metric types -------------------------
+
+void MetricGauge::raise(std::int64_t v) noexcept {
+    std::int64_t current = value_.load(std::memory_order_relaxed);
+    while (v > current &&
+           !value_.compare_exchange_weak(current, v, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t MetricHistogram::upper_bound_nanos(std::size_t bucket) noexcept {
+    return bucket < BUCKET_COUNT - 1 ? BOUNDS_NANOS[bucket] : 0;
+}
+
+const char* MetricHistogram::upper_bound_label(std::size_t bucket) noexcept {
+    return BOUND_LABELS[bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1];
+}
+
+void MetricHistogram::observe_nanos(std::uint64_t nanos) noexcept {
+    std::size_t i = 0;
+    while (i < BUCKET_COUNT - 1 && nanos > BOUNDS_NANOS[i]) {
+        ++i;
+    }
+    buckets_[i].fetch_add(1, std::memory_order_relaxed);
+    sum_nanos_.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+// ----------------------- MetricsRegistration -------------------------
+
+MetricsRegistration::MetricsRegistration(MetricsRegistration&& other) noexcept
+    : registry_(other.registry_),
+      name_(std::move(other.name_)),
+      labels_(std::move(other.labels_)),
+      id_(other.id_)
+{
+    other.registry_ = nullptr;
+}
+
+MetricsRegistration& MetricsRegistration::operator=(MetricsRegistration&& other) noexcept {
+    if (this != &other) {
+        reset();
+        registry_ = other.registry_;
+        name_ = std::move(other.name_);
+        labels_ = std::move(other.labels_);
+        id_ = other.id_;
+        other.registry_ = nullptr;
+    }
+    return *this;
+}
+
+void MetricsRegistration::reset() noexcept {
+    if (registry_) {
+        registry_->unregister(name_, labels_, id_);
+        registry_ = nullptr;
+    }
+}
+
+// ----------------------- MetricsRegistry -------------------------
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family_locked(
+    const std::string& name,
+    const std::string& help,
+    MetricType type
+) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        Family family;
+        family.type = type;
+        family.help = help;
+        it = families_.emplace(name, std::move(family)).first;
+    } else if (it->second.type != type) {
+        throw std::invalid_argument(
+            "metric " + name + " is already registered as a " + type_name(it->second.type)
+        );
+    }
+    return it->second;
+}
+
+std::shared_ptr<MetricCounter> MetricsRegistry::counter(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels
+) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Series& series = family_locked(name, help, MetricType::Counter).series[labels];
+    std::shared_ptr<MetricCounter> metric = series.counter.lock();
+    if (!metric) {
+        metric = std::make_shared<MetricCounter>();
+        series.counter = metric;
+    }
+    return metric;
+}
+
+std::shared_ptr<MetricGauge> MetricsRegistry::gauge(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels
+) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Series& series = family_locked(name, help, MetricType::Gauge).series[labels];
+    std::shared_ptr<MetricGauge> metric = series.gauge.lock();
+    if (!metric) {
+        metric = std::make_shared<MetricGauge>();
+        series.gauge = metric;
+    }
+    return metric;
+}
+
+std::shared_ptr<MetricHistogram> MetricsRegistry::histogram(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels
+) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Series& series = family_locked(name, help, MetricType::Histogram).series[labels];
+    std::shared_ptr<MetricHistogram> metric = series.histogram.lock();
+    if (!metric) {
+        metric = std::make_shared<MetricHistogram>();
+        series.histogram = metric;
+    }
+    return metric;
+}
+
+MetricsRegistration MetricsRegistry::collect(
+    MetricType type,
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels,
+    std::function<double()> read
+) {
+    if (type == MetricType::Histogram) {
+        throw std::invalid_argument("collect() takes a counter or a gauge");
+    }
+
+    MetricsRegistration registration;
+    std::lock_guard<std::mutex> lock(mtx_);
+    Series& series = family_locked(name, help, type).series[labels];
+    const std::uint64_t id = next_collector_id_++;
+    series.collectors.push_back(Collector{id, std::move(read)});
+
+    registration.registry_ = this;
+    registration.name_ = name;
+    registration.labels_ = labels;
+    registration.id_ = id;
+    return registration;
+}
+
+void MetricsRegistry::unregister(
+    const std::string& name,
+    const MetricLabels& labels,
+    std::uint64_t id
+) noexcept {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto family = families_.find(name);
+    if (family == families_.end()) {
+        return;
+    }
+    auto series = family->second.series.find(labels);
+    if (series == family->second.series.end()) {
+        return;
+    }
+    std::vector<Collector>& collectors = series->second.collectors;
+    for (auto it = collectors.begin(); it != collectors.end(); ++it) {
+        if (it->id == id) {
+            collectors.erase(it);
+            break;
+        }
+    }
+    // A series that still holds a shared metric is left for
+    // render_openmetrics() to drop once its owners are gone.
+    if (collectors.empty()) {
+        const Series& rest = series->second;
+        if (rest.counter.expired() && rest.gauge.expired() && rest.histogram.expired()) {
+            family->second.series.erase(series);
+        }
+    }
+}
+
+std::string MetricsRegistry::render_openmetrics() {
+    std::string out;
+    out.reserve(4096);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto& entry : families_) {
+        const std::string& name = entry.first;
+        Family& family = entry.second;
+
+        std::string samples;
+        for (auto it = family.series.begin(); it != family.series.end();) {
+            const MetricLabels& labels = it->first;
+            Series& series = it->second;
+
+            if (!series.collectors.empty()) {
+                double v = 0;
+                for (const Collector& collector : series.collectors) {
+                    v += collector.read();
+                }
+                append_sample(samples, name, family.type == MetricType::Counter ? "_total" : "",
+                              labels, format_double(v));
+            } else if (auto counter = series.counter.lock()) {
+                append_sample(samples, name, "_total", labels, std::to_string(counter->value()));
+            } else if (auto gauge = series.gauge.lock()) {
+                append_sample(samples, name, "", labels, std::to_string(gauge->value()));
+            } else if (auto histogram = series.histogram.lock()) {
+                std::uint64_t cumulative = 0;
+                for (std::size_t i = 0; i < MetricHistogram::BUCKET_COUNT; ++i) {
+                    cumulative += histogram->bucket(i);
+                    append_sample(samples, name, "_bucket", labels, std::to_string(cumulative),
+                                  "le", MetricHistogram::upper_bound_label(i));
+                }
+                append_sample(samples, name, "_count", labels, std::to_string(cumulative));
+                append_sample(samples, name, "_sum", labels,
+                              format_double(static_cast<double>(histogram->sum_nanos()) / 1e9));
+            } else {
+                // Owner is gone.
+                it = family.series.erase(it);
+                continue;
+            }
+            ++it;
+        }
+
+        if (samples.empty()) {
+            continue;
+        }
+        out += "# TYPE " + name + " " + type_name(family.type) + "\n";
+        out += "# HELP " + name + " ";
+        append_escaped(out, family.help, false);
+        out += '\n';
+        out += samples;
+    }
+    out += "# EOF\n";
+    return out;
+}
@@ -1,6 +1,6 @@
 #include "netconf_client.hpp"
-#include "thread_pool.hpp"
-#include "thread_pool_global.hpp"
+#include "notification_waiter.hpp"
+#include "strand.hpp"
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -8,210 +8,268 @@
 
 
 // ----------------------- Asynchronous Methods -----------------------
-std::future<bool> NetconfClient::connect_async() {
+std::future<bool> NetconfClient::connect_async(TaskPriority priority) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self]() -> bool {
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
+    return strand_->enqueue([self]() -> bool {
         return self->connect_non_blocking();
-    });
+    }, priority);
 }
 
-std::future<void> NetconfClient::disconnect_async() {
+std::future<void> NetconfClient::disconnect_async(TaskPriority priority) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self]() -> void {
+    return strand_->enqueue([self]() -> void {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         self->disconnect();
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::send_rpc_async(const std::string& rpc) {
+std::future<std::string> NetconfClient::send_rpc_async(
+    const std::string& rpc,
+    TaskPriority priority
+) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, rpc]() -> std::string {
+    return strand_->enqueue([self, rpc]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->send_rpc_non_blocking(rpc);
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::get_async(const std::string& filter) {
+std::future<std::string> NetconfClient::get_async(
+    const std::string& filter,
+    TaskPriority priority
+) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, filter]() -> std::string {
+    return strand_->enqueue([self, filter]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->get_non_blocking(filter);
-    });
+    }, priority);
 }
 
 std::future<std::string> NetconfClient::get_config_async(
     const std::string& source,
-    const std::string& filter
+    const std::string& filter,
+    TaskPriority priority
 ) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, source, filter]() -> std::string {
+    return strand_->enqueue([self, source, filter]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->get_config_non_blocking(source, filter);
-    });
+    }, priority);
 }
 
 std::future<std::string> NetconfClient::copy_config_async(
     const std::string& target,
-    const std::string& source
+    const std::string& source,
+    TaskPriority priority
 ) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, target, source]() -> std::string {
+    return strand_->enqueue([self, target, source]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->copy_config_non_blocking(target, source);
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::delete_config_async(const std::string& target) {
+std::future<std::string> NetconfClient::delete_config_async(
+    const std::string& target,
+    TaskPriority priority
+) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, target]() -> std::string {
+    return strand_->enqueue([self, target]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->delete_config_non_blocking(target);
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::validate_async(const std::string& source) {
+std::future<std::string> NetconfClient::validate_async(
+    const std::string& source,
+    TaskPriority priority
+) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, source]() -> std::string {
+    return strand_->enqueue([self, source]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->validate_non_blocking(source);
-    });
+    }, priority);
 }
 
 std::future<std::string> NetconfClient::edit_config_async(
     const std::string& target,
     const std::string& config,
-    bool do_validate
+    bool do_validate,
+    TaskPriority priority
 ) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, target, config, do_validate]() -> std::string {
+    return strand_->enqueue([self, target, config, do_validate]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->edit_config_non_blocking(target, config, do_validate);
-    });
+    }, priority);
 }
 
 std::future<std::string> NetconfClient::subscribe_async(
     const std::string& stream,
-    const std::string& filter
+    const std::string& filter,
+    TaskPriority priority
 ) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, stream, filter]() -> std::string {
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
+    return strand_->enqueue([self, stream, filter]() -> std::string {
         return self->subscribe_non_blocking(stream, filter);
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::lock_async(const std::string& target) {
+std::future<std::string> NetconfClient::lock_async(
+    const std::string& target,
+    TaskPriority priority
+) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, target]() -> std::string {
+    return strand_->enqueue([self, target]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->lock_non_blocking(target);
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::unlock_async(const std::string& target) {
+std::future<std::string> NetconfClient::unlock_async(
+    const std::string& target,
+    TaskPriority priority
+) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, target]() -> std::string {
+    return strand_->enqueue([self, target]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->unlock_non_blocking(target);
-    });
+    }, priority);
 }
 
-std::future<std::string> NetconfClient::commit_async() {
+std::future<std::string> NetconfClient::commit_async(TaskPriority priority) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self]() -> std::string {
+    return strand_->enqueue([self]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->commit_non_blocking();
-    });
+    }, priority);
 }
 
 std::future<std::string> NetconfClient::locked_edit_config_async(
     const std::string& target,
     const std::string& config,
-    bool do_validate
+    bool do_validate,
+    TaskPriority priority
 ) {
     auto self = shared_from_this();
-    return get_pool().enqueue([self, target, config, do_validate]() -> std::string {
+    return strand_->enqueue([self, target, config, do_validate]() -> std::string {
         if (!self->is_connected_) {
             throw NetconfException("Client already not connected");
         }
         if (self->is_blocking_) {
             throw NetconfException("Client is connected synchronously, call synchronous methods");
         }
-        std::unique_lock<std::mutex> lock(self->session_mutex_);
         return self->locked_edit_config_non_blocking(target, config, do_validate);
-    });
+    }, priority);
 }
 
+// Notification waits are registered continuations, not pool tasks: the
+// reactor completes them on enqueue and the DeadlineTimer on timeout.
 std::future<std::string> NetconfClient::next_notification_async(int timeout_ms) {
-    auto self = shared_from_this();
-    return get_pool().enqueue([self, timeout_ms]() -> std::string {
-        return self->next_notification(timeout_ms);
-    });
-}
\ No newline at end of file
+    auto waiter = std::make_shared<SingleNotificationWaiter>();
+    std::future<std::string> fut = waiter->future();
+
+    try {
+        require_active_notification_subscription();
+        require_no_notification_stream();
+
+        if (timeout_ms < 0) {
+            throw NetconfException("timeout_ms must be >= 0");
+        }
+    } catch (const std::exception& e) {
+        waiter->fail(std::make_exception_ptr(
+            NetconfException("Unable to read from queue: " + std::string(e.what()))
+        ));
+        return fut;
+    }
+
+    register_notification_waiter(waiter, timeout_ms);
+    return fut;
+}
+
+std::future<std::vector<std::string>> NetconfClient::next_notifications_async(
+    int max_items,
+    int timeout_ms
+) {
+    const std::size_t limit = max_items < 0
+        ? static_cast<std::size_t>(-1)
+        : static_cast<std::size_t>(max_items);
+    auto waiter = std::make_shared<BatchNotificationWaiter>(limit);
+    std::future<std::vector<std::string>> fut = waiter->future();
+
+    try {
+        require_active_notification_subscription();
+        require_no_notification_stream();
+
+        if (max_items < -1 || max_items == 0) {
+            throw NetconfException("max_items must be -1 for all items or greater than 0");
+        }
+
+        if (timeout_ms < 0) {
+            throw NetconfException("timeout_ms must be >= 0");
+        }
+    } catch (const std::exception& e) {
+        waiter->fail(std::make_exception_ptr(
+            NetconfException("Unable to read from queue: " + std::string(e.what()))
+        ));
+        return fut;
+    }
+
+    register_notification_waiter(waiter, timeout_ms);
+    return fut;
+}
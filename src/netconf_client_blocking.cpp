@@ -1,8 +1,11 @@
 #include "netconf_client.hpp"
+#include "channel_capture.hpp"
+#include "logger.hpp"
 #include "notification_reactor_manager.hpp"
 #include "notification_reactor.hpp"
+#include "usdt_probes.hpp"
+#include <algorithm>
 #include <stdexcept>
-#include <iostream>
 #include <future>
 #include <sstream>
 #include <libssh2.h>
@@ -18,6 +21,22 @@
 #include <poll.h>
 #include <unistd.h>
 
+namespace {
+    // Connect timeouts are measured from the start of the attempt, so each
+    // phase may use what is left of the overall budget. At least 1 ms, so a
+    // phase entered right at the deadline still counts as budgeted.
+    std::chrono::milliseconds remaining_budget(
+        std::chrono::seconds budget,
+        std::chrono::steady_clock::time_point start_time
+    ) {
+        return std::max(
+            std::chrono::milliseconds(1),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                budget - (std::chrono::steady_clock::now() - start_time))
+        );
+    }
+}
+
 void NetconfClient::disconnect() {
     try {
         // Clean up RPC session.
@@ -32,10 +51,10 @@ void NetconfClient::disconnect() {
         is_connected_ = false;
 
     } catch (const std::exception& e) {
-        std::cerr << "Error happened while removing netconf client object: "
-                  << e.what() << '\n';
+        NETX_LOG(LogLevel::Error, "Error happened while removing netconf client object: "
+                 << e.what());
     } catch (...) {
-        std::cerr << "Unknown error while removing netconf client object";
+        NETX_LOG(LogLevel::Error, "Unknown error while removing netconf client object");
     }
 }
 
@@ -52,20 +71,20 @@ void NetconfClient::delete_notification_session() {
             try {
                 NotificationReactorManager::instance().remove(fd);
             } catch (const std::exception& e) {
-                std::cerr << "Error removing notification FD from reactor: "
-                          << e.what() << '\n';
+                NETX_LOG(LogLevel::Error, "Error removing notification FD from reactor: "
+                         << e.what());
             } catch (...) {
-                std::cerr << "Unknown error removing notification FD from reactor\n";
+                NETX_LOG(LogLevel::Error, "Unknown error removing notification FD from reactor");
             }
         }
 
         mark_notification_dead();
 
     } catch (const std::exception& e) {
-        std::cerr << "Error happened while deleting notification session: "
-                  << e.what() << '\n';
+        NETX_LOG(LogLevel::Error, "Error happened while deleting notification session: "
+                 << e.what());
     } catch (...) {
-        std::cerr << "Unknown error while deleting notification session";
+        NETX_LOG(LogLevel::Error, "Unknown error while deleting notification session");
     }
 }
 
@@ -73,17 +92,20 @@ void NetconfClient::clear_notification_queue() {
     try {
         {
             std::lock_guard<std::mutex> lk(_notif_queue_mtx);
-            _notif_queue.clear();
             _notif_rx_buffer.clear();
+            _notif_rx_scan = NotificationScanState();
             _notif_rx_partial_timer_active = false;
-            _notif_queue_full_state = false;
-            _notif_queue_high_watermark = 0;
+            _notif_queue_full_state.store(false, std::memory_order_release);
+            _notif_queue_high_watermark.store(0, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+            _notif_queue.clear();
         }
-        _notif_queue_cv.notify_all();
     } catch (const std::exception& e) {
-        std::cerr << "Error happened while clearing notification queue: " << std::string(e.what()) << '\n';
+        NETX_LOG(LogLevel::Error, "Error happened while clearing notification queue: " << e.what());
     } catch (...) {
-        std::cerr << "Unknown error while clearing notification queue";
+        NETX_LOG(LogLevel::Error, "Unknown error while clearing notification queue");
     }
 }
 
@@ -95,6 +117,8 @@ bool NetconfClient::connect_blocking() {
     int rc = 0;
     auto connect_timeout = std::chrono::seconds(connect_timeout_);
     auto start_time = std::chrono::steady_clock::now();
+    ConnectTrace trace(false, connect_timeout);
+    trace.label = label_;
 
     try {
         // Initialize a libssh2 session and set it to blocking mode.
@@ -116,11 +140,13 @@ bool NetconfClient::connect_blocking() {
             }
         }
         if (std::chrono::steady_clock::now() - start_time > connect_timeout) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused("Connection timed out during hostname resolution");
         }
         resolved_host_ = resolved_ip;
 
         // Create and configure the socket.
+        trace.enter(ConnectPhase::Tcp, remaining_budget(connect_timeout, start_time));
         int raw_sock = socket(AF_INET, SOCK_STREAM, 0);
         if (raw_sock < 0) {
             throw NetconfException("Failed to create socket: " + std::string(strerror(errno)));
@@ -141,13 +167,18 @@ bool NetconfClient::connect_blocking() {
         // Connect (this call will block).
         rc = ::connect(socket_.get(), reinterpret_cast<struct sockaddr*>(&server_addr), sizeof(server_addr));
         if (rc < 0) {
+            if (errno == ECONNREFUSED) {
+                trace.mark_failure(ConnectFailure::Refused);
+            }
             throw NetconfConnectionRefused("Connection failed: " + std::string(strerror(errno)));
         }
         if (std::chrono::steady_clock::now() - start_time > connect_timeout) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused("Connection timed out during TCP connection");
         }
 
         // Perform the SSH handshake (blocking call).
+        trace.enter(ConnectPhase::Handshake, remaining_budget(connect_timeout, start_time));
         rc = libssh2_session_handshake(session_.get(), socket_.get());
         if (rc) {
             char* err_msg = nullptr;
@@ -156,22 +187,27 @@ bool NetconfClient::connect_blocking() {
                 std::string(err_msg ? err_msg : "Unknown error"));
         }
         if (std::chrono::steady_clock::now() - start_time > connect_timeout) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused("Connection timed out during SSH handshake");
         }
 
         // Authenticate with password (blocking call).
+        trace.enter(ConnectPhase::Auth, remaining_budget(connect_timeout, start_time));
         rc = libssh2_userauth_password(session_.get(), username_.c_str(), password_.c_str());
         if (rc) {
+            trace.mark_failure(ConnectFailure::Rejected);
             char* err_msg = nullptr;
             libssh2_session_last_error(session_.get(), &err_msg, nullptr, 0);
             throw NetconfAuthError("Authentication failed: " +
                 std::string(err_msg ? err_msg : "Unknown error"));
         }
         if (std::chrono::steady_clock::now() - start_time > connect_timeout) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused("Connection timed out during authentication");
         }
 
         // Open a channel for NETCONF.
+        trace.enter(ConnectPhase::Channel, remaining_budget(connect_timeout, start_time));
         LIBSSH2_CHANNEL* raw_channel = libssh2_channel_open_session(session_.get());
         if (!raw_channel) {
             throw NetconfChannelError("Failed to create channel for NETCONF");
@@ -179,6 +215,7 @@ bool NetconfClient::connect_blocking() {
         channel_.reset(raw_channel);
 
         // Request the NETCONF subsystem (blocking).
+        trace.enter(ConnectPhase::Subsystem, remaining_budget(connect_timeout, start_time));
         rc = libssh2_channel_process_startup(channel_.get(), "subsystem", 9, "netconf", strlen("netconf"));
         if (rc) {
             char* err_msg = nullptr;
@@ -187,10 +224,12 @@ bool NetconfClient::connect_blocking() {
                 std::string(err_msg ? err_msg : "Unknown error"));
         }
         if (std::chrono::steady_clock::now() - start_time > connect_timeout) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused("Connection timed out during subsystem startup");
         }
 
         // Complete the NETCONF hello exchange using the blocking read version.
+        trace.enter(ConnectPhase::Hello, std::chrono::seconds(read_timeout_));
         std::string server_hello = read_until_eom_blocking(
             channel_.get(),
             session_.get(),
@@ -203,8 +242,10 @@ bool NetconfClient::connect_blocking() {
         }
         is_blocking_ = true;
         is_connected_ = true;
+        finish_connect_trace(trace, nullptr);
         return true;
     } catch (const std::exception& err) {
+        finish_connect_trace(trace, err.what());
         // RAII wrappers will clean up resources automatically.
         throw NetconfConnectionRefused("Unable to connect to device: " + std::string(err.what()));
     }
@@ -215,6 +256,11 @@ bool NetconfClient::connect_notification_blocking() {
         throw NetconfException("Notification session already exists");
     }
 
+    const auto connect_timeout = std::chrono::seconds(connect_timeout_);
+    const auto start_time = std::chrono::steady_clock::now();
+    ConnectTrace trace(true, connect_timeout);
+    trace.label = label_;
+
     try {
         // 1. Create a new libssh2_session
         LIBSSH2_SESSION* raw_sess = libssh2_session_init();
@@ -231,6 +277,7 @@ bool NetconfClient::connect_notification_blocking() {
         }
 
         // 3. Create and connect a new socket
+        trace.enter(ConnectPhase::Tcp, remaining_budget(connect_timeout, start_time));
         int sock = socket(AF_INET, SOCK_STREAM, 0);
         if (sock < 0) {
             throw NetconfException("Failed to create socket for notification session: " + std::string(strerror(errno)));
@@ -244,10 +291,14 @@ bool NetconfClient::connect_notification_blocking() {
             throw NetconfConnectionRefused("Invalid IP address: " + resolved_ip);
         }
         if (::connect(notif_socket_.get(), reinterpret_cast<struct sockaddr*>(&server_addr), sizeof(server_addr)) < 0) {
+            if (errno == ECONNREFUSED) {
+                trace.mark_failure(ConnectFailure::Refused);
+            }
             throw NetconfConnectionRefused("Notification connect() failed: " + std::string(strerror(errno)));
         }
 
         // 4. SSH handshake
+        trace.enter(ConnectPhase::Handshake, remaining_budget(connect_timeout, start_time));
         int rc = libssh2_session_handshake(notif_session_.get(), notif_socket_.get());
         if (rc) {
             char* err = nullptr;
@@ -256,20 +307,24 @@ bool NetconfClient::connect_notification_blocking() {
         }
 
         // 5. Authenticate
+        trace.enter(ConnectPhase::Auth, remaining_budget(connect_timeout, start_time));
         rc = libssh2_userauth_password(notif_session_.get(), username_.c_str(), password_.c_str());
         if (rc) {
+            trace.mark_failure(ConnectFailure::Rejected);
             char* err = nullptr;
             libssh2_session_last_error(notif_session_.get(), &err, nullptr, 0);
             throw NetconfAuthError("Notification auth failed: " + std::string(err ? err : ""));
         }
 
         // 6. Open channel & request netconf subsystem
+        trace.enter(ConnectPhase::Channel, remaining_budget(connect_timeout, start_time));
         LIBSSH2_CHANNEL* raw_ch = libssh2_channel_open_session(notif_session_.get());
         if (!raw_ch) {
             throw NetconfChannelError("Failed to open notification channel");
         }
         notif_channel_.reset(raw_ch);
 
+        trace.enter(ConnectPhase::Subsystem, remaining_budget(connect_timeout, start_time));
         rc = libssh2_channel_process_startup(notif_channel_.get(), "subsystem", 9, "netconf", 7);
         if (rc) {
             char* err = nullptr;
@@ -278,6 +333,7 @@ bool NetconfClient::connect_notification_blocking() {
         }
 
         // 7. Exchange HELLO (blocking)
+        trace.enter(ConnectPhase::Hello, std::chrono::seconds(read_timeout_));
         std::string server_hello = read_until_eom_blocking(
             notif_channel_.get(),
             notif_session_.get(),
@@ -290,8 +346,10 @@ bool NetconfClient::connect_notification_blocking() {
         }
         notif_is_connected_ = true;
         notif_is_blocking_ = true;
+        finish_connect_trace(trace, nullptr);
         return true;
     } catch (const std::exception &ex) {
+        finish_connect_trace(trace, ex.what());
         notif_session_.reset();
         notif_channel_.reset();
         notif_socket_.reset();
@@ -300,7 +358,17 @@ bool NetconfClient::connect_notification_blocking() {
 }
 
 std::string NetconfClient::send_rpc_blocking(const std::string& rpc) {
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    RpcTrace trace = begin_rpc_trace();
+    PYNETX_PROBE3(rpc__start, label_.c_str(), socket_.get(), rpc.size());
+    ChannelCapture::Scope capture(label_, socket_.get());
+    try {
+        std::string reply = send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_, &trace);
+        finish_rpc_trace(trace, false, reply.size());
+        return reply;
+    } catch (...) {
+        finish_rpc_trace(trace, true);
+        throw;
+    }
 }
 
 std::string NetconfClient::receive_notification_blocking() {
@@ -337,7 +405,7 @@ std::string NetconfClient::get_blocking(const std::string& filter) {
         rpc += R"(<filter type="subtree">)" + filter + "</filter>";
     }
     rpc += R"(</get></rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::get_config_blocking(const std::string& source,
@@ -351,7 +419,7 @@ std::string NetconfClient::get_config_blocking(const std::string& source,
         rpc += R"(<filter type="subtree">)" + filter + "</filter>";
     }
     rpc += R"(</get-config></rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::copy_config_blocking(const std::string& target,
@@ -364,7 +432,7 @@ std::string NetconfClient::copy_config_blocking(const std::string& target,
         R"(<source><)" + source + R"(/></source>)"
         R"(</copy-config>)"
         R"(</rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::delete_config_blocking(const std::string& target) {
@@ -375,7 +443,7 @@ std::string NetconfClient::delete_config_blocking(const std::string& target) {
             R"(<target><)" + target + R"(/></target>)"
           R"(</delete-config>)"
         R"(</rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::validate_blocking(const std::string& source) {
@@ -386,7 +454,7 @@ std::string NetconfClient::validate_blocking(const std::string& source) {
             R"(<source><)" + source + R"(/></source>)"
           R"(</validate>)"
         R"(</rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::edit_config_blocking(const std::string& target,
@@ -400,7 +468,7 @@ std::string NetconfClient::edit_config_blocking(const std::string& target,
                 R"(<config>)" + config + R"(</config>)"
             R"(</edit-config>)"
         R"(</rpc>)";
-    std::string reply = send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    std::string reply = send_rpc_blocking(rpc);
     if (do_validate) {
         validate_blocking(target);
     }
@@ -440,7 +508,7 @@ std::string NetconfClient::lock_blocking(const std::string& target) {
             R"(<target><)" + target + R"(/></target>)"
           R"(</lock>)"
         R"(</rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::unlock_blocking(const std::string& target) {
@@ -451,7 +519,7 @@ std::string NetconfClient::unlock_blocking(const std::string& target) {
             R"(<target><)" + target + R"(/></target>)"
           R"(</unlock>)"
         R"(</rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::commit_blocking() {
@@ -460,7 +528,7 @@ std::string NetconfClient::commit_blocking() {
         R"(<rpc xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id="101">)"
           R"(<commit/>)"
         R"(</rpc>)";
-    return send_rpc_blocking_func(channel_.get(), session_.get(), rpc, read_timeout_);
+    return send_rpc_blocking(rpc);
 }
 
 std::string NetconfClient::locked_edit_config_blocking(const std::string& target,
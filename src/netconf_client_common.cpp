@@ -1,4 +1,7 @@
 #include "netconf_client.hpp"
+#include "strand.hpp"
+#include "trace_recorder.hpp"
+#include "usdt_probes.hpp"
 #include <stdexcept>
 #include <iostream>
 #include <libssh2.h>
@@ -20,6 +23,36 @@
 #endif
 
 
+namespace {
+    // Consecutive RpcTrace stamps bound the phases in RpcPhase order. The
+    // queueing phases passed before this thread picked the RPC up, so they go
+    // on an async track; the rest nest inside the pool task span.
+    void record_rpc_trace_spans(const RpcTrace& trace, const std::string& device) {
+        const RpcTrace::Clock::time_point stamps[] = {
+            trace.submitted, trace.scheduled, trace.started, trace.written,
+            trace.first_byte, trace.received, trace.finished,
+        };
+        const RpcTrace::Clock::time_point unset{};
+
+        if (trace.started != unset) {
+            TraceRecorder::record("rpc", "rpc", trace.started, trace.finished,
+                                  device.c_str(), "failed", trace.failed ? 1 : 0);
+        }
+        for (std::size_t i = 0; i + 1 < sizeof(stamps) / sizeof(stamps[0]); ++i) {
+            if (stamps[i] == unset || stamps[i + 1] == unset) {
+                continue;
+            }
+            const RpcPhase phase = static_cast<RpcPhase>(i);
+            const char* name = rpc_phase_name(phase);
+            if (phase == RpcPhase::StrandWait || phase == RpcPhase::PoolQueue) {
+                TraceRecorder::record_async("rpc", name, stamps[i], stamps[i + 1], device.c_str());
+            } else {
+                TraceRecorder::record("rpc", name, stamps[i], stamps[i + 1], device.c_str());
+            }
+        }
+    }
+}
+
 // ----------------------- NetconfClient Implementation -------------------------
 NetconfClient::NetconfClient(
     const std::string& hostname, int port,
@@ -37,7 +70,9 @@ NetconfClient::NetconfClient(
       socket_connect_timeout_(socket_connect_timeout),
       notif_incomplete_max_kb_(notif_incomplete_max_kb),
       notif_incomplete_timeout_(notif_incomplete_timeout),
-      notif_drop_event_threshold_(notif_drop_event_threshold)
+      notif_drop_event_threshold_(notif_drop_event_threshold),
+      strand_(std::make_shared<Strand>()),
+      _notif_queue(NotificationRing::capacity_for_queue_limit(notif_queue_size))
 {
     if (hostname_.empty()) {
         throw std::invalid_argument("hostname cannot be empty");
@@ -95,12 +130,129 @@ NetconfClient::NetconfClient(
             "notif_drop_event_threshold must be greater than 0"
         );
     }
+
+    register_metrics();
 }
 
 NetconfClient::~NetconfClient() {
+    metrics_registrations_.clear();
     try {
         disconnect();
     } catch(...) {
         // Suppress exceptions in destructor.
     }
 }
+
+// ----------------------- RPC phase stats -------------------------
+
+RpcTrace NetconfClient::begin_rpc_trace() {
+    RpcTrace trace;
+    Strand::TaskTiming timing;
+    if (Strand::takeTaskTiming(timing)) {
+        trace.submitted = timing.enqueued;
+        trace.scheduled = timing.scheduled;
+    }
+    trace.started = RpcTrace::Clock::now();
+    return trace;
+}
+
+void NetconfClient::finish_rpc_trace(RpcTrace& trace, bool failed, std::size_t reply_bytes) {
+    trace.finished = RpcTrace::Clock::now();
+    trace.failed = failed;
+    rpc_stats_.record(trace);
+
+    PYNETX_PROBE5(rpc__end, label_.c_str(), socket_.get(), reply_bytes, failed ? 1 : 0,
+                  trace.phase_nanos(RpcPhase::Total));
+
+    if (TraceRecorder::enabled()) {
+        record_rpc_trace_spans(trace, label_);
+    }
+
+    rpcs_metric_->inc();
+    if (failed) {
+        rpc_failures_metric_->inc();
+    }
+    const std::int64_t total = trace.phase_nanos(RpcPhase::Total);
+    if (total >= 0) {
+        rpc_duration_metric_->observe_nanos(static_cast<std::uint64_t>(total));
+    }
+}
+
+RpcStatsSnapshot NetconfClient::rpc_stats() const {
+    return rpc_stats_.snapshot();
+}
+
+void NetconfClient::reset_rpc_stats() {
+    rpc_stats_.reset();
+}
+
+// ----------------------- Metrics -------------------------
+
+void NetconfClient::register_metrics() {
+    MetricsRegistry& registry = MetricsRegistry::instance();
+    const MetricLabels labels = {
+        {"device", label_},
+        {"host", hostname_},
+        {"port", std::to_string(port_)},
+    };
+
+    rpcs_metric_ = registry.counter(
+        "pynetx_rpcs", "RPCs sent on the primary session", labels);
+    rpc_failures_metric_ = registry.counter(
+        "pynetx_rpc_failures", "RPCs that threw", labels);
+    rpc_duration_metric_ = registry.histogram(
+        "pynetx_rpc_duration_seconds", "RPC time from submission to reply checked", labels);
+
+    auto collect = [&](MetricType type, const char* name, const char* help,
+                       std::function<double()> read) {
+        metrics_registrations_.push_back(
+            registry.collect(type, name, help, labels, std::move(read)));
+    };
+    collect(MetricType::Counter, "pynetx_notifications_enqueued",
+            "Notifications queued or published to a stream", [this]() {
+        return static_cast<double>(_notif_enqueued_count.load(std::memory_order_relaxed));
+    });
+    collect(MetricType::Counter, "pynetx_notifications_dropped",
+            "Notifications dropped because the queue was full or the stream over budget", [this]() {
+        return static_cast<double>(_notif_dropped_queue_full_count.load(std::memory_order_relaxed));
+    });
+    collect(MetricType::Counter, "pynetx_notifications_incomplete",
+            "Partial notifications abandoned or timed out", [this]() {
+        return static_cast<double>(_notif_incomplete_count.load(std::memory_order_relaxed));
+    });
+    collect(MetricType::Gauge, "pynetx_notification_queue_depth",
+            "Notifications waiting in the client queue", [this]() {
+        return static_cast<double>(_notif_queue.size());
+    });
+    collect(MetricType::Gauge, "pynetx_notification_queue_high_watermark",
+            "Deepest the client queue has been since it was last cleared", [this]() {
+        return static_cast<double>(_notif_queue_high_watermark.load(std::memory_order_relaxed));
+    });
+}
+
+// ----------------------- Connect phase stats -------------------------
+
+void NetconfClient::finish_connect_trace(ConnectTrace& trace, const char* error) noexcept {
+    try {
+        if (error) {
+            trace.fail(error);
+        } else {
+            trace.succeed();
+        }
+        PYNETX_PROBE5(connect__end, label_.c_str(), trace.notification_session ? 1 : 0,
+                      trace.failed ? 1 : 0, connect_failure_name(trace.failure),
+                      trace.total_nanos());
+        {
+            std::lock_guard<std::mutex> lock(connect_trace_mutex_);
+            (trace.notification_session ? last_notif_connect_ : last_connect_) = trace;
+        }
+        ConnectStats::instance().record(label_, hostname_, port_, trace);
+    } catch (...) {
+        // Stats must never turn a connect into a failure.
+    }
+}
+
+ConnectTrace NetconfClient::last_connect(bool notification_session) const {
+    std::lock_guard<std::mutex> lock(connect_trace_mutex_);
+    return notification_session ? last_notif_connect_ : last_connect_;
+}
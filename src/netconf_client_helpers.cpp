@@ -1,6 +1,8 @@
 #include "netconf_client.hpp"
+#include "channel_capture.hpp"
+#include "netconf_framing.hpp"
+#include "logger.hpp"
 #include <stdexcept>
-#include <iostream>
 #include <future>
 #include <sstream>
 #include <libssh2.h>
@@ -130,7 +132,6 @@ std::string NetconfClient::resolve_hostname_non_blocking(
 // ----------------------- Polling Helpers -------------------------
 
 namespace {
-    constexpr const char* NETCONF_EOM = "]]>]]>";
     constexpr int MAX_EAGAIN_POLL_SLICE_MS = 1000;
 
     short libssh2_poll_events(LIBSSH2_SESSION* sess) {
@@ -246,7 +247,8 @@ std::string NetconfClient::read_until_eom_non_blocking(
     int soc_fd,
     int read_timeout,
     int notif_incomplete_max_kb,
-    int notif_incomplete_timeout
+    int notif_incomplete_timeout,
+    RpcTrace* trace
 ) {
     std::string response;
     char buffer[1024];
@@ -352,15 +354,25 @@ std::string NetconfClient::read_until_eom_non_blocking(
                 continue;
             }
 
+            if (ChannelCapture::enabled()) {
+                ChannelCapture::record_rpc(buffer, static_cast<std::size_t>(nbytes));
+            }
+
             if (!got_any_data) {
                 got_any_data = true;
                 first_data_time = std::chrono::steady_clock::now();
+                if (trace) {
+                    trace->first_byte = first_data_time;
+                }
             }
 
-            response.append(buffer, nbytes);
+            const bool complete = append_until_eom(response, buffer, nbytes);
             last_data_time = std::chrono::steady_clock::now();
 
-            if (response.find(NETCONF_EOM) != std::string::npos) {
+            if (complete) {
+                if (trace) {
+                    trace->received = last_data_time;
+                }
                 break;
             }
 
@@ -372,12 +384,11 @@ std::string NetconfClient::read_until_eom_non_blocking(
         }
 
         if (returning_incomplete) {
-            std::cerr
-                << "Received incomplete NETCONF notification. "
+            NETX_LOG(LogLevel::Warning,
+                "Received incomplete NETCONF notification. "
                 << "Returning partial notification after receiving "
                 << response.size()
-                << " bytes without NETCONF EOM."
-                << std::endl;
+                << " bytes without NETCONF EOM.");
         }
 
     } catch (const std::exception& e) {
@@ -393,10 +404,10 @@ std::string NetconfClient::read_until_eom_non_blocking(
 std::string NetconfClient::read_until_eom_blocking(
     LIBSSH2_CHANNEL *chan,
     LIBSSH2_SESSION *sess,
-    int read_timeout
+    int read_timeout,
+    RpcTrace* trace
 ) {
     std::string response;
-    std::string tail;
     auto last_data_time = std::chrono::steady_clock::now();
     
     // Determine whether we should ever timeout:
@@ -436,16 +447,16 @@ std::string NetconfClient::read_until_eom_blocking(
                 );
             }
             // nbytes > 0
-            response.append(buffer, nbytes);
-            std::string new_data(buffer, nbytes);
-
-            // keep last 7 chars from previous plus the new data to search for end-marker
-            if (response.size() >= 7) {
-                tail = response.substr(response.size() - 7);
-            } else {
-                tail = response;
+            if (ChannelCapture::enabled()) {
+                ChannelCapture::record_rpc(buffer, static_cast<std::size_t>(nbytes));
             }
-            if ((tail + new_data).find("]]>]]>") != std::string::npos) {
+            if (trace && response.empty()) {
+                trace->first_byte = std::chrono::steady_clock::now();
+            }
+            if (append_until_eom(response, buffer, nbytes)) {
+                if (trace) {
+                    trace->received = std::chrono::steady_clock::now();
+                }
                 break;
             }
 
@@ -532,7 +543,8 @@ std::string NetconfClient::send_rpc_blocking_func(
     LIBSSH2_CHANNEL *chan,
     LIBSSH2_SESSION *sess,
     const std::string& rpc,
-    int read_timeout
+    int read_timeout,
+    RpcTrace* trace
 ) {
     try {
         if (!chan) {
@@ -546,7 +558,10 @@ std::string NetconfClient::send_rpc_blocking_func(
             throw NetconfException("Failed to send RPC: " +
                                 std::string(err_msg ? err_msg : "Unknown error"));
         }
-        std::string reply = read_until_eom_blocking(chan, sess, read_timeout);
+        if (trace) {
+            trace->written = std::chrono::steady_clock::now();
+        }
+        std::string reply = read_until_eom_blocking(chan, sess, read_timeout, trace);
         check_for_rpc_error(reply);
         return reply;
     } catch (const std::exception& e) {
@@ -559,7 +574,8 @@ std::string NetconfClient::send_rpc_non_blocking_func(
     LIBSSH2_SESSION *sess,
     int soc_fd,
     const std::string& rpc,
-    int read_timeout
+    int read_timeout,
+    RpcTrace* trace
 ) {
         try {
             if (!chan) {
@@ -600,8 +616,11 @@ std::string NetconfClient::send_rpc_non_blocking_func(
                     total_written += rc;
                 }
             }
+            if (trace) {
+                trace->written = std::chrono::steady_clock::now();
+            }
             // Once the entire RPC message is written, read the reply.
-            std::string reply = read_until_eom_non_blocking(chan, sess, soc_fd, read_timeout);
+            std::string reply = read_until_eom_non_blocking(chan, sess, soc_fd, read_timeout, -1, -1, trace);
             check_for_rpc_error(reply);
             return reply;
         } catch (const std::exception& e) {
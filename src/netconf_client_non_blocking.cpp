@@ -1,8 +1,13 @@
 #include "netconf_client.hpp"
+#include "channel_capture.hpp"
+#include "netconf_framing.hpp"
+#include "logger.hpp"
 #include "notification_event_bus.hpp"
 #include "notification_reactor_manager.hpp"
+#include "notification_waiter.hpp"
+#include "trace_recorder.hpp"
+#include "usdt_probes.hpp"
 #include <stdexcept>
-#include <iostream>
 #include <future>
 #include <sstream>
 #include <libssh2.h>
@@ -20,160 +25,13 @@
 #include <errno.h>
 #include <algorithm>
 #include <cctype>
+#include <utility>
 
 namespace {
     constexpr const char* NETCONF_NOTIFICATION_EOM = "]]>]]>";
     constexpr std::size_t NETCONF_NOTIFICATION_EOM_LEN = 6;
     constexpr int NOTIFICATION_POLL_SLICE_MS = 1000;
 
-    std::string trim_copy(const std::string& input) {
-        auto begin = std::find_if_not(input.begin(), input.end(), [](unsigned char c) {
-            return std::isspace(c) != 0;
-        });
-        auto end = std::find_if_not(input.rbegin(), input.rend(), [](unsigned char c) {
-            return std::isspace(c) != 0;
-        }).base();
-
-        if (begin >= end) {
-            return std::string{};
-        }
-
-        return std::string(begin, end);
-    }
-
-    std::string xml_local_name(const char* name) {
-        if (!name) {
-            return std::string{};
-        }
-
-        std::string value(name);
-        const std::size_t colon = value.rfind(':');
-        if (colon != std::string::npos) {
-            return value.substr(colon + 1);
-        }
-        return value;
-    }
-
-    bool is_valid_notification_document(const std::string& frame_without_eom) {
-        const std::string payload = trim_copy(frame_without_eom);
-        if (payload.empty()) {
-            return false;
-        }
-
-        tinyxml2::XMLDocument doc;
-        const tinyxml2::XMLError parse_status = doc.Parse(payload.c_str(), payload.size());
-        if (parse_status != tinyxml2::XML_SUCCESS) {
-            return false;
-        }
-
-        tinyxml2::XMLElement* root = doc.RootElement();
-        if (!root) {
-            return false;
-        }
-
-        return xml_local_name(root->Name()) == "notification";
-    }
-
-    std::size_t find_notification_start_tag(
-        const std::string& data,
-        std::size_t from = 0
-    ) {
-        std::size_t pos = from;
-
-        while (true) {
-            pos = data.find('<', pos);
-            if (pos == std::string::npos) {
-                return std::string::npos;
-            }
-
-            if (pos + 1 >= data.size()) {
-                return std::string::npos;
-            }
-
-            const char next = data[pos + 1];
-            if (next == '/' || next == '!' || next == '?') {
-                ++pos;
-                continue;
-            }
-
-            std::size_t name_begin = pos + 1;
-            std::size_t name_end = name_begin;
-            while (name_end < data.size()) {
-                unsigned char c = static_cast<unsigned char>(data[name_end]);
-                if (std::isspace(c) || data[name_end] == '>' || data[name_end] == '/') {
-                    break;
-                }
-                ++name_end;
-            }
-
-            if (name_end == name_begin) {
-                ++pos;
-                continue;
-            }
-
-            std::string qname = data.substr(name_begin, name_end - name_begin);
-            const std::size_t colon = qname.rfind(':');
-            const std::string local =
-                colon == std::string::npos ? qname : qname.substr(colon + 1);
-
-            if (local == "notification") {
-                return pos;
-            }
-
-            pos = name_end;
-        }
-    }
-
-    bool benign_notification_prefix(const std::string& prefix) {
-        const std::string trimmed = trim_copy(prefix);
-        if (trimmed.empty()) {
-            return true;
-        }
-
-        if (trimmed.rfind("<?xml", 0) == 0) {
-            const std::size_t end_decl = trimmed.find("?>");
-            if (end_decl != std::string::npos) {
-                return trim_copy(trimmed.substr(end_decl + 2)).empty();
-            }
-        }
-
-        return false;
-    }
-
-    bool notification_end_after_start(
-        const std::string& data,
-        std::size_t start,
-        std::size_t& end_after
-    ) {
-        if (start == std::string::npos || start + 1 >= data.size()) {
-            return false;
-        }
-
-        std::size_t name_begin = start + 1;
-        std::size_t name_end = name_begin;
-        while (name_end < data.size()) {
-            unsigned char c = static_cast<unsigned char>(data[name_end]);
-            if (std::isspace(c) || data[name_end] == '>' || data[name_end] == '/') {
-                break;
-            }
-            ++name_end;
-        }
-
-        if (name_end == name_begin) {
-            return false;
-        }
-
-        const std::string qname = data.substr(name_begin, name_end - name_begin);
-        const std::string close_tag = "</" + qname + ">";
-        const std::size_t close_pos = data.find(close_tag, name_end);
-        if (close_pos == std::string::npos) {
-            return false;
-        }
-
-        end_after = close_pos + close_tag.size();
-        return true;
-    }
-
     std::string read_available_notification_bytes(
         LIBSSH2_CHANNEL* chan,
         LIBSSH2_SESSION* sess
@@ -264,6 +122,8 @@ bool NetconfClient::connect_non_blocking() {
     int socket_connect_timeout = socket_connect_timeout_ * 1000 ; // Convert to milliseconds for poll
     auto start_time = std::chrono::steady_clock::now();
     auto connect_timeout = std::chrono::seconds(user_given_timeout);
+    ConnectTrace trace(false, connect_timeout);
+    trace.label = label_;
     try {
         // Initialize a libssh2 session and store it in our RAII wrapper.
         LIBSSH2_SESSION* raw_session = libssh2_session_init();
@@ -283,6 +143,7 @@ bool NetconfClient::connect_non_blocking() {
                 ).count()
             );
             if (current_timeout <= 0) {
+                trace.mark_failure(ConnectFailure::Timeout);
                 throw NetconfConnectionRefused(
                     "Connection failed to " + hostname_ + " try increasing connection timeout"
                 );
@@ -299,11 +160,13 @@ bool NetconfClient::connect_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
         // Create and configure the socket.
+        trace.enter(ConnectPhase::Tcp, std::chrono::milliseconds(socket_connect_timeout));
         int raw_sock = socket(AF_INET, SOCK_STREAM, 0);
         if (raw_sock < 0) {
             throw NetconfException("Failed to create socket: " + std::string(strerror(errno)));
@@ -326,6 +189,9 @@ bool NetconfClient::connect_non_blocking() {
         }
         rc = ::connect(socket_.get(), reinterpret_cast<struct sockaddr*>(&server_addr), sizeof(server_addr));
         if (rc < 0 && errno != EINPROGRESS) {
+            if (errno == ECONNREFUSED) {
+                trace.mark_failure(ConnectFailure::Refused);
+            }
             throw NetconfConnectionRefused("Connection failed: " + std::string(strerror(errno)));
         }
         // Wait for TCP connection completion.
@@ -338,12 +204,18 @@ bool NetconfClient::connect_non_blocking() {
             socket_connect_timeout
         );
         if (poll_result <= 0) {
+            if (poll_result == 0) {
+                trace.mark_failure(ConnectFailure::Timeout);
+            }
             throw NetconfConnectionRefused(poll_result == 0 ?
                 "Unable to open socket for " + hostname_ + " " : "Poll error: " + std::string(strerror(errno)));
         }
         int error = 0;
         socklen_t len = sizeof(error);
         if (getsockopt(socket_.get(), SOL_SOCKET, SO_ERROR, &error, &len) < 0 || error != 0) {
+            if (error == ECONNREFUSED) {
+                trace.mark_failure(ConnectFailure::Refused);
+            }
             throw NetconfConnectionRefused("Connection failed: " +
                 std::string(error != 0 ? strerror(error) : strerror(errno)));
         }
@@ -360,10 +232,12 @@ bool NetconfClient::connect_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Handshake, std::chrono::seconds(current_timeout));
         auto handshake_start_time = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - handshake_start_time < std::chrono::seconds(current_timeout)) {
             int poll_result = poll(&session_pfd, 1, 100);
@@ -398,10 +272,12 @@ bool NetconfClient::connect_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Auth, std::chrono::seconds(current_timeout));
         auto auth_start_time = std::chrono::steady_clock::now();
         while (rc == LIBSSH2_ERROR_EAGAIN &&
                 std::chrono::steady_clock::now() - auth_start_time < std::chrono::seconds(current_timeout)) {
@@ -413,6 +289,9 @@ bool NetconfClient::connect_non_blocking() {
             rc = libssh2_userauth_password(session_.get(), username_.c_str(), password_.c_str());
         }
         if (rc) {
+            if (rc != LIBSSH2_ERROR_EAGAIN) {
+                trace.mark_failure(ConnectFailure::Rejected);
+            }
             char* err_msg = nullptr;
             libssh2_session_last_error(session_.get(), &err_msg, nullptr, 0);
             throw NetconfAuthError("Authentication failed: " +
@@ -424,10 +303,12 @@ bool NetconfClient::connect_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Channel, std::chrono::seconds(current_timeout));
         auto channel_start_time = std::chrono::steady_clock::now();
         LIBSSH2_CHANNEL* raw_channel = nullptr;
         while (std::chrono::steady_clock::now() - channel_start_time < std::chrono::seconds(current_timeout)) {
@@ -456,10 +337,12 @@ bool NetconfClient::connect_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Subsystem, std::chrono::seconds(current_timeout));
         auto subsystem_start_time = std::chrono::steady_clock::now();
         while (rc == LIBSSH2_ERROR_EAGAIN &&
                 std::chrono::steady_clock::now() - subsystem_start_time < std::chrono::seconds(current_timeout)) {
@@ -477,6 +360,7 @@ bool NetconfClient::connect_non_blocking() {
         }
 
         // Now complete the NETCONF hello exchange.
+        trace.enter(ConnectPhase::Hello, std::chrono::seconds(read_timeout_));
         std::string server_hello = read_until_eom_non_blocking(channel_.get(), session_.get(), socket_.get(), read_timeout_);
         if (server_hello.find("capabilities") != std::string::npos) {
             send_client_hello_non_blocking(channel_.get(), session_.get(), socket_.get());
@@ -485,8 +369,10 @@ bool NetconfClient::connect_non_blocking() {
         }
         is_connected_ = true;
         is_blocking_ = false;
+        finish_connect_trace(trace, nullptr);
         return true;
     } catch (const std::exception& err) {
+        finish_connect_trace(trace, err.what());
         // RAII wrappers ensure that session_, channel_, and socket_ are cleaned up automatically.
         throw NetconfConnectionRefused("Unable to connect to device: " + std::string(err.what()));
     }
@@ -503,6 +389,8 @@ bool NetconfClient::connect_notification_non_blocking() {
     int socket_connect_timeout= socket_connect_timeout_ * 1000; // Convert to milliseconds for poll
     auto start_time    = std::chrono::steady_clock::now();
     auto connect_deadline = std::chrono::seconds(user_given_timeout);
+    ConnectTrace trace(true, connect_deadline);
+    trace.label = label_;
 
     try {
         // ——— Initialize libssh2 session —————————————
@@ -522,6 +410,7 @@ bool NetconfClient::connect_notification_non_blocking() {
                 ).count()
             );
             if (current_timeout <= 0) {
+                trace.mark_failure(ConnectFailure::Timeout);
                 throw NetconfConnectionRefused("Connection timed out resolving " + hostname_);
             }
             resolved_host_ = resolve_hostname_non_blocking(hostname_, current_timeout);
@@ -531,6 +420,7 @@ bool NetconfClient::connect_notification_non_blocking() {
         }
 
         // ——— Create, configure, and make the socket non-blocking ——
+        trace.enter(ConnectPhase::Tcp, std::chrono::milliseconds(socket_connect_timeout));
         int raw_sock = socket(AF_INET, SOCK_STREAM, 0);
         if (raw_sock < 0) {
             throw NetconfException("Failed to create socket: " + std::string(strerror(errno)));
@@ -560,6 +450,9 @@ bool NetconfClient::connect_notification_non_blocking() {
                        reinterpret_cast<struct sockaddr*>(&server_addr),
                        sizeof(server_addr));
         if (rc < 0 && errno != EINPROGRESS) {
+            if (errno == ECONNREFUSED) {
+                trace.mark_failure(ConnectFailure::Refused);
+            }
             throw NetconfConnectionRefused("Connection failed: " + std::string(strerror(errno)));
         }
 
@@ -567,6 +460,9 @@ bool NetconfClient::connect_notification_non_blocking() {
         struct pollfd pfd{ notif_socket_.get(), POLLOUT, 0 };
         int poll_ret = poll(&pfd, 1, socket_connect_timeout);
         if (poll_ret <= 0) {
+            if (poll_ret == 0) {
+                trace.mark_failure(ConnectFailure::Timeout);
+            }
             throw NetconfConnectionRefused(
                 poll_ret == 0
                 ? "Timeout establishing TCP connection"
@@ -577,6 +473,9 @@ bool NetconfClient::connect_notification_non_blocking() {
         if (getsockopt(notif_socket_.get(), SOL_SOCKET, SO_ERROR, &so_error, &len) < 0
             || so_error != 0)
         {
+            if (so_error == ECONNREFUSED) {
+                trace.mark_failure(ConnectFailure::Refused);
+            }
             throw NetconfConnectionRefused(
                 "TCP connect failed: " +
                 std::string(so_error ? strerror(so_error) : strerror(errno))
@@ -595,10 +494,12 @@ bool NetconfClient::connect_notification_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Handshake, std::chrono::seconds(current_timeout));
         auto handshake_start_time = std::chrono::steady_clock::now();
         while (std::chrono::steady_clock::now() - handshake_start_time < std::chrono::seconds(current_timeout)) {
             int poll_result = poll(&session_pfd, 1, 100);
@@ -633,10 +534,12 @@ bool NetconfClient::connect_notification_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Auth, std::chrono::seconds(current_timeout));
         auto auth_start_time = std::chrono::steady_clock::now();
         while (rc == LIBSSH2_ERROR_EAGAIN &&
                 std::chrono::steady_clock::now() - auth_start_time < std::chrono::seconds(current_timeout)) {
@@ -648,6 +551,9 @@ bool NetconfClient::connect_notification_non_blocking() {
             rc = libssh2_userauth_password(notif_session_.get(), username_.c_str(), password_.c_str());
         }
         if (rc) {
+            if (rc != LIBSSH2_ERROR_EAGAIN) {
+                trace.mark_failure(ConnectFailure::Rejected);
+            }
             char* err_msg = nullptr;
             libssh2_session_last_error(notif_session_.get(), &err_msg, nullptr, 0);
             throw NetconfAuthError("Authentication failed: " +
@@ -659,10 +565,12 @@ bool NetconfClient::connect_notification_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Channel, std::chrono::seconds(current_timeout));
         auto channel_start_time = std::chrono::steady_clock::now();
         LIBSSH2_CHANNEL* raw_channel = nullptr;
         while (std::chrono::steady_clock::now() - channel_start_time < std::chrono::seconds(current_timeout)) {
@@ -691,10 +599,12 @@ bool NetconfClient::connect_notification_non_blocking() {
             ).count()
         );
         if (current_timeout <= 0) {
+            trace.mark_failure(ConnectFailure::Timeout);
             throw NetconfConnectionRefused(
                 "Connection failed to " + hostname_ + " try increasing connection timeout"
             );
         }
+        trace.enter(ConnectPhase::Subsystem, std::chrono::seconds(current_timeout));
         auto subsystem_start_time = std::chrono::steady_clock::now();
         while (rc == LIBSSH2_ERROR_EAGAIN &&
                 std::chrono::steady_clock::now() - subsystem_start_time < std::chrono::seconds(current_timeout)) {
@@ -712,6 +622,7 @@ bool NetconfClient::connect_notification_non_blocking() {
         }
 
         // Now complete the NETCONF hello exchange.
+        trace.enter(ConnectPhase::Hello, std::chrono::seconds(read_timeout_));
         std::string server_hello = read_until_eom_non_blocking(
             notif_channel_.get(),
             notif_session_.get(),
@@ -741,9 +652,11 @@ bool NetconfClient::connect_notification_non_blocking() {
         // <rpc-reply> before subscribe_non_blocking() reads it.
         notif_is_connected_ = false;
         notif_is_blocking_ = false;
+        finish_connect_trace(trace, nullptr);
         return true;
     }
     catch (const std::exception& e) {
+        finish_connect_trace(trace, e.what());
         throw NetconfConnectionRefused("Unable to connect to device: " + std::string(e.what()));
     }
 }
@@ -762,30 +675,84 @@ void NetconfClient::mark_notification_dead() noexcept {
         }
         {
             std::lock_guard<std::mutex> lk(_notif_queue_mtx);
-            _notif_queue.clear();
             _notif_rx_buffer.clear();
+            _notif_rx_scan = NotificationScanState();
             _notif_rx_partial_timer_active = false;
         }
-        _notif_queue_cv.notify_all();
+        {
+            // clear() wakes every parked consumer.
+            std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+            _notif_queue.clear();
+        }
     } catch (...) {
         // Never throw from cleanup called by reactor thread.
     }
 }
 
-void NetconfClient::on_notification_ready(int fd) {
+std::size_t NetconfClient::on_notification_ready(int fd) {
+    struct ChannelInput final : NotificationInput {
+        NetconfClient& client;
+        int fd;
+
+        ChannelInput(NetconfClient& c, int notification_fd) : client(c), fd(notification_fd) {}
+
+        std::string read() override {
+            std::lock_guard<std::mutex> guard(client.notif_mutex_);
+
+            if (!client.notif_channel_ || !client.notif_session_) {
+                throw NetconfException("Notification channel/session is not active");
+            }
+
+            if (client.notif_socket_.get() != fd) {
+                throw NetconfException("Notification FD does not match active subscription socket");
+            }
+
+            std::string bytes = read_available_notification_bytes(
+                client.notif_channel_.get(),
+                client.notif_session_.get()
+            );
+            if (ChannelCapture::enabled()) {
+                ChannelCapture::record(ChannelCapture::Channel::Notification, client.label_, fd,
+                                       bytes.data(), bytes.size());
+            }
+            return bytes;
+        }
+
+        int poll(int timeout_ms) override {
+            return poll_notification_fd(fd, timeout_ms);
+        }
+    } input(*this, fd);
+
+    return on_notification_input(fd, input);
+}
+
+std::size_t NetconfClient::on_notification_input(int fd, NotificationInput& input) {
     try {
         std::vector<NotificationHealthEvent> events_to_emit;
-        std::size_t queued_notifications = 0;
+        std::size_t bytes_read = 0;
+        // Set when a publish found next_batch_async() waiters on the stream.
+        std::shared_ptr<NotificationStream> stream_to_serve;
 
+        // Queued notifications wake parked consumers from NotificationRing::push;
+        // health events and registered async waiters are handled once the
+        // producer lock is released.
         auto flush_events_and_notifications = [&]() {
             for (auto& event : events_to_emit) {
                 NotificationEventBus::instance().emit(std::move(event));
             }
             events_to_emit.clear();
 
-            if (queued_notifications > 0) {
-                _notif_queue_cv.notify_all();
-                queued_notifications = 0;
+            if (stream_to_serve) {
+                std::shared_ptr<NotificationStream> stream = std::move(stream_to_serve);
+                stream_to_serve.reset();
+                stream->serve_waiters();
+            }
+
+            // Pairs with the fence in register_notification_waiter(): either
+            // we see the waiter, or it sees what we just pushed.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_notif_waiter_count.load(std::memory_order_relaxed) > 0) {
+                serve_notification_waiters();
             }
         };
 
@@ -796,7 +763,7 @@ void NetconfClient::on_notification_ready(int fd) {
             bool increment_incomplete_count
         ) {
             if (increment_incomplete_count) {
-                ++_notif_incomplete_count;
+                _notif_incomplete_count.fetch_add(1, std::memory_order_relaxed);
             }
 
             events_to_emit.push_back(
@@ -810,65 +777,131 @@ void NetconfClient::on_notification_ready(int fd) {
             );
         };
 
-        auto enqueue_or_drop_locked = [&](std::string notification,
-                                          std::int64_t diagnostic_bytes) {
-            if (notification.empty()) {
+        // Queue-full and stream-over-budget drops share one counter and one
+        // health event sequence: the first drop and every
+        // notif_drop_event_threshold_ drops after it are reported.
+        auto count_drop_locked = [&](std::size_t bytes,
+                                     std::int64_t diagnostic_bytes,
+                                     bool stream) {
+            const std::uint64_t dropped_total =
+                _notif_dropped_queue_full_count.fetch_add(1, std::memory_order_relaxed) + 1;
+            PYNETX_PROBE4(notification__drop, label_.c_str(), fd, bytes, dropped_total);
+
+            const std::uint64_t dropped_delta = dropped_total - _notif_last_drop_event_count;
+
+            const bool first_queue_full_event =
+                !_notif_queue_full_state.load(std::memory_order_acquire);
+
+            if (!first_queue_full_event &&
+                dropped_delta < static_cast<std::uint64_t>(notif_drop_event_threshold_)) {
                 return;
             }
 
-            if (_notif_queue_max_size_ >= 0 &&
-                _notif_queue.size() >= static_cast<size_t>(_notif_queue_max_size_)) {
-                ++_notif_dropped_queue_full_count;
+            _notif_queue_full_state.store(true, std::memory_order_release);
+            _notif_last_drop_event_count = dropped_total;
 
-                const std::uint64_t dropped_delta =
-                    _notif_dropped_queue_full_count - _notif_last_drop_event_count;
+            events_to_emit.push_back(
+                make_notification_health_event_locked(
+                    first_queue_full_event
+                        ? "notification_queue_full"
+                        : "notification_drops_summary",
+                    stream
+                        ? "Notification stream is over its byte budget; dropping notifications"
+                        : "Notification queue is full; dropping notifications",
+                    fd,
+                    static_cast<std::int64_t>(dropped_delta),
+                    diagnostic_bytes
+                )
+            );
 
-                const bool first_queue_full_event = !_notif_queue_full_state;
+            if (stream) {
+                NETX_LOG(LogLevel::Warning,
+                    "Notification stream over budget, dropping notifications. "
+                    << "stream=" << _notif_stream->name()
+                    << " pending_bytes=" << _notif_stream->pending_bytes()
+                    << " max_bytes=" << _notif_stream->max_bytes()
+                    << " dropped_queue_full=" << dropped_total
+                    << " dropped_delta=" << dropped_delta);
+            } else {
+                NETX_LOG(LogLevel::Warning,
+                    "Notification queue full, dropping notifications. "
+                    << "queue_size=" << _notif_queue.size()
+                    << " queue_max_size=" << _notif_queue_max_size_
+                    << " dropped_queue_full=" << dropped_total
+                    << " dropped_delta=" << dropped_delta);
+            }
+        };
 
-                if (first_queue_full_event ||
-                    dropped_delta >= static_cast<std::uint64_t>(notif_drop_event_threshold_)) {
-                    _notif_queue_full_state = true;
-                    _notif_last_drop_event_count = _notif_dropped_queue_full_count;
+        auto enqueue_or_drop_locked = [&](std::string notification,
+                                          std::int64_t diagnostic_bytes) {
+            if (notification.empty()) {
+                return;
+            }
 
+            if (_notif_stream) {
+                NotificationRecord record;
+                record.label = label_;
+                record.hostname = hostname_;
+                record.port = port_;
+                record.payload = std::move(notification);
+                const std::size_t bytes = record.payload.size();
+
+                bool waiters_pending = false;
+                if (!_notif_stream->publish(std::move(record), waiters_pending)) {
+                    count_drop_locked(bytes, diagnostic_bytes, true);
+                    return;
+                }
+                if (waiters_pending) {
+                    stream_to_serve = _notif_stream;
+                }
+                _notif_enqueued_count.fetch_add(1, std::memory_order_relaxed);
+                PYNETX_PROBE4(notification__enqueue, label_.c_str(), fd, bytes, 0);
+
+                // The stream's consumer does not know its producers, so
+                // recovery is reported by the first publish that fits again.
+                bool expected = true;
+                if (_notif_queue_full_state.load(std::memory_order_relaxed) &&
+                    _notif_queue_full_state.compare_exchange_strong(expected, false)) {
                     events_to_emit.push_back(
                         make_notification_health_event_locked(
-                            first_queue_full_event
-                                ? "notification_queue_full"
-                                : "notification_drops_summary",
-                            "Notification queue is full; dropping notifications",
+                            "notification_queue_recovered",
+                            "Notification stream has free capacity again",
                             fd,
-                            static_cast<std::int64_t>(dropped_delta),
-                            diagnostic_bytes
+                            0,
+                            0
                         )
                     );
-
-                    std::cerr
-                        << "Notification queue full, dropping notifications. "
-                        << "queue_size=" << _notif_queue.size()
-                        << " queue_max_size=" << _notif_queue_max_size_
-                        << " dropped_queue_full=" << _notif_dropped_queue_full_count
-                        << " dropped_delta=" << dropped_delta
-                        << std::endl;
                 }
+                return;
+            }
 
+            if (_notif_queue_max_size_ >= 0 &&
+                _notif_queue.size() >= static_cast<size_t>(_notif_queue_max_size_)) {
+                count_drop_locked(notification.size(), diagnostic_bytes, false);
                 return;
             }
 
-            _notif_queue.push_back(std::move(notification));
-            ++queued_notifications;
-            ++_notif_enqueued_count;
+            const std::size_t bytes = notification.size();
+            _notif_queue.push(std::move(notification));
+            _notif_enqueued_count.fetch_add(1, std::memory_order_relaxed);
 
-            if (_notif_queue.size() > _notif_queue_high_watermark) {
-                _notif_queue_high_watermark = _notif_queue.size();
+            const std::size_t depth = _notif_queue.size();
+            PYNETX_PROBE4(notification__enqueue, label_.c_str(), fd, bytes, depth);
+            if (depth > _notif_queue_high_watermark.load(std::memory_order_relaxed)) {
+                _notif_queue_high_watermark.store(depth, std::memory_order_relaxed);
             }
         };
 
         auto process_eom_frame_locked = [&](const std::string& frame_without_eom) {
-            const std::string trimmed = trim_copy(frame_without_eom);
             const std::int64_t frame_bytes =
                 static_cast<std::int64_t>(frame_without_eom.size());
 
-            if (trimmed.empty()) {
+            const bool blank = std::all_of(
+                frame_without_eom.begin(),
+                frame_without_eom.end(),
+                [](unsigned char c) { return std::isspace(c) != 0; }
+            );
+            if (blank) {
                 add_diagnostic_event_locked(
                     "malformed_notification",
                     "Received NETCONF EOM marker without notification payload; dropped empty frame",
@@ -908,108 +941,66 @@ void NetconfClient::on_notification_ready(int fd) {
             enqueue_or_drop_locked(frame_without_eom, frame_bytes);
         };
 
-        auto process_rx_buffer_locked = [&]() {
-            bool progressed = true;
-
-            while (progressed) {
-                progressed = false;
-
-                if (_notif_rx_buffer.empty()) {
-                    _notif_rx_partial_timer_active = false;
-                    break;
-                }
-
-                const std::size_t first_notification =
-                    find_notification_start_tag(_notif_rx_buffer, 0);
-
-                if (first_notification != std::string::npos && first_notification > 0) {
-                    const std::string prefix = _notif_rx_buffer.substr(0, first_notification);
-                    if (!benign_notification_prefix(prefix)) {
-                        add_diagnostic_event_locked(
-                            "malformed_notification",
-                            "Received orphan notification bytes before a notification start tag; dropped orphan fragment",
-                            static_cast<std::int64_t>(prefix.size()),
-                            false
-                        );
-                        _notif_rx_buffer.erase(0, first_notification);
-                        _notif_rx_partial_timer_active = false;
-                        progressed = true;
-                        continue;
-                    }
-                }
-
-                std::size_t eom_pos = std::string::npos;
-                while (
-                    (
-                        eom_pos = _notif_rx_buffer.find(NETCONF_NOTIFICATION_EOM)
-                    ) != std::string::npos
-                ) {
-                    std::string frame = _notif_rx_buffer.substr(0, eom_pos);
-                    _notif_rx_buffer.erase(0, eom_pos + NETCONF_NOTIFICATION_EOM_LEN);
-                    _notif_rx_partial_timer_active = false;
-
-                    process_eom_frame_locked(frame);
-                    progressed = true;
-                }
-                if (_notif_rx_buffer.empty()) {
-                    _notif_rx_partial_timer_active = false;
-                    break;
-                }
-
-                std::size_t notification_start = find_notification_start_tag(_notif_rx_buffer, 0);
-                if (notification_start != std::string::npos) {
-                    std::size_t notification_end = std::string::npos;
-
-                    if (notification_end_after_start(
-                            _notif_rx_buffer,
-                            notification_start,
-                            notification_end
-                        )) {
-                        const std::size_t next_notification =
-                            find_notification_start_tag(_notif_rx_buffer, notification_end);
-
-                        if (next_notification != std::string::npos) {
-                            std::string recovered = _notif_rx_buffer.substr(0, notification_end);
-                            _notif_rx_buffer.erase(0, notification_end);
-                            _notif_rx_partial_timer_active = false;
-
-                            process_recovered_missing_eom_locked(recovered);
-                            progressed = true;
-                            continue;
-                        }
-                    } else {
-                        const std::size_t next_notification =
-                            find_notification_start_tag(_notif_rx_buffer, notification_start + 1);
-
-                        if (next_notification != std::string::npos) {
-                            std::string abandoned_partial =
-                                _notif_rx_buffer.substr(0, next_notification);
-
-                            _notif_rx_buffer.erase(0, next_notification);
-                            _notif_rx_partial_timer_active = false;
+        auto process_abandoned_partial_locked = [&](std::string partial) {
+            const std::int64_t partial_bytes =
+                static_cast<std::int64_t>(partial.size());
 
-                            const std::int64_t partial_bytes =
-                                static_cast<std::int64_t>(abandoned_partial.size());
+            add_diagnostic_event_locked(
+                "incomplete_notification",
+                "Received a new notification start before the previous notification was completed; queued abandoned partial notification",
+                partial_bytes,
+                true
+            );
 
-                            add_diagnostic_event_locked(
-                                "incomplete_notification",
-                                "Received a new notification start before the previous notification was completed; queued abandoned partial notification",
-                                partial_bytes,
-                                true
-                            );
+            enqueue_or_drop_locked(std::move(partial), partial_bytes);
+        };
 
-                            enqueue_or_drop_locked(std::move(abandoned_partial), partial_bytes);
+        auto process_orphan_prefix_locked = [&](std::size_t bytes) {
+            add_diagnostic_event_locked(
+                "malformed_notification",
+                "Received orphan notification bytes before a notification start tag; dropped orphan fragment",
+                static_cast<std::int64_t>(bytes),
+                false
+            );
+        };
 
-                            progressed = true;
-                            continue;
-                        }
-                    }
-                }
-            }
+        struct RxFrames final : NotificationFrameHandler {
+            decltype(process_eom_frame_locked)& eom;
+            decltype(process_recovered_missing_eom_locked)& recovered;
+            decltype(process_abandoned_partial_locked)& abandoned;
+            decltype(process_orphan_prefix_locked)& orphan;
+
+            RxFrames(
+                decltype(eom) eom_frame,
+                decltype(recovered) recovered_frame,
+                decltype(abandoned) abandoned_partial,
+                decltype(orphan) orphan_prefix
+            ) : eom(eom_frame), recovered(recovered_frame),
+                abandoned(abandoned_partial), orphan(orphan_prefix) {}
+
+            void on_eom_frame(const std::string& frame) override { eom(frame); }
+            void on_recovered_frame(const std::string& frame) override { recovered(frame); }
+            void on_abandoned_partial(std::string partial) override { abandoned(std::move(partial)); }
+            void on_orphan_prefix(std::size_t bytes) override { orphan(bytes); }
+        } rx_frames(
+            process_eom_frame_locked,
+            process_recovered_missing_eom_locked,
+            process_abandoned_partial_locked,
+            process_orphan_prefix_locked
+        );
 
+        auto process_rx_buffer_locked = [&]() {
+            TraceSpan span("notification", "split_frames", label_.c_str(), "buffer_bytes",
+                           static_cast<std::int64_t>(_notif_rx_buffer.size()));
+            const bool consumed = split_notification_frames(_notif_rx_buffer, _notif_rx_scan,
+                                                            rx_frames);
+
+            // The incomplete-notification timer measures how long the current
+            // trailing partial has been waiting; it restarts whenever a frame
+            // was taken off the front.
             if (_notif_rx_buffer.empty()) {
                 _notif_rx_partial_timer_active = false;
-            } else if (!_notif_rx_partial_timer_active) {
+            } else if (consumed || !_notif_rx_partial_timer_active) {
                 _notif_rx_partial_timer_active = true;
                 _notif_rx_partial_started_at = std::chrono::steady_clock::now();
             }
@@ -1045,6 +1036,7 @@ void NetconfClient::on_notification_ready(int fd) {
 
             std::string partial = std::move(_notif_rx_buffer);
             _notif_rx_buffer.clear();
+            _notif_rx_scan = NotificationScanState();
             _notif_rx_partial_timer_active = false;
 
             const std::int64_t partial_bytes =
@@ -1060,24 +1052,8 @@ void NetconfClient::on_notification_ready(int fd) {
             enqueue_or_drop_locked(std::move(partial), partial_bytes);
         };
 
-        auto read_currently_available = [&]() -> std::string {
-            std::lock_guard<std::mutex> guard(notif_mutex_);
-
-            if (!notif_channel_ || !notif_session_) {
-                throw NetconfException("Notification channel/session is not active");
-            }
-
-            if (notif_socket_.get() != fd) {
-                throw NetconfException("Notification FD does not match active subscription socket");
-            }
-
-            return read_available_notification_bytes(
-                notif_channel_.get(),
-                notif_session_.get()
-            );
-        };
-
-        std::string bytes = read_currently_available();
+        std::string bytes = input.read();
+        bytes_read += bytes.size();
 
         {
             std::lock_guard<std::mutex> lk(_notif_queue_mtx);
@@ -1149,7 +1125,7 @@ void NetconfClient::on_notification_ready(int fd) {
                 break;
             }
 
-            const int ready = poll_notification_fd(fd, wait_ms);
+            const int ready = input.poll(wait_ms);
             if (ready == 0) {
                 {
                     std::lock_guard<std::mutex> lk(_notif_queue_mtx);
@@ -1163,7 +1139,8 @@ void NetconfClient::on_notification_ready(int fd) {
                 continue;
             }
 
-            std::string more = read_currently_available();
+            std::string more = input.read();
+            bytes_read += more.size();
 
             {
                 std::lock_guard<std::mutex> lk(_notif_queue_mtx);
@@ -1183,6 +1160,7 @@ void NetconfClient::on_notification_ready(int fd) {
             flush_events_and_notifications();
         }
 
+        return bytes_read;
     } catch (const std::exception& e) {
         throw NetconfException(
             std::string("Unable to read from channel: ") + e.what()
@@ -1190,86 +1168,275 @@ void NetconfClient::on_notification_ready(int fd) {
     }
 }
 
-std::string NetconfClient::next_notification(int timeout_ms) {
+void NetconfClient::report_slow_notification_handler(
+    int fd,
+    std::chrono::nanoseconds took,
+    std::chrono::nanoseconds threshold,
+    std::uint64_t slow_calls
+) noexcept {
     try {
+        using Millis = std::chrono::duration<double, std::milli>;
+
+        std::ostringstream message;
+        message << "Notification handler took "
+                << std::chrono::duration_cast<Millis>(took).count() << " ms (threshold "
+                << std::chrono::duration_cast<Millis>(threshold).count() << " ms); "
+                << slow_calls << " slow read(s) since the last report held up the "
+                << "other sessions on this reactor";
+
+        NotificationHealthEvent event;
         {
-            std::lock_guard<std::mutex> guard(notif_mutex_);
+            std::lock_guard<std::mutex> lk(_notif_queue_mtx);
+            event = make_notification_health_event_locked(
+                "slow_notification_handler",
+                message.str(),
+                fd
+            );
+        }
+        NotificationEventBus::instance().emit(std::move(event));
+    } catch (...) {
+        // Reporting must never take the reactor down.
+    }
+}
 
-            if (!notif_channel_) {
-                throw NetconfException("Notification channel not open.");
-            }
+void NetconfClient::require_active_notification_subscription() const {
+    std::lock_guard<std::mutex> guard(notif_mutex_);
 
-            if (!notif_session_) {
-                throw NetconfException("Notification session not open.");
-            }
+    if (!notif_channel_) {
+        throw NetconfException("Notification channel not open.");
+    }
 
-            if (!notif_is_connected_) {
-                throw NetconfException("Notification subscription is not active.");
-            }
-        }
+    if (!notif_session_) {
+        throw NetconfException("Notification session not open.");
+    }
+
+    if (!notif_is_connected_) {
+        throw NetconfException("Notification subscription is not active.");
+    }
+}
+
+void NetconfClient::require_no_notification_stream() const {
+    if (_notif_stream_attached.load(std::memory_order_acquire)) {
+        throw NetconfException(
+            "A notification stream is attached; read notifications with "
+            "NotificationStream.next_batch() or detach the stream first."
+        );
+    }
+}
 
-        std::unique_lock<std::mutex> lk(_notif_queue_mtx);
+void NetconfClient::emit_queue_recovered_event_if_needed() {
+    if (!_notif_queue_full_state.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (_notif_queue_max_size_ >= 0 &&
+        _notif_queue.size() >= static_cast<std::size_t>(_notif_queue_max_size_)) {
+        return;
+    }
+
+    bool expected = true;
+    if (!_notif_queue_full_state.compare_exchange_strong(expected, false)) {
+        return;
+    }
+
+    NotificationHealthEvent recovery_event;
+    {
+        std::lock_guard<std::mutex> lk(_notif_queue_mtx);
+        recovery_event = make_notification_health_event_locked(
+            "notification_queue_recovered",
+            "Notification queue has free capacity again",
+            -1,
+            0,
+            0
+        );
+    }
+
+    NotificationEventBus::instance().emit(std::move(recovery_event));
+}
+
+std::string NetconfClient::next_notification(int timeout_ms) {
+    try {
+        require_active_notification_subscription();
+        require_no_notification_stream();
 
         if (timeout_ms < 0) {
             throw NetconfException("timeout_ms must be >= 0");
         }
 
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        std::string xml;
         bool got_data = false;
 
-        if (timeout_ms == 0) {
-            got_data = !_notif_queue.empty();
-        } else {
-            got_data = _notif_queue_cv.wait_for(
-                lk,
-                std::chrono::milliseconds(timeout_ms),
-                [&]{ return !_notif_queue.empty(); }
-            );
+        // Consumers park on the ring without holding any lock; another consumer
+        // may win the item after a wakeup, in which case we wait again.
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+                got_data = _notif_queue.try_pop(xml);
+            }
+
+            if (got_data || timeout_ms == 0 || !_notif_queue.wait_until(deadline)) {
+                break;
+            }
         }
 
         if (!got_data) {
             return std::string{};
         }
 
-        std::string xml = std::move(_notif_queue.front());
-        _notif_queue.pop_front();
+        emit_queue_recovered_event_if_needed();
+
+        return xml;
 
-        NotificationHealthEvent recovery_event;
-        bool emit_recovery_event = false;
+    } catch (const std::exception& e) {
+        throw NetconfException("Unable to read from queue: " + std::string(e.what()));
+    }
+}
 
-        if (_notif_queue_full_state &&
-            (_notif_queue_max_size_ < 0 ||
-            _notif_queue.size() < static_cast<std::size_t>(_notif_queue_max_size_))) {
-            _notif_queue_full_state = false;
+std::vector<std::string> NetconfClient::next_notifications(int max_items, int timeout_ms) {
+    try {
+        require_active_notification_subscription();
+        require_no_notification_stream();
 
-            recovery_event = make_notification_health_event_locked(
-                "notification_queue_recovered",
-                "Notification queue has free capacity again",
-                -1,
-                0,
-                0
-            );
-            emit_recovery_event = true;
+        if (max_items < -1 || max_items == 0) {
+            throw NetconfException("max_items must be -1 for all items or greater than 0");
         }
 
-        lk.unlock();
+        if (timeout_ms < 0) {
+            throw NetconfException("timeout_ms must be >= 0");
+        }
+
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+        std::size_t limit = max_items < 0
+            ? static_cast<std::size_t>(-1)
+            : static_cast<std::size_t>(max_items);
+
+        std::vector<std::string> batch;
+
+        // Wait for the first item only, then drain whatever is queued in one
+        // consumer-lock acquisition.
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+                batch.reserve(std::min(limit, _notif_queue.size()));
+                _notif_queue.pop_bulk(batch, limit);
+            }
 
-        if (emit_recovery_event) {
-            NotificationEventBus::instance().emit(std::move(recovery_event));
+            if (!batch.empty() || timeout_ms == 0 || !_notif_queue.wait_until(deadline)) {
+                break;
+            }
         }
 
-        return xml;
+        if (!batch.empty()) {
+            emit_queue_recovered_event_if_needed();
+        }
+
+        return batch;
 
     } catch (const std::exception& e) {
         throw NetconfException("Unable to read from queue: " + std::string(e.what()));
     }
 }
 
+void NetconfClient::register_notification_waiter(
+    std::shared_ptr<NotificationWaiter> waiter,
+    int timeout_ms
+) {
+    std::vector<std::string> items;
+    {
+        std::lock_guard<std::mutex> waiters_lk(_notif_waiters_mtx);
+
+        // Announce the waiter before looking at the ring; see
+        // on_notification_ready().
+        _notif_waiter_count.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        {
+            std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+            _notif_queue.pop_bulk(items, waiter->limit);
+        }
+
+        if (items.empty() && timeout_ms > 0) {
+            // The timer holds the client, as the pool task used to, so the
+            // waiter always completes.
+            auto self = shared_from_this();
+            std::weak_ptr<NotificationWaiter> weak_waiter = waiter;
+            waiter->timer = DeadlineTimer::instance().schedule(
+                DeadlineTimer::Clock::now() + std::chrono::milliseconds(timeout_ms),
+                [self, weak_waiter]() { self->expire_notification_waiter(weak_waiter); }
+            );
+            _notif_waiters.push_back(std::move(waiter));
+            return;
+        }
+
+        _notif_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (!items.empty()) {
+        emit_queue_recovered_event_if_needed();
+    }
+    waiter->deliver(std::move(items));
+}
+
+void NetconfClient::serve_notification_waiters() {
+    std::vector<std::pair<std::shared_ptr<NotificationWaiter>, std::vector<std::string>>> ready;
+    {
+        std::lock_guard<std::mutex> waiters_lk(_notif_waiters_mtx);
+        std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+
+        while (!_notif_waiters.empty()) {
+            std::vector<std::string> items;
+            _notif_queue.pop_bulk(items, _notif_waiters.front()->limit);
+            if (items.empty()) {
+                break;
+            }
+            ready.emplace_back(std::move(_notif_waiters.front()), std::move(items));
+            _notif_waiters.pop_front();
+            _notif_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (ready.empty()) {
+        return;
+    }
+
+    for (auto& entry : ready) {
+        DeadlineTimer::instance().cancel(entry.first->timer);
+        entry.first->deliver(std::move(entry.second));
+    }
+    emit_queue_recovered_event_if_needed();
+}
+
+void NetconfClient::expire_notification_waiter(const std::weak_ptr<NotificationWaiter>& weak_waiter) {
+    std::shared_ptr<NotificationWaiter> waiter = weak_waiter.lock();
+    if (!waiter) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> waiters_lk(_notif_waiters_mtx);
+        auto it = std::find(_notif_waiters.begin(), _notif_waiters.end(), waiter);
+        if (it == _notif_waiters.end()) {
+            // Already served by the reactor.
+            return;
+        }
+        _notif_waiters.erase(it);
+        _notif_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    waiter->deliver({});
+}
+
 std::vector<std::string> NetconfClient::peek_notifications(int max_items) {
     if (max_items < -1) {
         throw NetconfException("max_items must be -1 for all items or >= 0");
     }
 
-    std::lock_guard<std::mutex> lk(_notif_queue_mtx);
+    std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
 
     std::size_t limit = _notif_queue.size();
 
@@ -1280,19 +1447,91 @@ std::vector<std::string> NetconfClient::peek_notifications(int max_items) {
 
     std::vector<std::string> snapshot;
     snapshot.reserve(limit);
+    _notif_queue.snapshot(snapshot, limit);
 
-    auto it = _notif_queue.begin();
+    return snapshot;
+}
 
-    for (std::size_t i = 0; i < limit && it != _notif_queue.end(); ++i, ++it) {
-        snapshot.push_back(*it);
+std::size_t NetconfClient::notification_queue_size() {
+    return _notif_queue.size();
+}
+
+void NetconfClient::attach_notification_stream(std::shared_ptr<NotificationStream> stream) {
+    if (!stream) {
+        throw NetconfException("notification stream cannot be None");
     }
 
-    return snapshot;
+    {
+        std::lock_guard<std::mutex> lk(_notif_queue_mtx);
+        _notif_stream = std::move(stream);
+        _notif_stream_attached.store(true, std::memory_order_release);
+    }
+
+    // Nothing reaches the per-client queue any more: fail its async waiters
+    // and wake notifications() iterators so they see the error now.
+    std::deque<std::shared_ptr<NotificationWaiter>> waiters;
+    {
+        std::lock_guard<std::mutex> waiters_lk(_notif_waiters_mtx);
+        waiters.swap(_notif_waiters);
+        _notif_waiter_count.fetch_sub(waiters.size(), std::memory_order_relaxed);
+    }
+    for (auto& waiter : waiters) {
+        DeadlineTimer::instance().cancel(waiter->timer);
+        waiter->fail(std::make_exception_ptr(NetconfException(
+            "Unable to read from queue: a notification stream was attached"
+        )));
+    }
+    _notif_queue.wake_all();
 }
 
-std::size_t NetconfClient::notification_queue_size() {
+void NetconfClient::detach_notification_stream() {
     std::lock_guard<std::mutex> lk(_notif_queue_mtx);
-    return _notif_queue.size();
+    _notif_stream.reset();
+    _notif_stream_attached.store(false, std::memory_order_release);
+}
+
+int NetconfClient::notification_ready_fd() {
+    try {
+        return _notif_queue.readable().fd();
+    } catch (const std::exception& e) {
+        throw NetconfException(
+            "Unable to create notification ready fd: " + std::string(e.what())
+        );
+    }
+}
+
+bool NetconfClient::arm_notification_ready_fd() noexcept {
+    _notif_queue.readable().arm();
+    return !_notif_queue.empty();
+}
+
+void NetconfClient::drain_notification_ready_fd() noexcept {
+    _notif_queue.readable().drain();
+}
+
+std::vector<std::string> NetconfClient::try_next_notifications(std::size_t max_items) {
+    require_no_notification_stream();
+
+    std::vector<std::string> batch;
+    {
+        std::lock_guard<std::mutex> consumer_lk(_notif_consumer_mtx);
+        batch.reserve(std::min(max_items, _notif_queue.size()));
+        _notif_queue.pop_bulk(batch, max_items);
+    }
+
+    if (!batch.empty()) {
+        emit_queue_recovered_event_if_needed();
+    }
+
+    return batch;
+}
+
+bool NetconfClient::claim_notification_ready_fd() noexcept {
+    return !_notif_ready_fd_claimed.exchange(true, std::memory_order_acq_rel);
+}
+
+void NetconfClient::release_notification_ready_fd() noexcept {
+    _notif_ready_fd_claimed.store(false, std::memory_order_release);
 }
 
 NotificationHealthEvent NetconfClient::make_notification_health_event_locked(
@@ -1314,13 +1553,15 @@ NotificationHealthEvent NetconfClient::make_notification_health_event_locked(
 
     event.queue_size = static_cast<std::int64_t>(_notif_queue.size());
     event.queue_max_size = static_cast<std::int64_t>(_notif_queue_max_size_);
-    event.queue_high_watermark = static_cast<std::int64_t>(_notif_queue_high_watermark);
-    event.notifications_enqueued = static_cast<std::int64_t>(_notif_enqueued_count);
+    event.queue_high_watermark =
+        static_cast<std::int64_t>(_notif_queue_high_watermark.load(std::memory_order_relaxed));
+    event.notifications_enqueued =
+        static_cast<std::int64_t>(_notif_enqueued_count.load(std::memory_order_relaxed));
     event.notifications_dropped_queue_full =
-        static_cast<std::int64_t>(_notif_dropped_queue_full_count);
+        static_cast<std::int64_t>(_notif_dropped_queue_full_count.load(std::memory_order_relaxed));
     event.notifications_dropped_delta = dropped_delta;
     event.incomplete_notifications_received =
-        static_cast<std::int64_t>(_notif_incomplete_count);
+        static_cast<std::int64_t>(_notif_incomplete_count.load(std::memory_order_relaxed));
     event.partial_bytes = partial_bytes;
 
     return event;
@@ -1348,7 +1589,19 @@ bool NetconfClient::is_subscription_active() const {
 }
 
 std::string NetconfClient::send_rpc_non_blocking(const std::string& rpc) {
-    return send_rpc_non_blocking_func(channel_.get(), session_.get(), socket_.get(), rpc, read_timeout_);
+    RpcTrace trace = begin_rpc_trace();
+    PYNETX_PROBE3(rpc__start, label_.c_str(), socket_.get(), rpc.size());
+    ChannelCapture::Scope capture(label_, socket_.get());
+    try {
+        std::string reply = send_rpc_non_blocking_func(
+            channel_.get(), session_.get(), socket_.get(), rpc, read_timeout_, &trace
+        );
+        finish_rpc_trace(trace, false, reply.size());
+        return reply;
+    } catch (...) {
+        finish_rpc_trace(trace, true);
+        throw;
+    }
 }
 
 std::string NetconfClient::get_non_blocking(
@@ -1362,7 +1615,7 @@ std::string NetconfClient::get_non_blocking(
         rpc += R"(<filter type="subtree">)" + filter + "</filter>";
     }
     rpc += R"(</get></rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::get_config_non_blocking(
@@ -1378,7 +1631,7 @@ std::string NetconfClient::get_config_non_blocking(
         rpc += R"(<filter type="subtree">)" + filter + "</filter>";
     }
     rpc += R"(</get-config></rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::copy_config_non_blocking(
@@ -1393,7 +1646,7 @@ std::string NetconfClient::copy_config_non_blocking(
             R"(<source><)" + source + R"(/></source>)"
           R"(</copy-config>)"
         R"(</rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::delete_config_non_blocking(
@@ -1406,7 +1659,7 @@ std::string NetconfClient::delete_config_non_blocking(
             R"(<target><)" + target + R"(/></target>)"
           R"(</delete-config>)"
         R"(</rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::validate_non_blocking(
@@ -1419,7 +1672,7 @@ std::string NetconfClient::validate_non_blocking(
             R"(<source><)" + source + R"(/></source>)"
           R"(</validate>)"
         R"(</rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::edit_config_non_blocking(
@@ -1435,7 +1688,7 @@ std::string NetconfClient::edit_config_non_blocking(
             R"(<config>)" + config + R"(</config>)"
           R"(</edit-config>)"
         R"(</rpc>)";
-    std::string reply = send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    std::string reply = send_rpc_non_blocking(rpc);
     if (do_validate) {
         validate_non_blocking(target);
     }
@@ -1489,6 +1742,7 @@ std::string NetconfClient::subscribe_non_blocking(
         {
             std::lock_guard<std::mutex> lk(_notif_queue_mtx);
             _notif_rx_buffer.clear();
+            _notif_rx_scan = NotificationScanState();
             _notif_rx_partial_timer_active = false;
         }
 
@@ -1522,7 +1776,7 @@ std::string NetconfClient::lock_non_blocking(const std::string& target) {
             R"(<target><)" + target + R"(/></target>)"
           R"(</lock>)"
         R"(</rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::unlock_non_blocking(const std::string& target) {
@@ -1533,7 +1787,7 @@ std::string NetconfClient::unlock_non_blocking(const std::string& target) {
             R"(<target><)" + target + R"(/></target>)"
           R"(</unlock>)"
         R"(</rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(),  session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::commit_non_blocking() {
@@ -1542,7 +1796,7 @@ std::string NetconfClient::commit_non_blocking() {
         R"(<rpc xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id="101">)"
           R"(<commit/>)"
         R"(</rpc>)";
-    return send_rpc_non_blocking_func(channel_.get(), session_.get(), socket_.get(), rpc, read_timeout_);
+    return send_rpc_non_blocking(rpc);
 }
 
 std::string NetconfClient::locked_edit_config_non_blocking(
@@ -0,0 +1,280 @@
+#include "netconf_framing.hpp"
+
+#include <tinyxml2.h>
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace {
+    constexpr const char* NETCONF_EOM = "]]>]]>";
+    constexpr std::size_t NETCONF_EOM_LEN = 6;
+
+    std::string trim_copy(const std::string& input) {
+        auto begin = std::find_if_not(input.begin(), input.end(), [](unsigned char c) {
+            return std::isspace(c) != 0;
+        });
+        auto end = std::find_if_not(input.rbegin(), input.rend(), [](unsigned char c) {
+            return std::isspace(c) != 0;
+        }).base();
+
+        if (begin >= end) {
+            return std::string{};
+        }
+
+        return std::string(begin, end);
+    }
+
+    std::string xml_local_name(const char* name) {
+        if (!name) {
+            return std::string{};
+        }
+
+        std::string value(name);
+        const std::size_t colon = value.rfind(':');
+        if (colon != std::string::npos) {
+            return value.substr(colon + 1);
+        }
+        return value;
+    }
+
+    // First <notification> start tag (any prefix) at or after from. resume is
+    // where a later search over the same, grown data has to start again: at
+    // the match, or at a trailing tag whose name may still be cut short.
+    // Everything before it was decided and cannot change as bytes are added.
+    std::size_t find_notification_start_tag(
+        const std::string& data,
+        std::size_t from,
+        std::size_t& resume
+    ) {
+        static const char LOCAL[] = "notification";
+        constexpr std::size_t LOCAL_LEN = sizeof(LOCAL) - 1;
+        std::size_t pos = from;
+
+        while (true) {
+            pos = data.find('<', pos);
+            if (pos == std::string::npos) {
+                resume = data.size();
+                return std::string::npos;
+            }
+
+            if (pos + 1 >= data.size()) {
+                resume = pos;
+                return std::string::npos;
+            }
+
+            const char next = data[pos + 1];
+            if (next == '/' || next == '!' || next == '?') {
+                ++pos;
+                continue;
+            }
+
+            std::size_t name_begin = pos + 1;
+            std::size_t name_end = name_begin;
+            std::size_t local_begin = name_begin;
+            while (name_end < data.size()) {
+                unsigned char c = static_cast<unsigned char>(data[name_end]);
+                if (std::isspace(c) || data[name_end] == '>' || data[name_end] == '/') {
+                    break;
+                }
+                if (data[name_end] == ':') {
+                    local_begin = name_end + 1;
+                }
+                ++name_end;
+            }
+
+            if (name_end == name_begin) {
+                ++pos;
+                continue;
+            }
+
+            if (name_end - local_begin == LOCAL_LEN &&
+                data.compare(local_begin, LOCAL_LEN, LOCAL) == 0) {
+                resume = pos;
+                return pos;
+            }
+
+            if (name_end == data.size()) {
+                // The name may go on in the next read.
+                resume = pos;
+                return std::string::npos;
+            }
+
+            pos = name_end;
+        }
+    }
+
+    bool benign_notification_prefix(const std::string& prefix) {
+        const std::string trimmed = trim_copy(prefix);
+        if (trimmed.empty()) {
+            return true;
+        }
+
+        if (trimmed.rfind("<?xml", 0) == 0) {
+            const std::size_t end_decl = trimmed.find("?>");
+            if (end_decl != std::string::npos) {
+                return trim_copy(trimmed.substr(end_decl + 2)).empty();
+            }
+        }
+
+        return false;
+    }
+
+    // close_from: where an earlier search for this start tag's close tag
+    // stopped, or 0. It is moved past the bytes searched on a miss.
+    bool notification_end_after_start(
+        const std::string& data,
+        std::size_t start,
+        std::size_t& end_after,
+        std::size_t& close_from
+    ) {
+        if (start == std::string::npos || start + 1 >= data.size()) {
+            return false;
+        }
+
+        std::size_t name_begin = start + 1;
+        std::size_t name_end = name_begin;
+        while (name_end < data.size()) {
+            unsigned char c = static_cast<unsigned char>(data[name_end]);
+            if (std::isspace(c) || data[name_end] == '>' || data[name_end] == '/') {
+                break;
+            }
+            ++name_end;
+        }
+
+        if (name_end == name_begin) {
+            return false;
+        }
+
+        const std::string qname = data.substr(name_begin, name_end - name_begin);
+        const std::string close_tag = "</" + qname + ">";
+        const std::size_t close_pos = data.find(close_tag, std::max(name_end, close_from));
+        if (close_pos == std::string::npos) {
+            // A close tag can start at most close_tag.size() - 1 bytes before
+            // the end of what was searched.
+            if (data.size() >= close_tag.size()) {
+                close_from = std::max(name_end, data.size() - (close_tag.size() - 1));
+            }
+            return false;
+        }
+
+        end_after = close_pos + close_tag.size();
+        return true;
+    }
+}
+
+bool append_until_eom(std::string& response, const char* data, std::size_t size) {
+    // Earlier chunks held no complete marker, so a new one can start at most
+    // NETCONF_EOM_LEN - 1 bytes before this chunk.
+    const std::size_t from = response.size() >= NETCONF_EOM_LEN - 1
+        ? response.size() - (NETCONF_EOM_LEN - 1)
+        : 0;
+    response.append(data, size);
+    return response.find(NETCONF_EOM, from) != std::string::npos;
+}
+
+bool is_valid_notification_document(const std::string& frame_without_eom) {
+    const std::string payload = trim_copy(frame_without_eom);
+    if (payload.empty()) {
+        return false;
+    }
+
+    tinyxml2::XMLDocument doc;
+    const tinyxml2::XMLError parse_status = doc.Parse(payload.c_str(), payload.size());
+    if (parse_status != tinyxml2::XML_SUCCESS) {
+        return false;
+    }
+
+    tinyxml2::XMLElement* root = doc.RootElement();
+    if (!root) {
+        return false;
+    }
+
+    return xml_local_name(root->Name()) == "notification";
+}
+
+bool split_notification_frames(std::string& buffer,
+                               NotificationScanState& scan,
+                               NotificationFrameHandler& handler) {
+    bool consumed = false;
+    bool progressed = true;
+
+    // Every search below resumes where the previous call over the same front
+    // of the buffer stopped; taking bytes off the front starts them over.
+    const auto take_front = [&](std::size_t bytes) {
+        buffer.erase(0, bytes);
+        scan = NotificationScanState();
+        consumed = progressed = true;
+    };
+
+    while (progressed) {
+        progressed = false;
+
+        if (buffer.empty()) {
+            break;
+        }
+
+        const std::size_t first_notification =
+            find_notification_start_tag(buffer, scan.start_from, scan.start_from);
+
+        if (first_notification != std::string::npos && first_notification > 0) {
+            const std::string prefix = buffer.substr(0, first_notification);
+            if (!benign_notification_prefix(prefix)) {
+                take_front(first_notification);
+                handler.on_orphan_prefix(prefix.size());
+                continue;
+            }
+        }
+
+        std::size_t eom_pos = std::string::npos;
+        while ((eom_pos = buffer.find(NETCONF_EOM, scan.eom_from)) != std::string::npos) {
+            std::string frame = buffer.substr(0, eom_pos);
+            take_front(eom_pos + NETCONF_EOM_LEN);
+            handler.on_eom_frame(frame);
+        }
+        if (buffer.empty()) {
+            break;
+        }
+        if (buffer.size() >= NETCONF_EOM_LEN) {
+            scan.eom_from = buffer.size() - (NETCONF_EOM_LEN - 1);
+        }
+
+        std::size_t notification_start =
+            find_notification_start_tag(buffer, scan.start_from, scan.start_from);
+        if (notification_start != std::string::npos) {
+            std::size_t notification_end = std::string::npos;
+            if (notification_start != scan.head) {
+                // A start tag cut short at the end of the last read turned
+                // out to be something else; searches behind it start over.
+                scan.head = notification_start;
+                scan.close_from = scan.after_close_from = scan.after_start_from = 0;
+            }
+
+            if (notification_end_after_start(buffer, notification_start, notification_end,
+                                             scan.close_from)) {
+                const std::size_t next_notification = find_notification_start_tag(
+                    buffer, std::max(notification_end, scan.after_close_from),
+                    scan.after_close_from);
+
+                if (next_notification != std::string::npos) {
+                    std::string recovered = buffer.substr(0, notification_end);
+                    take_front(notification_end);
+                    handler.on_recovered_frame(recovered);
+                    continue;
+                }
+            } else {
+                const std::size_t next_notification = find_notification_start_tag(
+                    buffer, std::max(notification_start + 1, scan.after_start_from),
+                    scan.after_start_from);
+
+                if (next_notification != std::string::npos) {
+                    std::string abandoned_partial = buffer.substr(0, next_notification);
+                    take_front(next_notification);
+                    handler.on_abandoned_partial(std::move(abandoned_partial));
+                    continue;
+                }
+            }
+        }
+    }
+
+    return consumed;
+}
@@ -1,11 +1,10 @@
 #include "notification_event_bus.hpp"
 #include "netconf_client.hpp"
-#include "thread_pool.hpp"
-#include "thread_pool_global.hpp"
+#include "logger.hpp"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
-#include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -41,31 +40,57 @@ NotificationEventBus& NotificationEventBus::instance() {
     return *bus;
 }
 
+NotificationEventBus::NotificationEventBus()
+    : emitted_metric_(MetricsRegistry::instance().counter(
+          "pynetx_health_events", "Notification health events emitted")),
+      dropped_metric_(MetricsRegistry::instance().counter(
+          "pynetx_health_events_dropped", "Health events dropped because nobody read them")),
+      pending_metric_(MetricsRegistry::instance().gauge(
+          "pynetx_health_events_pending", "Health events waiting to be read"))
+{
+}
+
 void NotificationEventBus::emit(NotificationHealthEvent event) noexcept {
     try {
         if (event.timestamp.empty()) {
             event.timestamp = current_notification_event_timestamp_utc();
         }
+
+        std::shared_ptr<Waiter> waiter;
         {
             std::lock_guard<std::mutex> lk(mtx_);
 
-            if (queue_.size() >= max_queue_size_) {
-                queue_.pop_front();
-                ++dropped_events_;
+            if (!waiters_.empty()) {
+                waiter = std::move(waiters_.front());
+                waiters_.pop_front();
                 event.health_events_dropped = dropped_events_;
+            } else {
+                if (queue_.size() >= max_queue_size_) {
+                    queue_.pop_front();
+                    ++dropped_events_;
+                    dropped_metric_->inc();
+                    event.health_events_dropped = dropped_events_;
+                }
+
+                queue_.push_back(std::move(event));
+                pending_metric_->set(static_cast<std::int64_t>(queue_.size()));
             }
+        }
+        emitted_metric_->inc();
 
-            queue_.push_back(std::move(event));
+        if (waiter) {
+            DeadlineTimer::instance().cancel(waiter->timer);
+            waiter->complete(std::move(event));
+            return;
         }
 
         cv_.notify_one();
 
     } catch (const std::exception& e) {
-        std::cerr << "NotificationEventBus: failed to emit event: "
-                  << e.what() << std::endl;
+        NETX_LOG(LogLevel::Error, "NotificationEventBus: failed to emit event: "
+                 << e.what());
     } catch (...) {
-        std::cerr << "NotificationEventBus: failed to emit event: unknown error"
-                  << std::endl;
+        NETX_LOG(LogLevel::Error, "NotificationEventBus: failed to emit event: unknown error");
     }
 }
 
@@ -92,26 +117,89 @@ NotificationHealthEvent NotificationEventBus::next_event(int timeout_ms) {
     }
 
     if (!got_event) {
-        NotificationHealthEvent timeout_event;
-        timeout_event.valid = false;
-        timeout_event.type = "timeout";
-        timeout_event.timestamp = current_notification_event_timestamp_utc();
-        timeout_event.label = "None";
-        timeout_event.message = "No notification health event available before timeout";
-        timeout_event.health_events_dropped = dropped_events_;
-        return timeout_event;
+        return make_timeout_event_locked();
     }
 
     NotificationHealthEvent event = std::move(queue_.front());
     queue_.pop_front();
+    pending_metric_->set(static_cast<std::int64_t>(queue_.size()));
     event.health_events_dropped = dropped_events_;
     return event;
 }
 
+NotificationHealthEvent NotificationEventBus::make_timeout_event_locked() const {
+    NotificationHealthEvent timeout_event;
+    timeout_event.valid = false;
+    timeout_event.type = "timeout";
+    timeout_event.timestamp = current_notification_event_timestamp_utc();
+    timeout_event.label = "None";
+    timeout_event.message = "No notification health event available before timeout";
+    timeout_event.health_events_dropped = dropped_events_;
+    return timeout_event;
+}
+
+// Registers a continuation instead of parking a pool worker: the waiter is
+// completed by the next emit(), or by the DeadlineTimer with a timeout event.
 std::future<NotificationHealthEvent> NotificationEventBus::next_event_async(int timeout_ms) {
-    return get_pool().enqueue([timeout_ms]() -> NotificationHealthEvent {
-        return NotificationEventBus::instance().next_event(timeout_ms);
-    });
+    auto waiter = std::make_shared<Waiter>();
+    std::future<NotificationHealthEvent> fut = waiter->future();
+
+    if (timeout_ms < -1) {
+        waiter->fail(std::make_exception_ptr(
+            NetconfException("timeout_ms must be -1 for infinite wait or >= 0")
+        ));
+        return fut;
+    }
+
+    NotificationHealthEvent ready;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+
+        if (!queue_.empty()) {
+            ready = std::move(queue_.front());
+            queue_.pop_front();
+            pending_metric_->set(static_cast<std::int64_t>(queue_.size()));
+            ready.health_events_dropped = dropped_events_;
+        } else if (timeout_ms == 0) {
+            ready = make_timeout_event_locked();
+        } else {
+            if (timeout_ms > 0) {
+                std::weak_ptr<Waiter> weak_waiter = waiter;
+                waiter->timer = DeadlineTimer::instance().schedule(
+                    DeadlineTimer::Clock::now() + std::chrono::milliseconds(timeout_ms),
+                    [weak_waiter]() {
+                        NotificationEventBus::instance().expire_waiter(weak_waiter);
+                    }
+                );
+            }
+            waiters_.push_back(waiter);
+            return fut;
+        }
+    }
+
+    waiter->complete(std::move(ready));
+    return fut;
+}
+
+void NotificationEventBus::expire_waiter(const std::weak_ptr<Waiter>& weak_waiter) {
+    std::shared_ptr<Waiter> waiter = weak_waiter.lock();
+    if (!waiter) {
+        return;
+    }
+
+    NotificationHealthEvent timeout_event;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        auto it = std::find(waiters_.begin(), waiters_.end(), waiter);
+        if (it == waiters_.end()) {
+            // emit() already handed it an event.
+            return;
+        }
+        waiters_.erase(it);
+        timeout_event = make_timeout_event_locked();
+    }
+
+    waiter->complete(std::move(timeout_event));
 }
 
 std::size_t NotificationEventBus::pending_event_count() {
@@ -127,5 +215,6 @@ std::int64_t NotificationEventBus::dropped_event_count() {
 void NotificationEventBus::clear() {
     std::lock_guard<std::mutex> lk(mtx_);
     queue_.clear();
+    pending_metric_->set(0);
     dropped_events_ = 0;
 }
\ No newline at end of file
@@ -1,22 +1,56 @@
 #include "notification_reactor_manager.hpp"
 #include "notification_reactor.hpp"
 #include "netconf_client.hpp"
+#include "logger.hpp"
+#include "trace_recorder.hpp"
+#include "usdt_probes.hpp"
 #include <sys/epoll.h>
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
+#include <algorithm>
 #include <stdexcept>
-#include <iostream>
 #include <memory>
 
+constexpr std::size_t ReactorStatsSnapshot::MAX_EVENTS;
+
+namespace {
+    std::atomic<std::int64_t> slow_handler_threshold_nanos{0};
+
+    // Slow-handler health events per session are at most this frequent; the
+    // event carries the number of slow calls since the previous one.
+    constexpr std::chrono::seconds SLOW_EVENT_INTERVAL{1};
+
+    int next_reactor_id() {
+        static std::atomic<int> next_id{0};
+        return next_id.fetch_add(1);
+    }
+}
+
 NotificationReactor& NotificationReactor::instance() {
     static NotificationReactor inst;
     return inst;
 }
 
 NotificationReactor::NotificationReactor()
-  : _running(true)
+  : _running(true),
+    _id(next_reactor_id()),
+    _started(Clock::now())
 {
+    const MetricLabels labels = {{"reactor", std::to_string(_id)}};
+    MetricsRegistry& registry = MetricsRegistry::instance();
+    _wakeups_metric = registry.counter(
+        "pynetx_reactor_wakeups", "epoll_wait calls that returned events", labels);
+    _events_metric = registry.counter(
+        "pynetx_reactor_events", "Readiness events dispatched to clients", labels);
+    _bytes_metric = registry.counter(
+        "pynetx_reactor_bytes_read", "Notification bytes read by the reactor's handlers", labels);
+    _fds_metric = registry.gauge(
+        "pynetx_reactor_registered_fds", "Notification sessions watched by the reactor", labels);
+    _dispatch_lag_metric = registry.histogram(
+        "pynetx_reactor_dispatch_lag_seconds",
+        "Time from epoll_wait returning to a handler starting", labels);
+
     try {
       _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
       if (_epoll_fd < 0) {
@@ -36,24 +70,47 @@ NotificationReactor::~NotificationReactor() {
     }
     ::close(_epoll_fd);
     } catch (const std::exception& e) {
-        std::cerr << "Error happened while closing reactor pool: " << std::string(e.what()) << '\n';
+        NETX_LOG(LogLevel::Error, "Error happened while closing reactor pool: " << e.what());
     } catch (...) {
-        std::cerr << "Unknown error while closing reactor pool";
+        NETX_LOG(LogLevel::Error, "Unknown error while closing reactor pool");
     }
 }
 
 void NotificationReactor::add(int fd, std::weak_ptr<NetconfClient> client) {
     try {
-        std::lock_guard<std::mutex> guard(_mtx);
-
         if (fd < 0) {
             throw NetconfException("NotificationReactor: invalid FD");
         }
 
-        if (client.expired()) {
-            throw NetconfException("NotificationReactor: expired client");
+        std::shared_ptr<Handler> stats = std::make_shared<Handler>();
+        {
+            std::shared_ptr<NetconfClient> owner = client.lock();
+            if (!owner) {
+                throw NetconfException("NotificationReactor: expired client");
+            }
+            stats->label = owner->label();
+            stats->hostname = owner->hostname();
+            stats->port = owner->port();
         }
 
+        const MetricLabels labels = {
+            {"device", stats->label},
+            {"host", stats->hostname},
+            {"port", std::to_string(stats->port)},
+            {"reactor", std::to_string(_id)},
+        };
+        MetricsRegistry& registry = MetricsRegistry::instance();
+        stats->duration_metric = registry.histogram(
+            "pynetx_notification_handler_seconds",
+            "Time the reactor spent in one notification read for the session", labels);
+        stats->bytes_metric = registry.counter(
+            "pynetx_notification_bytes_read", "Notification bytes read for the session", labels);
+        stats->slow_metric = registry.counter(
+            "pynetx_notification_slow_handlers",
+            "Notification reads at or over the slow-handler threshold", labels);
+
+        std::lock_guard<std::mutex> guard(_mtx);
+
         struct epoll_event ev{};
         ev.events = EPOLLIN | EPOLLERR | EPOLLRDHUP;
         ev.data.fd = fd;
@@ -65,7 +122,8 @@ void NotificationReactor::add(int fd, std::weak_ptr<NetconfClient> client) {
             );
         }
 
-        _handlers[fd] = std::move(client);
+        _handlers[fd] = Watched{std::move(client), std::move(stats)};
+        _fds_metric->set(static_cast<std::int64_t>(_handlers.size()));
 
     } catch (const std::exception& e) {
         throw NetconfException(
@@ -84,13 +142,28 @@ void NotificationReactor::remove(int fd) {
 
     epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
     _handlers.erase(fd);
+    _fds_metric->set(static_cast<std::int64_t>(_handlers.size()));
 }
 
 void NotificationReactor::loop() {
+    // Handler timings of one wakeup, committed to the stats in one go.
+    struct Call {
+        std::shared_ptr<Handler> stats;
+        std::uint64_t lag_nanos;
+        std::uint64_t nanos;
+        std::size_t bytes;
+        bool slow;
+    };
+    std::vector<Call> calls;
+    calls.reserve(ReactorStatsSnapshot::MAX_EVENTS);
+
+    TraceRecorder::set_thread_name("notification-reactor-" + std::to_string(_id));
+
     while (_running) {
-        struct epoll_event events[64];
+        struct epoll_event events[ReactorStatsSnapshot::MAX_EVENTS];
 
-        int n = epoll_wait(_epoll_fd, events, 64, 1000);
+        int n = epoll_wait(_epoll_fd, events, ReactorStatsSnapshot::MAX_EVENTS, 1000);
+        const Clock::time_point woke = Clock::now();
 
         if (!_running) {
             break;
@@ -101,16 +174,25 @@ void NotificationReactor::loop() {
                 continue;
             }
 
-            std::cerr << "NotificationReactor: epoll_wait failed: "
-                      << strerror(errno) << std::endl;
+            NETX_LOG(LogLevel::Error, "NotificationReactor: epoll_wait failed: "
+                     << strerror(errno));
             continue;
         }
 
+        if (n > 0) {
+            _wakeups_metric->inc();
+            _events_metric->inc(static_cast<std::uint64_t>(n));
+        }
+
+        const std::int64_t slow_nanos =
+            slow_handler_threshold_nanos.load(std::memory_order_relaxed);
+
         for (int i = 0; i < n; ++i) {
             int fd = events[i].data.fd;
             uint32_t ev = events[i].events;
 
             std::shared_ptr<NetconfClient> client;
+            std::shared_ptr<Handler> stats;
 
             {
                 std::lock_guard<std::mutex> guard(_mtx);
@@ -120,11 +202,13 @@ void NotificationReactor::loop() {
                     continue;
                 }
 
-                client = it->second.lock();
+                client = it->second.client.lock();
+                stats = it->second.stats;
 
                 if (!client) {
                     epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
                     _handlers.erase(it);
+                    _fds_metric->set(static_cast<std::int64_t>(_handlers.size()));
                     continue;
                 }
             }
@@ -133,11 +217,11 @@ void NotificationReactor::loop() {
                 try {
                     NotificationReactorManager::instance().remove(fd);
                 } catch (const std::exception& e) {
-                    std::cerr << "NotificationReactor: manager remove failed for FD "
-                              << fd << ": " << e.what() << std::endl;
+                    NETX_LOG(LogLevel::Warning, "NotificationReactor: manager remove failed for FD "
+                             << fd << ": " << e.what());
                 } catch (...) {
-                    std::cerr << "NotificationReactor: manager remove failed for FD "
-                              << fd << ": unknown error" << std::endl;
+                    NETX_LOG(LogLevel::Warning, "NotificationReactor: manager remove failed for FD "
+                             << fd << ": unknown error");
                 }
 
                 try {
@@ -156,32 +240,165 @@ void NotificationReactor::loop() {
             };
 
             if (ev & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
-                std::cerr << "NotificationReactor: notification FD "
-                          << fd << " closed or errored; cleaning up"
-                          << std::endl;
+                NETX_LOG(LogLevel::Warning, "NotificationReactor: notification FD "
+                         << fd << " closed or errored; cleaning up");
 
                 cleanup_dead_fd();
                 continue;
             }
 
+            const Clock::time_point started = Clock::now();
+            std::size_t bytes = 0;
             try {
-                client->on_notification_ready(fd);
+                bytes = client->on_notification_ready(fd);
             } catch (const std::exception& e) {
-                std::cerr << "NotificationReactor: notification read failed on FD "
-                          << fd << ": " << e.what()
-                          << "; cleaning up"
-                          << std::endl;
+                NETX_LOG(LogLevel::Warning, "NotificationReactor: notification read failed on FD "
+                         << fd << ": " << e.what()
+                         << "; cleaning up");
 
                 cleanup_dead_fd();
                 continue;
             } catch (...) {
-                std::cerr << "NotificationReactor: unknown notification read failure on FD "
-                          << fd << "; cleaning up"
-                          << std::endl;
+                NETX_LOG(LogLevel::Warning, "NotificationReactor: unknown notification read failure on FD "
+                         << fd << "; cleaning up");
 
                 cleanup_dead_fd();
                 continue;
             }
+            const Clock::time_point finished = Clock::now();
+
+            const std::uint64_t nanos = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count());
+            const std::uint64_t lag_nanos = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(started - woke).count());
+            const bool slow = slow_nanos > 0 && nanos >= static_cast<std::uint64_t>(slow_nanos);
+
+            PYNETX_PROBE4(reactor__handler, stats->label.c_str(), fd, bytes, nanos);
+            if (TraceRecorder::enabled()) {
+                TraceRecorder::record("reactor", "handler", started, finished,
+                                      stats->label.c_str(), "bytes",
+                                      static_cast<std::int64_t>(bytes));
+            }
+
+            stats->duration_metric->observe_nanos(nanos);
+            stats->bytes_metric->inc(bytes);
+            _dispatch_lag_metric->observe_nanos(lag_nanos);
+
+            if (slow) {
+                stats->slow_metric->inc();
+                ++stats->slow_since_event;
+                if (stats->last_slow_event == Clock::time_point{} ||
+                    finished - stats->last_slow_event >= SLOW_EVENT_INTERVAL) {
+                    client->report_slow_notification_handler(
+                        fd,
+                        std::chrono::nanoseconds(nanos),
+                        std::chrono::nanoseconds(slow_nanos),
+                        stats->slow_since_event
+                    );
+                    stats->last_slow_event = finished;
+                    stats->slow_since_event = 0;
+                }
+            }
+
+            calls.push_back(Call{std::move(stats), lag_nanos, nanos, bytes, slow});
+        }
+
+        if (n <= 0) {
+            continue;
+        }
+
+        std::size_t wakeup_bytes = 0;
+        for (const Call& call : calls) {
+            wakeup_bytes += call.bytes;
+        }
+        _bytes_metric->inc(wakeup_bytes);
+        PYNETX_PROBE3(reactor__wakeup, _id, n, wakeup_bytes);
+
+        if (TraceRecorder::enabled()) {
+            TraceRecorder::record("reactor", "wakeup", woke, Clock::now(),
+                                  nullptr, "events", n);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(_stats_mtx);
+
+            _events_per_wakeup[static_cast<std::size_t>(n)]++;
+            _bytes += wakeup_bytes;
+            _max_bytes_per_wakeup = std::max<std::uint64_t>(_max_bytes_per_wakeup, wakeup_bytes);
+
+            for (const Call& call : calls) {
+                Handler& handler = *call.stats;
+                handler.calls++;
+                handler.bytes += call.bytes;
+                handler.busy_nanos += call.nanos;
+                handler.histogram.record(call.nanos);
+                if (call.slow) {
+                    handler.slow++;
+                }
+                _busy_nanos += call.nanos;
+                _dispatch_lag.record(call.lag_nanos);
+            }
         }
+        calls.clear();
     }
 }
+
+ReactorStatsSnapshot NotificationReactor::snapshot() const {
+    std::vector<std::pair<int, std::shared_ptr<Handler>>> watched;
+    {
+        std::lock_guard<std::mutex> guard(_mtx);
+        watched.reserve(_handlers.size());
+        for (const auto& entry : _handlers) {
+            watched.emplace_back(entry.first, entry.second.stats);
+        }
+    }
+
+    ReactorStatsSnapshot snap;
+    snap.reactor = _id;
+    snap.uptime_seconds = std::chrono::duration<double>(Clock::now() - _started).count();
+    snap.wakeups = _wakeups_metric->value();
+    snap.events = _events_metric->value();
+    snap.handlers.reserve(watched.size());
+
+    std::lock_guard<std::mutex> guard(_stats_mtx);
+    snap.busy_seconds = static_cast<double>(_busy_nanos) / 1e9;
+    snap.bytes = _bytes;
+    snap.max_bytes_per_wakeup = _max_bytes_per_wakeup;
+    snap.events_per_wakeup = _events_per_wakeup;
+    snap.dispatch_lag = summarize_latency(_dispatch_lag);
+
+    for (const auto& entry : watched) {
+        const Handler& handler = *entry.second;
+        ReactorHandlerStats stats;
+        stats.fd = entry.first;
+        stats.label = handler.label;
+        stats.hostname = handler.hostname;
+        stats.port = handler.port;
+        stats.calls = handler.calls;
+        stats.bytes = handler.bytes;
+        stats.slow = handler.slow;
+        stats.busy_seconds = static_cast<double>(handler.busy_nanos) / 1e9;
+        stats.handler = summarize_latency(handler.histogram);
+        snap.handlers.push_back(std::move(stats));
+    }
+
+    std::sort(snap.handlers.begin(), snap.handlers.end(),
+              [](const ReactorHandlerStats& a, const ReactorHandlerStats& b) {
+                  return a.busy_seconds > b.busy_seconds;
+              });
+    return snap;
+}
+
+void NotificationReactor::set_slow_handler_threshold(std::chrono::microseconds threshold) {
+    if (threshold.count() < 0) {
+        throw std::invalid_argument("slow handler threshold must not be negative");
+    }
+    slow_handler_threshold_nanos.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(threshold).count(),
+        std::memory_order_relaxed);
+}
+
+std::chrono::microseconds NotificationReactor::slow_handler_threshold() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::nanoseconds(slow_handler_threshold_nanos.load(std::memory_order_relaxed)));
+}
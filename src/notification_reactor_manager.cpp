@@ -132,4 +132,17 @@ void NotificationReactorManager::remove(int fd) {
     if (idx < device_counts_.size() && device_counts_[idx] > 0) {
         device_counts_[idx]--;
     }
-}
\ No newline at end of file
+}
+
+std::vector<ReactorStatsSnapshot> NotificationReactorManager::stats() {
+    std::lock_guard<std::mutex> lk(mtx_);
+
+    std::vector<ReactorStatsSnapshot> out;
+    out.reserve(reactors_.size());
+    for (const auto& reactor : reactors_) {
+        if (reactor) {
+            out.push_back(reactor->snapshot());
+        }
+    }
+    return out;
+}
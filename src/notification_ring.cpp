@@ -0,0 +1,183 @@
+#include "notification_ring.hpp"
+
+constexpr std::size_t NotificationRing::DEFAULT_CAPACITY;
+constexpr std::size_t NotificationRing::MAX_CAPACITY;
+
+namespace {
+    std::size_t ring_capacity(std::size_t requested) {
+        if (requested > NotificationRing::MAX_CAPACITY) {
+            requested = NotificationRing::MAX_CAPACITY;
+        }
+        std::size_t result = 2;
+        while (result < requested) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+NotificationRing::NotificationRing(std::size_t capacity)
+    : capacity_(ring_capacity(capacity)),
+      mask_(capacity_ - 1)
+{
+}
+
+std::size_t NotificationRing::capacity_for_queue_limit(int max_size) {
+    if (max_size < 0) {
+        return DEFAULT_CAPACITY;
+    }
+    return static_cast<std::size_t>(max_size);
+}
+
+void NotificationRing::push(std::string&& item) {
+    // The producer is the only writer of spill_size_ increments, so observing
+    // zero here means the overflow really is empty.
+    bool spill = spill_size_.load(std::memory_order_acquire) > 0;
+
+    if (!spill) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+
+        if (!slots_) {
+            slots_.reset(new std::string[capacity_]);
+        }
+        if (tail - head < capacity_) {
+            slots_[tail & mask_] = std::move(item);
+            tail_.store(tail + 1, std::memory_order_release);
+        } else {
+            spill = true;
+        }
+    }
+
+    if (spill) {
+        std::lock_guard<std::mutex> lk(spill_mtx_);
+        spill_.push_back(std::move(item));
+        spill_size_.fetch_add(1, std::memory_order_release);
+    }
+
+    signal_one();
+}
+
+// Consumers load spill_size_ before tail_. The producer fills the ring
+// before it starts spilling, so when the overflow is seen non-empty the tail
+// loaded after it covers every ring item older than the overflow, and the
+// ring is drained first.
+
+bool NotificationRing::try_pop(std::string& out) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const bool spilled = spill_size_.load(std::memory_order_acquire) > 0;
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+
+    if (head != tail) {
+        std::string& slot = slots_[head & mask_];
+        out = std::move(slot);
+        std::string().swap(slot);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    if (!spilled) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(spill_mtx_);
+    if (spill_.empty()) {
+        return false;
+    }
+
+    out = std::move(spill_.front());
+    spill_.pop_front();
+    spill_size_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+std::size_t NotificationRing::pop_bulk(
+    std::vector<std::string>& out,
+    std::size_t max_items
+) {
+    std::size_t moved = 0;
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    const bool spilled = spill_size_.load(std::memory_order_acquire) > 0;
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+
+    for (; head != tail && moved < max_items; ++head, ++moved) {
+        std::string& slot = slots_[head & mask_];
+        out.push_back(std::move(slot));
+        std::string().swap(slot);
+    }
+    head_.store(head, std::memory_order_release);
+
+    // Only touch the overflow once the ring is fully drained, otherwise newer
+    // spilled items would overtake older ring items.
+    if (!spilled || moved >= max_items || head != tail) {
+        return moved;
+    }
+
+    std::lock_guard<std::mutex> lk(spill_mtx_);
+    while (!spill_.empty() && moved < max_items) {
+        out.push_back(std::move(spill_.front()));
+        spill_.pop_front();
+        spill_size_.fetch_sub(1, std::memory_order_release);
+        ++moved;
+    }
+
+    return moved;
+}
+
+void NotificationRing::snapshot(std::vector<std::string>& out, std::size_t limit) const {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const bool spilled = spill_size_.load(std::memory_order_acquire) > 0;
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+
+    for (std::size_t i = head; i != tail && out.size() < limit; ++i) {
+        out.push_back(slots_[i & mask_]);
+    }
+
+    if (!spilled || out.size() >= limit) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lk(spill_mtx_);
+    for (auto it = spill_.begin(); it != spill_.end() && out.size() < limit; ++it) {
+        out.push_back(*it);
+    }
+}
+
+void NotificationRing::clear() {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+
+    for (; head != tail; ++head) {
+        std::string().swap(slots_[head & mask_]);
+    }
+    head_.store(tail, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lk(spill_mtx_);
+        spill_.clear();
+        spill_size_.store(0, std::memory_order_release);
+    }
+
+    wake_all();
+}
+
+bool NotificationRing::wait_until(std::chrono::steady_clock::time_point deadline) {
+    return ready_.wait_until([this]() { return !empty(); }, deadline);
+}
+
+std::size_t NotificationRing::size() const noexcept {
+    // Load head first: head never passes tail, so tail - head cannot wrap.
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    return (tail - head) + spill_size_.load(std::memory_order_acquire);
+}
+
+void NotificationRing::signal_one() noexcept {
+    ready_.notify_one();
+    readable_.notify();
+}
+
+void NotificationRing::wake_all() noexcept {
+    ready_.notify_all();
+    readable_.notify(true);
+}
@@ -0,0 +1,328 @@
+#include "notification_stream.hpp"
+#include "netconf_client.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+constexpr std::int64_t NotificationStream::DEFAULT_MAX_BYTES;
+
+std::shared_ptr<NotificationStream> NotificationStream::get(
+    const std::string& name,
+    std::int64_t max_bytes
+) {
+    if (name.empty()) {
+        throw NetconfException("notification stream name cannot be empty");
+    }
+    if (max_bytes < -1 || max_bytes == 0) {
+        throw NetconfException("max_bytes must be -1 to keep the current budget or greater than 0");
+    }
+
+    // Intentionally leaked for the same reason as NotificationEventBus: reactor
+    // threads may still publish during interpreter shutdown.
+    static std::mutex* registry_mtx = new std::mutex();
+    static auto* registry =
+        new std::unordered_map<std::string, std::shared_ptr<NotificationStream>>();
+
+    std::lock_guard<std::mutex> lk(*registry_mtx);
+
+    auto it = registry->find(name);
+    if (it == registry->end()) {
+        auto stream = std::make_shared<NotificationStream>(
+            name,
+            max_bytes > 0 ? max_bytes : DEFAULT_MAX_BYTES
+        );
+        registry->emplace(name, stream);
+        return stream;
+    }
+
+    if (max_bytes > 0) {
+        it->second->set_max_bytes(max_bytes);
+    }
+    return it->second;
+}
+
+NotificationStream::NotificationStream(std::string name, std::int64_t max_bytes)
+    : name_(std::move(name)),
+      max_bytes_(max_bytes),
+      head_(nullptr),
+      tail_(nullptr)
+{
+    if (max_bytes <= 0) {
+        throw NetconfException("max_bytes must be greater than 0");
+    }
+
+    Node* stub = new Node();
+    head_.store(stub, std::memory_order_relaxed);
+    tail_ = stub;
+}
+
+NotificationStream::~NotificationStream() {
+    Node* node = tail_;
+    while (node) {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+std::int64_t NotificationStream::record_bytes(const NotificationRecord& record) noexcept {
+    return static_cast<std::int64_t>(
+        sizeof(Node) + record.payload.size() + record.label.size() + record.hostname.size()
+    );
+}
+
+bool NotificationStream::publish(NotificationRecord record, bool& waiters_pending) noexcept {
+    waiters_pending = false;
+
+    const std::int64_t bytes = record_bytes(record);
+    const std::int64_t before = bytes_.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (before + bytes > max_bytes_.load(std::memory_order_relaxed)) {
+        bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Node* node = new (std::nothrow) Node();
+    if (!node) {
+        NETX_LOG(LogLevel::Error,
+                 "NotificationStream: failed to publish notification: out of memory");
+        bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    node->record = std::move(record);
+
+    // Count before linking so the consumer never observes more linked
+    // nodes than count_ reports.
+    count_.fetch_add(1, std::memory_order_release);
+
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+
+    published_.fetch_add(1, std::memory_order_relaxed);
+
+    ready_.notify_one();
+
+    // Pairs with the fence in next_batch_async(): either we see the waiter,
+    // or it sees the node we just linked.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    waiters_pending = waiter_count_.load(std::memory_order_relaxed) > 0;
+    return true;
+}
+
+bool NotificationStream::linked_locked() const noexcept {
+    // count_ is raised before a node is linked, so it can be non-zero while
+    // drain_locked() still finds nothing; only a linked node is worth waking
+    // for.
+    return tail_->next.load(std::memory_order_acquire) != nullptr;
+}
+
+std::size_t NotificationStream::drain_locked(
+    std::vector<NotificationRecord>& out,
+    std::size_t max_items
+) {
+    std::size_t moved = 0;
+    std::int64_t freed = 0;
+
+    while (moved < max_items) {
+        Node* next = tail_->next.load(std::memory_order_acquire);
+        if (!next) {
+            // Either empty, or a producer swapped head_ but has not linked its
+            // node yet; the record is picked up on the next call.
+            break;
+        }
+
+        freed += record_bytes(next->record);
+        out.push_back(std::move(next->record));
+
+        delete tail_;
+        tail_ = next;
+        ++moved;
+    }
+
+    if (moved > 0) {
+        count_.fetch_sub(moved, std::memory_order_release);
+        bytes_.fetch_sub(freed, std::memory_order_relaxed);
+    }
+
+    return moved;
+}
+
+std::vector<NotificationRecord> NotificationStream::next_batch(int max_items, int timeout_ms) {
+    if (max_items < -1 || max_items == 0) {
+        throw NetconfException("max_items must be -1 for all items or greater than 0");
+    }
+    if (timeout_ms < 0) {
+        throw NetconfException("timeout_ms must be >= 0");
+    }
+
+    const std::size_t limit = max_items < 0
+        ? static_cast<std::size_t>(-1)
+        : static_cast<std::size_t>(max_items);
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    std::vector<NotificationRecord> batch;
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lk(consumer_mtx_);
+            batch.reserve(std::min(limit, pending_count()));
+            drain_locked(batch, limit);
+        }
+
+        if (!batch.empty() ||
+            timeout_ms == 0 ||
+            !ready_.wait_until([this]() {
+                std::lock_guard<std::mutex> lk(consumer_mtx_);
+                return linked_locked();
+            }, deadline)) {
+            break;
+        }
+    }
+
+    return batch;
+}
+
+std::future<std::vector<NotificationRecord>> NotificationStream::next_batch_async(
+    int max_items,
+    int timeout_ms
+) {
+    const std::size_t limit = max_items < 0
+        ? static_cast<std::size_t>(-1)
+        : static_cast<std::size_t>(max_items);
+    auto waiter = std::make_shared<Waiter>(limit);
+    std::future<std::vector<NotificationRecord>> fut = waiter->future();
+
+    if (max_items < -1 || max_items == 0) {
+        waiter->fail(std::make_exception_ptr(
+            NetconfException("max_items must be -1 for all items or greater than 0")
+        ));
+        return fut;
+    }
+    if (timeout_ms < 0) {
+        waiter->fail(std::make_exception_ptr(NetconfException("timeout_ms must be >= 0")));
+        return fut;
+    }
+
+    std::vector<NotificationRecord> batch;
+    {
+        std::lock_guard<std::mutex> waiters_lk(waiters_mtx_);
+
+        // Announce the waiter before looking at the list; see publish().
+        waiter_count_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        {
+            std::lock_guard<std::mutex> lk(consumer_mtx_);
+            drain_locked(batch, limit);
+        }
+
+        if (batch.empty() && timeout_ms > 0) {
+            // The timer holds the stream so the waiter always completes.
+            auto self = shared_from_this();
+            std::weak_ptr<Waiter> weak_waiter = waiter;
+            waiter->timer = DeadlineTimer::instance().schedule(
+                DeadlineTimer::Clock::now() + std::chrono::milliseconds(timeout_ms),
+                [self, weak_waiter]() { self->expire_waiter(weak_waiter); }
+            );
+            waiters_.push_back(std::move(waiter));
+            return fut;
+        }
+
+        waiter_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    waiter->complete(std::move(batch));
+    return fut;
+}
+
+void NotificationStream::serve_waiters() noexcept {
+    try {
+        std::vector<std::pair<std::shared_ptr<Waiter>, std::vector<NotificationRecord>>> ready;
+        {
+            std::lock_guard<std::mutex> waiters_lk(waiters_mtx_);
+            std::lock_guard<std::mutex> lk(consumer_mtx_);
+
+            while (!waiters_.empty()) {
+                std::vector<NotificationRecord> batch;
+                drain_locked(batch, waiters_.front()->limit);
+                if (batch.empty()) {
+                    break;
+                }
+                ready.emplace_back(std::move(waiters_.front()), std::move(batch));
+                waiters_.pop_front();
+                waiter_count_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        for (auto& entry : ready) {
+            DeadlineTimer::instance().cancel(entry.first->timer);
+            entry.first->complete(std::move(entry.second));
+        }
+    } catch (const std::exception& e) {
+        // Undelivered records stay queued for the next consumer call.
+        NETX_LOG(LogLevel::Error, "NotificationStream: failed to serve waiters: "
+                 << e.what());
+    }
+}
+
+void NotificationStream::expire_waiter(const std::weak_ptr<Waiter>& weak_waiter) {
+    std::shared_ptr<Waiter> waiter = weak_waiter.lock();
+    if (!waiter) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> waiters_lk(waiters_mtx_);
+        auto it = std::find(waiters_.begin(), waiters_.end(), waiter);
+        if (it == waiters_.end()) {
+            // Already served by publish().
+            return;
+        }
+        waiters_.erase(it);
+        waiter_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    waiter->complete({});
+}
+
+void NotificationStream::clear() {
+    std::vector<NotificationRecord> discarded;
+    {
+        std::lock_guard<std::mutex> lk(consumer_mtx_);
+        drain_locked(discarded, static_cast<std::size_t>(-1));
+    }
+    ready_.notify_all();
+}
+
+void NotificationStream::set_max_bytes(std::int64_t max_bytes) {
+    if (max_bytes <= 0) {
+        throw NetconfException("max_bytes must be greater than 0");
+    }
+    max_bytes_.store(max_bytes, std::memory_order_relaxed);
+}
+
+std::int64_t NotificationStream::max_bytes() const noexcept {
+    return max_bytes_.load(std::memory_order_relaxed);
+}
+
+std::size_t NotificationStream::pending_count() const noexcept {
+    return count_.load(std::memory_order_acquire);
+}
+
+std::int64_t NotificationStream::pending_bytes() const noexcept {
+    return bytes_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t NotificationStream::published_count() const noexcept {
+    return published_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t NotificationStream::dropped_count() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,183 @@
+#include "pooled_allocator.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace {
+    constexpr std::size_t CLASS_COUNT = 4;
+    constexpr std::size_t CLASS_SIZES[CLASS_COUNT] = {64, 128, 256, 512};
+    constexpr std::size_t MAX_CACHED_PER_CLASS = 256;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Home;
+
+    // Precedes every pooled block; padded so the block keeps new's alignment.
+    struct alignas(alignof(std::max_align_t)) BlockHeader {
+        Home* home;  // null when the block was not pooled
+    };
+
+    // One thread's cache. The free lists belong to the owning thread; other
+    // threads only push onto returned[]. Homes are never destroyed: when
+    // their thread exits they wait in an idle list for the next new thread,
+    // so late frees from other threads always have somewhere to go.
+    struct Home {
+        FreeBlock* heads[CLASS_COUNT] = {};
+        std::size_t counts[CLASS_COUNT] = {};
+        std::atomic<FreeBlock*> returned[CLASS_COUNT] = {};
+        Home* nextIdle = nullptr;
+    };
+
+    std::mutex& idle_mutex() {
+        static std::mutex* mtx = new std::mutex();
+        return *mtx;
+    }
+
+    Home*& idle_homes() {
+        static Home* head = nullptr;
+        return head;
+    }
+
+    Home* adopt_home() {
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex());
+            if (Home* home = idle_homes()) {
+                idle_homes() = home->nextIdle;
+                home->nextIdle = nullptr;
+                return home;
+            }
+        }
+        return new Home();
+    }
+
+    void retire_home(Home* home) noexcept {
+        for (std::size_t c = 0; c < CLASS_COUNT; ++c) {
+            while (FreeBlock* block = home->heads[c]) {
+                home->heads[c] = block->next;
+                ::operator delete(reinterpret_cast<BlockHeader*>(block) - 1);
+            }
+            home->counts[c] = 0;
+        }
+        std::lock_guard<std::mutex> lock(idle_mutex());
+        home->nextIdle = idle_homes();
+        idle_homes() = home;
+    }
+
+    struct ThreadHome {
+        Home* home = nullptr;
+        bool retired = false;
+
+        ~ThreadHome() {
+            if (home) {
+                retire_home(home);
+            }
+            home = nullptr;
+            retired = true;
+        }
+    };
+
+    ThreadHome& thread_home() noexcept {
+        static thread_local ThreadHome local;
+        return local;
+    }
+
+    // This thread's cache, adopted on first use. Null once it has been
+    // retired during thread exit.
+    Home* home() {
+        ThreadHome& local = thread_home();
+        if (!local.home && !local.retired) {
+            local.home = adopt_home();
+        }
+        return local.home;
+    }
+
+    // CLASS_COUNT when the request is too large to pool.
+    std::size_t class_for(std::size_t bytes) noexcept {
+        for (std::size_t c = 0; c < CLASS_COUNT; ++c) {
+            if (bytes <= CLASS_SIZES[c]) {
+                return c;
+            }
+        }
+        return CLASS_COUNT;
+    }
+
+    void* new_block(std::size_t c, Home* owner) {
+        auto* header = static_cast<BlockHeader*>(
+            ::operator new(sizeof(BlockHeader) + CLASS_SIZES[c])
+        );
+        header->home = owner;
+        return header + 1;
+    }
+}
+
+void* BlockCache::allocate(std::size_t bytes) {
+    const std::size_t c = class_for(bytes);
+    if (c == CLASS_COUNT) {
+        return ::operator new(bytes);
+    }
+
+    Home* owner = home();
+    if (!owner) {
+        return new_block(c, nullptr);
+    }
+
+    if (!owner->heads[c]) {
+        // Take back everything other threads have returned since last time.
+        FreeBlock* returned = owner->returned[c].exchange(nullptr, std::memory_order_acquire);
+        for (FreeBlock* block = returned; block; block = block->next) {
+            ++owner->counts[c];
+        }
+        owner->heads[c] = returned;
+    }
+
+    if (FreeBlock* block = owner->heads[c]) {
+        owner->heads[c] = block->next;
+        --owner->counts[c];
+        return block;
+    }
+
+    return new_block(c, owner);
+}
+
+void BlockCache::deallocate(void* ptr, std::size_t bytes) noexcept {
+    if (!ptr) {
+        return;
+    }
+
+    const std::size_t c = class_for(bytes);
+    if (c == CLASS_COUNT) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    Home* owner = header->home;
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+
+    if (!owner) {
+        ::operator delete(header);
+        return;
+    }
+
+    if (owner != thread_home().home) {
+        // Only the owner pops, and it takes the whole list at once, so a
+        // plain CAS push cannot suffer ABA.
+        FreeBlock* head = owner->returned[c].load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!owner->returned[c].compare_exchange_weak(
+            head, block, std::memory_order_release, std::memory_order_relaxed));
+        return;
+    }
+
+    if (owner->counts[c] >= MAX_CACHED_PER_CLASS) {
+        ::operator delete(header);
+        return;
+    }
+
+    block->next = owner->heads[c];
+    owner->heads[c] = block;
+    ++owner->counts[c];
+}
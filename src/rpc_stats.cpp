@@ -0,0 +1,128 @@
+#include "rpc_stats.hpp"
+
+constexpr std::chrono::seconds RpcStats::WINDOW;
+
+namespace {
+    bool reached(RpcTrace::Clock::time_point t) noexcept {
+        return t != RpcTrace::Clock::time_point{};
+    }
+
+    std::int64_t between(RpcTrace::Clock::time_point from, RpcTrace::Clock::time_point to) noexcept {
+        if (!reached(from) || !reached(to) || to < from) {
+            return -1;
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+    }
+}
+
+const char* rpc_phase_name(RpcPhase phase) {
+    switch (phase) {
+        case RpcPhase::StrandWait: return "strand_wait";
+        case RpcPhase::PoolQueue: return "pool_queue";
+        case RpcPhase::Write: return "write";
+        case RpcPhase::FirstByte: return "first_byte";
+        case RpcPhase::Transfer: return "transfer";
+        case RpcPhase::ErrorCheck: return "error_check";
+        case RpcPhase::Total: return "total";
+    }
+    return "unknown";
+}
+
+std::int64_t RpcTrace::phase_nanos(RpcPhase phase) const noexcept {
+    switch (phase) {
+        case RpcPhase::StrandWait: return between(submitted, scheduled);
+        case RpcPhase::PoolQueue: return between(scheduled, started);
+        case RpcPhase::Write: return between(started, written);
+        case RpcPhase::FirstByte: return between(written, first_byte);
+        case RpcPhase::Transfer: return between(first_byte, received);
+        case RpcPhase::ErrorCheck: return between(received, finished);
+        case RpcPhase::Total: return between(reached(submitted) ? submitted : started, finished);
+    }
+    return -1;
+}
+
+void RpcStats::rotate_locked(Windows& windows, Clock::time_point now) const {
+    if (now - windows.current_started < WINDOW) {
+        return;
+    }
+    if (now - windows.current_started < 2 * WINDOW) {
+        windows.previous = windows.current;
+        windows.previous_started = windows.current_started;
+        windows.has_previous = true;
+    } else {
+        // Idle for more than a window: nothing recent is left.
+        for (auto& h : windows.previous) {
+            h.clear();
+        }
+        windows.has_previous = false;
+    }
+    for (auto& h : windows.current) {
+        h.clear();
+    }
+    windows.current_started = now;
+}
+
+void RpcStats::record(const RpcTrace& trace) {
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!windows_) {
+        windows_.reset(new Windows());
+        windows_->current_started = now;
+    }
+    rotate_locked(*windows_, now);
+
+    for (std::size_t i = 0; i < RPC_PHASE_COUNT; ++i) {
+        const std::int64_t nanos = trace.phase_nanos(static_cast<RpcPhase>(i));
+        if (nanos >= 0) {
+            windows_->current[i].record(static_cast<std::uint64_t>(nanos));
+        }
+    }
+
+    ++rpcs_;
+    if (trace.failed) {
+        ++failed_;
+    }
+    last_ = trace;
+    has_last_ = true;
+}
+
+RpcStatsSnapshot RpcStats::snapshot() const {
+    RpcStatsSnapshot out;
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    out.rpcs = rpcs_;
+    out.failed = failed_;
+    out.has_last = has_last_;
+    out.last_failed = last_.failed;
+    for (std::size_t i = 0; i < RPC_PHASE_COUNT; ++i) {
+        out.last_nanos[i] = has_last_ ? last_.phase_nanos(static_cast<RpcPhase>(i)) : -1;
+    }
+
+    if (!windows_) {
+        return out;
+    }
+    rotate_locked(*windows_, now);
+
+    const auto since = windows_->has_previous ? windows_->previous_started : windows_->current_started;
+    out.window_seconds = std::chrono::duration<double>(now - since).count();
+
+    for (std::size_t i = 0; i < RPC_PHASE_COUNT; ++i) {
+        LatencyHistogram merged = windows_->current[i];
+        if (windows_->has_previous) {
+            merged.merge(windows_->previous[i]);
+        }
+        out.phases[i] = summarize_latency(merged);
+    }
+    return out;
+}
+
+void RpcStats::reset() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    windows_.reset();
+    rpcs_ = 0;
+    failed_ = 0;
+    last_ = RpcTrace{};
+    has_last_ = false;
+}
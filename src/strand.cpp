@@ -0,0 +1,392 @@
+#include "strand.hpp"
+#include "futex_event.hpp"
+#include "logger.hpp"
+#include "thread_pool_global.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+
+constexpr std::size_t Strand::FREE_ENTRIES;
+
+struct Strand::Waiter {
+    enum State { Waiting, Turn, Help };
+
+    explicit Waiter(bool helps) : helps(helps) {}
+
+    // Turn: the caller owns the strand and runs its call. Help: it owns the
+    // strand and first runs the tasks queued ahead of it.
+    std::atomic<int> state{Waiting};
+    FutexEvent event;
+    // Called from a pool worker, see acquire().
+    const bool helps;
+};
+
+namespace {
+    // Strand whose task or dispatch() call is running on this thread, if any.
+    thread_local const Strand* tlStrand = nullptr;
+    // Timing of that task, until takeTaskTiming() hands it out.
+    thread_local Strand::TaskTiming tlTiming;
+    thread_local bool tlTimingValid = false;
+}
+
+bool Strand::takeTaskTiming(TaskTiming& out) noexcept {
+    if (!tlTimingValid) {
+        return false;
+    }
+    out = tlTiming;
+    tlTimingValid = false;
+    return true;
+}
+
+bool Strand::rejects(TaskPriority priority) {
+    return get_pool().rejects(priority);
+}
+
+bool Strand::runningHere() const noexcept {
+    return tlStrand == this;
+}
+
+Strand::~Strand() {
+    if (backlog_ > 0) {
+        get_pool().subStrandBacklog(backlog_);
+    }
+    for (Entry* list : {head_, free_}) {
+        while (list) {
+            Entry* next = list->next;
+            delete list;
+            list = next;
+        }
+    }
+}
+
+void Strand::appendLocked(PoolTask task, TaskPriority priority,
+                          std::shared_ptr<Waiter> waiter, Clock::time_point enqueued) {
+    Entry* entry = free_;
+    if (entry) {
+        free_ = entry->next;
+        --freeCount_;
+    } else {
+        entry = new Entry();
+    }
+    entry->task = std::move(task);
+    entry->priority = priority;
+    entry->waiter = std::move(waiter);
+    entry->enqueued = enqueued;
+    entry->next = nullptr;
+
+    if (tail_) {
+        tail_->next = entry;
+    } else {
+        head_ = entry;
+    }
+    tail_ = entry;
+    ++queuedByPriority_[static_cast<int>(priority)];
+    ++queued_;
+}
+
+void Strand::popLocked(PoolTask& task, std::shared_ptr<Waiter>& waiter,
+                       Clock::time_point& enqueued) noexcept {
+    Entry* entry = head_;
+    head_ = entry->next;
+    if (!head_) {
+        tail_ = nullptr;
+    }
+    --queuedByPriority_[static_cast<int>(entry->priority)];
+    --queued_;
+
+    task = std::move(entry->task);
+    waiter = std::move(entry->waiter);
+    enqueued = entry->enqueued;
+    if (waiter && waiter->helps) {
+        --helpers_;
+    }
+
+    if (freeCount_ < FREE_ENTRIES) {
+        entry->next = free_;
+        free_ = entry;
+        ++freeCount_;
+    } else {
+        delete entry;
+    }
+}
+
+TaskPriority Strand::urgentLocked() const noexcept {
+    if (queuedByPriority_[static_cast<int>(TaskPriority::Interactive)] > 0) {
+        return TaskPriority::Interactive;
+    }
+    if (queuedByPriority_[static_cast<int>(TaskPriority::Normal)] > 0) {
+        return TaskPriority::Normal;
+    }
+    return TaskPriority::Bulk;
+}
+
+void Strand::syncBacklogLocked() noexcept {
+    const std::size_t backlog = queued_ - (runnerQueued_ ? 1 : 0);
+    if (backlog > backlog_) {
+        get_pool().addStrandBacklog(backlog - backlog_);
+    } else if (backlog < backlog_) {
+        get_pool().subStrandBacklog(backlog_ - backlog);
+    }
+    backlog_ = backlog;
+}
+
+bool Strand::promoteLocked(TaskPriority priority) noexcept {
+    if (!runnerQueued_ || priority >= runnerPriority_) {
+        return false;
+    }
+    // The queued runner sits in a less urgent lane; post another one in this
+    // lane. Whichever of them runs first takes the entry.
+    ++runner_;
+    runnerPriority_ = priority;
+    return true;
+}
+
+void Strand::postPromoted(TaskPriority priority, TaskPriority previous,
+                          std::uint64_t runner, Clock::time_point posted) noexcept {
+    try {
+        auto self = shared_from_this();
+        get_pool().post([self, posted, runner]() { self->runNext(posted, runner); },
+                        priority);
+    } catch (const std::exception& e) {
+        // The runner queued before still does the work, just in its old lane.
+        NETX_LOG(LogLevel::Error, "Strand failed to promote runner: " << e.what());
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (runner_ == runner) {
+            runnerPriority_ = previous;
+        }
+    }
+}
+
+void Strand::push(PoolTask task, TaskPriority priority) {
+    const auto now = Clock::now();
+    bool schedule = false;
+    bool promote = false;
+    TaskPriority previous = TaskPriority::Normal;
+    std::uint64_t runner = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        appendLocked(std::move(task), priority, nullptr, now);
+        if (!scheduled_) {
+            scheduled_ = true;
+            runnerQueued_ = true;
+            runnerPriority_ = priority;
+            schedule = true;
+            ++runner_;
+        } else {
+            previous = runnerPriority_;
+            promote = promoteLocked(priority);
+        }
+        runner = runner_;
+        syncBacklogLocked();
+    }
+
+    if (schedule) {
+        auto self = shared_from_this();
+        get_pool().post([self, now, runner]() { self->runNext(now, runner); }, priority);
+    } else if (promote) {
+        postPromoted(priority, previous, runner, now);
+    }
+}
+
+void Strand::runNext(Clock::time_point posted, std::uint64_t runner) {
+    PoolTask task;
+    std::shared_ptr<Waiter> waiter;
+    Clock::time_point enqueued;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (runner < liveRunner_) {
+            // A promoted runner got here first, or a pool-worker dispatch()
+            // caller took the strand from this one.
+            return;
+        }
+        popLocked(task, waiter, enqueued);
+        runnerQueued_ = false;
+        liveRunner_ = runner_ + 1;
+        syncBacklogLocked();
+        if (waiter) {
+            // Ownership passes to the waiting dispatch() caller, which resumes
+            // scheduling when it is done.
+            waiter->state.store(Waiter::Turn, std::memory_order_release);
+        }
+    }
+
+    if (waiter) {
+        waiter->event.notify_one();
+        return;
+    }
+
+    runTask(task, enqueued, std::max(enqueued, posted));
+    release();
+}
+
+void Strand::runTask(PoolTask& task, Clock::time_point enqueued,
+                     Clock::time_point scheduled) noexcept {
+    const Strand* outer = tlStrand;
+    const TaskTiming outerTiming = tlTiming;
+    const bool outerTimingValid = tlTimingValid;
+    tlStrand = this;
+    tlTiming = TaskTiming{enqueued, scheduled};
+    tlTimingValid = true;
+    try {
+        task();
+    } catch (const std::exception& e) {
+        NETX_LOG(LogLevel::Error, "Strand swallowed exception: " << e.what());
+    } catch (...) {
+        NETX_LOG(LogLevel::Error, "Strand swallowed unknown exception");
+    }
+    tlTiming = outerTiming;
+    tlTimingValid = outerTimingValid;
+    tlStrand = outer;
+    task.reset();
+}
+
+void Strand::acquire() {
+    std::shared_ptr<Waiter> waiter;
+    bool promote = false;
+    TaskPriority previous = TaskPriority::Normal;
+    std::uint64_t runner = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!scheduled_) {
+            scheduled_ = true;
+            return;
+        }
+
+        waiter = std::make_shared<Waiter>(get_pool().onWorker());
+        appendLocked(PoolTask(), TaskPriority::Normal, waiter, Clock::time_point{});
+        if (waiter->helps) {
+            ++helpers_;
+            if (runnerQueued_) {
+                // Nothing is running; take the strand from the queued runner
+                // instead of waiting for a worker to pick it up.
+                runnerQueued_ = false;
+                liveRunner_ = runner_ + 1;
+                waiter->state.store(Waiter::Help, std::memory_order_relaxed);
+            }
+        } else {
+            previous = runnerPriority_;
+            promote = promoteLocked(TaskPriority::Normal);
+            runner = runner_;
+        }
+        syncBacklogLocked();
+    }
+
+    if (promote) {
+        postPromoted(TaskPriority::Normal, previous, runner, Clock::now());
+    }
+
+    for (;;) {
+        waiter->event.wait([&waiter]() {
+            return waiter->state.load(std::memory_order_acquire) != Waiter::Waiting;
+        });
+        if (waiter->state.load(std::memory_order_acquire) == Waiter::Turn ||
+            runAhead(waiter)) {
+            return;
+        }
+    }
+}
+
+bool Strand::runAhead(const std::shared_ptr<Waiter>& waiter) {
+    for (;;) {
+        PoolTask task;
+        std::shared_ptr<Waiter> next;
+        Clock::time_point enqueued;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            popLocked(task, next, enqueued);
+            syncBacklogLocked();
+            if (next == waiter) {
+                return true;
+            }
+            if (next) {
+                // Another dispatch() caller is ahead; hand it the strand and
+                // wait until it is released again.
+                waiter->state.store(Waiter::Waiting, std::memory_order_relaxed);
+                next->state.store(Waiter::Turn, std::memory_order_release);
+            }
+        }
+
+        if (next) {
+            next->event.notify_one();
+            return false;
+        }
+        const auto now = Clock::now();
+        runTask(task, enqueued, std::max(enqueued, now));
+    }
+}
+
+void Strand::release() noexcept {
+    std::shared_ptr<Waiter> next;
+    TaskPriority priority = TaskPriority::Normal;
+    std::uint64_t runner = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!head_) {
+            scheduled_ = false;
+            return;
+        }
+
+        if (head_->waiter) {
+            // Hand over directly; no worker is needed to wake the caller.
+            PoolTask task;
+            Clock::time_point enqueued;
+            popLocked(task, next, enqueued);
+            next->state.store(Waiter::Turn, std::memory_order_release);
+        } else if (helpers_ > 0) {
+            // A pool-worker caller is queued: it runs the tasks ahead of it.
+            for (Entry* entry = head_; entry; entry = entry->next) {
+                if (entry->waiter && entry->waiter->helps) {
+                    next = entry->waiter;
+                    break;
+                }
+            }
+            next->state.store(Waiter::Help, std::memory_order_release);
+        } else {
+            priority = urgentLocked();
+            runnerQueued_ = true;
+            runnerPriority_ = priority;
+            runner = ++runner_;
+        }
+        syncBacklogLocked();
+    }
+
+    if (next) {
+        next->event.notify_one();
+        return;
+    }
+
+    // Yield the worker between tasks so one busy device cannot monopolise it.
+    const auto now = Clock::now();
+    try {
+        auto self = shared_from_this();
+        get_pool().post([self, now, runner]() { self->runNext(now, runner); },
+                        priority);
+    } catch (const std::exception& e) {
+        // Keep the strand moving on this thread rather than stranding its
+        // queued tasks.
+        NETX_LOG(LogLevel::Error, "Strand failed to post runner, running inline: "
+                 << e.what());
+        runNext(now, runner);
+    }
+}
+
+Strand::Turn::Turn(Strand& strand)
+    : strand_(strand),
+      outer_(tlStrand),
+      outerTiming_(tlTiming),
+      outerTimingValid_(tlTimingValid)
+{
+    const auto enqueued = Clock::now();
+    strand_.acquire();
+    tlStrand = &strand_;
+    tlTiming = TaskTiming{enqueued, Clock::now()};
+    tlTimingValid = true;
+}
+
+Strand::Turn::~Turn() {
+    tlTiming = outerTiming_;
+    tlTimingValid = outerTimingValid_;
+    tlStrand = outer_;
+    strand_.release();
+}
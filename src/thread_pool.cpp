@@ -0,0 +1,417 @@
+#include "thread_pool.hpp"
+#include "logger.hpp"
+#include "trace_recorder.hpp"
+#include "usdt_probes.hpp"
+
+#include <chrono>
+#include <string>
+
+constexpr size_t ThreadPool::WORKER_QUEUE_CAPACITY;
+constexpr size_t ThreadPool::MAX_WORKERS;
+constexpr unsigned ThreadPool::BULK_TURN_INTERVAL;
+constexpr unsigned ThreadPool::IDLE_SPINS;
+constexpr int ThreadPool::IDLE_PARK_US;
+
+TaskPriority task_priority_from_string(const std::string& name) {
+    if (name == "interactive") return TaskPriority::Interactive;
+    if (name == "normal") return TaskPriority::Normal;
+    if (name == "bulk") return TaskPriority::Bulk;
+    throw std::invalid_argument(
+        "priority must be 'interactive', 'normal' or 'bulk', got '" + name + "'"
+    );
+}
+
+namespace {
+    // Identifies the pool worker running on this thread, if any.
+    thread_local const ThreadPool* tlPool = nullptr;
+    thread_local size_t tlWorker = 0;
+
+    uint64_t xorshift(uint64_t& state) noexcept {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    uint64_t threadSeed() noexcept {
+        return static_cast<uint64_t>(
+            std::hash<std::thread::id>()(std::this_thread::get_id())
+        ) ^ static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()
+        );
+    }
+}
+
+ThreadPool::ThreadPool(size_t nThreads)
+    : workers_(MAX_WORKERS),
+      stop_{false}
+{
+    if (nThreads == 0) {
+        throw std::invalid_argument("ThreadPool needs at least one worker");
+    }
+    resize(nThreads);
+}
+
+ThreadPool::~ThreadPool() {
+    // Deferred work is still drained on shutdown, like queued work.
+    {
+        std::lock_guard<std::mutex> lock(deferredMtx_);
+        maxQueued_.store(0);
+        admitDeferredLocked();
+    }
+
+    stop_.store(true);
+    workReady_.notify_all();
+
+    // Retiring workers take resizeMtx_ on their way out, so join outside it.
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(resizeMtx_);
+        const size_t slots = slots_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < slots; ++i) {
+            threads.push_back(std::move(workers_[i]->thread));
+        }
+    }
+    for (auto &t : threads)
+        if (t.joinable()) t.join();
+}
+
+void ThreadPool::resize(size_t nThreads) {
+    if (nThreads == 0 || nThreads > MAX_WORKERS) {
+        throw std::invalid_argument(
+            "ThreadPool size must be between 1 and " + std::to_string(MAX_WORKERS)
+        );
+    }
+
+    std::lock_guard<std::mutex> lock(resizeMtx_);
+    if (stop_.load()) {
+        throw std::runtime_error("ThreadPool is stopped");
+    }
+
+    const size_t current = active_.load(std::memory_order_acquire);
+    if (nThreads < current) {
+        // Surplus workers notice on their next loop iteration; parked ones
+        // need a wakeup. Running tasks are not interrupted or waited for.
+        active_.store(nThreads, std::memory_order_release);
+        workReady_.notify_all();
+        return;
+    }
+
+    // Slots must exist before submitters can pick them through active_.
+    for (size_t i = current; i < nThreads; ++i) {
+        if (!workers_[i]) {
+            workers_[i] = std::make_unique<Worker>(threadSeed() + i * 0x9E3779B97F4A7C15ULL);
+            slots_.store(i + 1, std::memory_order_release);
+        }
+    }
+    active_.store(nThreads, std::memory_order_release);
+    for (size_t i = current; i < nThreads; ++i) {
+        startWorker(i);
+    }
+}
+
+void ThreadPool::startWorker(size_t index) {
+    // Called with resizeMtx_ held, after the slot has been allocated.
+    Worker& worker = *workers_[index];
+    if (worker.thread.joinable()) {
+        if (!worker.exited) {
+            // Marked surplus by an earlier shrink but has not retired yet; it
+            // sees the new active_ count and keeps running.
+            return;
+        }
+        // Already past its last queue access and returning.
+        worker.thread.join();
+    }
+
+    worker.exited = false;
+    worker.thread = std::thread([this, index] { workerLoop(index); });
+}
+
+void ThreadPool::set_queue_limit(size_t maxQueued, AdmissionPolicy policy) {
+    std::lock_guard<std::mutex> lock(deferredMtx_);
+    policy_.store(policy);
+    maxQueued_.store(maxQueued);
+    // A raised or removed limit, or a switch to Reject, releases held tasks.
+    admitDeferredLocked();
+    if (policy == AdmissionPolicy::Reject) {
+        while (!deferred_.empty()) {
+            publish(std::move(deferred_.front().first), deferred_.front().second);
+            deferred_.pop_front();
+            deferredSize_.fetch_sub(1);
+        }
+    }
+}
+
+bool ThreadPool::rejects(TaskPriority priority) const noexcept {
+    if (priority == TaskPriority::Interactive ||
+        policy_.load(std::memory_order_relaxed) != AdmissionPolicy::Reject) {
+        return false;
+    }
+    const size_t limit = maxQueued_.load(std::memory_order_relaxed);
+    return limit != 0 &&
+        queued_.load(std::memory_order_relaxed) +
+        strandBacklog_.load(std::memory_order_relaxed) >= limit;
+}
+
+size_t ThreadPool::queued() const noexcept {
+    return queued_.load(std::memory_order_relaxed) +
+        deferredSize_.load(std::memory_order_relaxed) +
+        strandBacklog_.load(std::memory_order_relaxed);
+}
+
+bool ThreadPool::onWorker() const noexcept {
+    return tlPool == this;
+}
+
+uint64_t ThreadPool::executedCount() const noexcept {
+    uint64_t total = 0;
+    const size_t n = slots_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; ++i) {
+        total += workers_[i]->executed.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t ThreadPool::stolenCount() const noexcept {
+    uint64_t total = 0;
+    const size_t n = slots_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; ++i) {
+        total += workers_[i]->stolen.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ThreadPool::submit(Task task, TaskPriority priority) {
+    if (priority != TaskPriority::Interactive &&
+        maxQueued_.load(std::memory_order_relaxed) != 0 &&
+        policy_.load(std::memory_order_relaxed) == AdmissionPolicy::Defer) {
+        std::lock_guard<std::mutex> lock(deferredMtx_);
+        const size_t limit = maxQueued_.load();
+        if (limit != 0 && (!deferred_.empty() || queued_.load() >= limit)) {
+            // Queue behind earlier deferred tasks to keep submission order.
+            deferred_.emplace_back(std::move(task), priority);
+            deferredSize_.fetch_add(1);
+            // A worker may have drained below the limit before it could see
+            // deferredSize_; admitting here closes that window.
+            admitDeferredLocked();
+            return;
+        }
+    }
+
+    publish(std::move(task), priority);
+}
+
+void ThreadPool::admitDeferredLocked() {
+    // Called with deferredMtx_ held.
+    const size_t limit = maxQueued_.load();
+    while (!deferred_.empty() && (limit == 0 || queued_.load() < limit)) {
+        publish(std::move(deferred_.front().first), deferred_.front().second);
+        deferred_.pop_front();
+        deferredSize_.fetch_sub(1);
+    }
+}
+
+void ThreadPool::Lane::push(Task task) {
+    if (!queue.try_push(task)) {
+        std::lock_guard<std::mutex> lock(overflowMtx);
+        overflow.push_back(std::move(task));
+        overflowSize.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool ThreadPool::Lane::take(Task& out) {
+    if (queue.try_pop(out)) {
+        return true;
+    }
+    if (overflowSize.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(overflowMtx);
+        if (!overflow.empty()) {
+            out = std::move(overflow.front());
+            overflow.pop_front();
+            overflowSize.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::publish(Task task, TaskPriority priority) {
+    // seq_cst pairs with the deferredSize_ check in workerLoop.
+    queued_.fetch_add(1);
+
+    if (priority == TaskPriority::Interactive) {
+        interactive_.push(std::move(task));
+        publishes_.fetch_add(1);
+        workReady_.notify_one();
+        return;
+    }
+    if (priority == TaskPriority::Bulk) {
+        bulk_.push(std::move(task));
+        publishes_.fetch_add(1);
+        workReady_.notify_one();
+        return;
+    }
+
+    const size_t active = active_.load(std::memory_order_acquire);
+    size_t target;
+    if (tlPool == this && tlWorker < active) {
+        // Keep follow-up work local to the submitting worker.
+        target = tlWorker;
+    } else {
+        thread_local uint64_t rng = threadSeed() | 1;
+        target = static_cast<size_t>(xorshift(rng) % active);
+    }
+
+    if (!workers_[target]->queue.try_push(task)) {
+        std::lock_guard<std::mutex> lock(overflowMtx_);
+        overflow_.push_back(std::move(task));
+        overflowSize_.fetch_add(1, std::memory_order_release);
+    }
+
+    publishes_.fetch_add(1);
+    workReady_.notify_one();
+}
+
+size_t ThreadPool::pickVictim(Worker& self, size_t slots) noexcept {
+    return static_cast<size_t>(xorshift(self.rng) % slots);
+}
+
+bool ThreadPool::tryTake(size_t index, Task& out) {
+    Worker& self = *workers_[index];
+
+    if (interactive_.take(out)) {
+        return true;
+    }
+
+    // Give bulk work a periodic turn so a steady normal load cannot starve it.
+    if (++self.takes % BULK_TURN_INTERVAL == 0 && bulk_.take(out)) {
+        return true;
+    }
+
+    if (self.queue.try_pop(out)) {
+        return true;
+    }
+
+    if (overflowSize_.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(overflowMtx_);
+        if (!overflow_.empty()) {
+            out = std::move(overflow_.front());
+            overflow_.pop_front();
+            overflowSize_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Random start, then sweep every other slot once, including retired ones
+    // that a submitter raced a shrink into.
+    const size_t n = slots_.load(std::memory_order_acquire);
+    const size_t start = pickVictim(self, n);
+    for (size_t k = 0; k < n; ++k) {
+        const size_t victim = (start + k) % n;
+        if (victim != index && workers_[victim]->queue.try_pop(out)) {
+            self.stolen.store(self.stolen.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return bulk_.take(out);
+}
+
+bool ThreadPool::retireIfSurplus(size_t index) {
+    std::lock_guard<std::mutex> lock(resizeMtx_);
+    if (index < active_.load(std::memory_order_acquire)) {
+        // Grown back before we got here.
+        return false;
+    }
+
+    Worker& self = *workers_[index];
+    size_t migrated = 0;
+    Task task;
+    while (self.queue.try_pop(task)) {
+        std::lock_guard<std::mutex> overflowLock(overflowMtx_);
+        overflow_.push_back(std::move(task));
+        overflowSize_.fetch_add(1, std::memory_order_release);
+        ++migrated;
+    }
+    if (migrated > 0) {
+        workReady_.notify_all();
+    }
+
+    self.exited = true;
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tlPool = this;
+    tlWorker = index;
+    TraceRecorder::set_thread_name("pool-worker-" + std::to_string(index));
+
+    unsigned idleSpins = 0;
+    for (;;) {
+        if (index >= active_.load(std::memory_order_acquire) && retireIfSurplus(index)) {
+            return;
+        }
+
+        // Read before looking for work: a task published after a failed
+        // tryTake() moves it on.
+        const uint32_t publishes = publishes_.load();
+
+        Task task;
+        if (tryTake(index, task)) {
+            idleSpins = 0;
+            // seq_cst pairs with submit(): either it sees the lower count or
+            // we see its deferred task.
+            queued_.fetch_sub(1);
+            if (deferredSize_.load() > 0) {
+                std::lock_guard<std::mutex> lock(deferredMtx_);
+                admitDeferredLocked();
+            }
+            PYNETX_PROBE1(pool__task__start, index);
+            try {
+                TraceSpan span("pool", "task");
+                task();
+            } catch (const std::exception& e) {
+                NETX_LOG(LogLevel::Error, "ThreadPool worker swallowed exception: "
+                         << e.what());
+            } catch (...) {
+                NETX_LOG(LogLevel::Error, "ThreadPool worker swallowed unknown exception");
+            }
+            PYNETX_PROBE1(pool__task__end, index);
+            Worker& self = *workers_[index];
+            self.executed.store(self.executed.load(std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+            continue;
+        }
+
+        // Drain everything that was queued before stopping.
+        if (stop_.load() && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+
+        // queued_ is non-zero while a submitter is still publishing or another
+        // worker has just taken the last task; let it finish instead of spinning.
+        // If that takes longer, or the task is one this worker cannot reach
+        // yet, park until the next publish. The timeout covers a task that
+        // was published but missed by tryTake().
+        if (queued_.load(std::memory_order_acquire) > 0) {
+            if (++idleSpins < IDLE_SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+            idleSpins = 0;
+            workReady_.wait_until([this, index, publishes]() {
+                return publishes_.load() != publishes ||
+                    stop_.load() ||
+                    index >= active_.load(std::memory_order_acquire);
+            }, std::chrono::steady_clock::now() + std::chrono::microseconds(IDLE_PARK_US));
+            continue;
+        }
+
+        workReady_.wait([this, index]() {
+            return queued_.load(std::memory_order_acquire) > 0 ||
+                stop_.load() ||
+                index >= active_.load(std::memory_order_acquire);
+        });
+    }
+}
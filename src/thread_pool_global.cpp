@@ -1,22 +1,73 @@
 #include "thread_pool_global.hpp"
 #include "thread_pool.hpp"
-#include <memory>
+#include "metrics_registry.hpp"
+#include <atomic>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <iostream>
+#include <vector>
 
-static std::unique_ptr<ThreadPool> gThreadPool;
+// Created once and never replaced, so references returned by get_pool() stay
+// valid across set_threadpool_size() calls. Intentionally leaked: worker
+// threads may still be completing futures during interpreter shutdown.
+static std::atomic<ThreadPool*> gThreadPool{nullptr};
+static std::mutex gThreadPoolMtx;
+
+// Export the global pool through MetricsRegistry. The pool is never freed,
+// so neither are its registrations.
+static void registerPoolMetrics(ThreadPool* pool) {
+    MetricsRegistry& registry = MetricsRegistry::instance();
+    auto* registrations = new std::vector<MetricsRegistration>();
+    registrations->push_back(registry.collect(
+        MetricType::Gauge, "pynetx_pool_workers", "Active worker threads", {},
+        [pool]() { return static_cast<double>(pool->size()); }));
+    registrations->push_back(registry.collect(
+        MetricType::Gauge, "pynetx_pool_queued_tasks", "Tasks waiting to start, including deferred and strand-queued ones", {},
+        [pool]() { return static_cast<double>(pool->queued()); }));
+    registrations->push_back(registry.collect(
+        MetricType::Gauge, "pynetx_pool_deferred_tasks", "Tasks held back by the queue limit", {},
+        [pool]() { return static_cast<double>(pool->deferred()); }));
+    registrations->push_back(registry.collect(
+        MetricType::Counter, "pynetx_pool_tasks_executed", "Tasks run by pool workers", {},
+        [pool]() { return static_cast<double>(pool->executedCount()); }));
+    registrations->push_back(registry.collect(
+        MetricType::Counter, "pynetx_pool_tasks_stolen", "Tasks taken from another worker's queue", {},
+        [pool]() { return static_cast<double>(pool->stolenCount()); }));
+}
 
 void init_global_pool(int nThreads) {
-    if (nThreads <= 0) {
+    if (nThreads <= 0 || static_cast<size_t>(nThreads) > ThreadPool::MAX_WORKERS) {
         throw std::runtime_error("Invalid thread pool size");
     }
-    gThreadPool = std::make_unique<ThreadPool>(nThreads);
+
+    std::lock_guard<std::mutex> lock(gThreadPoolMtx);
+    ThreadPool* pool = gThreadPool.load(std::memory_order_acquire);
+    if (pool) {
+        // Resize in place: queued work stays queued and callers never block
+        // on running tasks.
+        pool->resize(static_cast<size_t>(nThreads));
+        return;
+    }
+    pool = new ThreadPool(static_cast<size_t>(nThreads));
+    registerPoolMetrics(pool);
+    gThreadPool.store(pool, std::memory_order_release);
 }
 
 ThreadPool& get_pool() {
-    if (!gThreadPool) {
-        init_global_pool(4);
+    ThreadPool* pool = gThreadPool.load(std::memory_order_acquire);
+    if (!pool) {
+        std::lock_guard<std::mutex> lock(gThreadPoolMtx);
+        pool = gThreadPool.load(std::memory_order_acquire);
+        if (!pool) {
+            pool = new ThreadPool(4);
+            registerPoolMetrics(pool);
+            gThreadPool.store(pool, std::memory_order_release);
+        }
     }
-    return *gThreadPool;
+    return *pool;
+}
+
+int global_pool_size() {
+    return static_cast<int>(get_pool().size());
 }
@@ -0,0 +1,332 @@
+#include "trace_recorder.hpp"
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+constexpr std::size_t TraceRecorder::DEFAULT_EVENTS_PER_THREAD;
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+namespace {
+    constexpr std::size_t DETAIL_SIZE = 48;
+
+    struct TraceEvent {
+        const char* category;
+        const char* name;
+        const char* value_name;
+        std::int64_t value;
+        TraceRecorder::Clock::time_point start;
+        TraceRecorder::Clock::time_point end;
+        bool async;
+        char detail[DETAIL_SIZE];
+    };
+
+    // One thread's ring. The owning thread is the only writer; mtx is taken
+    // by start() and the dump, so it is uncontended while recording.
+    struct ThreadBuffer {
+        std::mutex mtx;
+        std::vector<TraceEvent> ring;
+        std::size_t next = 0;
+        std::size_t size = 0;
+        long tid = 0;
+        std::string thread_name;
+    };
+
+    struct Registry {
+        std::mutex mtx;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        std::size_t capacity = TraceRecorder::DEFAULT_EVENTS_PER_THREAD;
+        TraceRecorder::Clock::time_point started = TraceRecorder::Clock::now();
+    };
+
+    Registry& registry() {
+        // Leaked so threads that outlive static destruction can still record.
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    std::string& thread_name() {
+        static thread_local std::string name;
+        return name;
+    }
+
+    std::shared_ptr<ThreadBuffer>& thread_buffer_slot() {
+        static thread_local std::shared_ptr<ThreadBuffer> buffer;
+        return buffer;
+    }
+
+    ThreadBuffer& thread_buffer() {
+        std::shared_ptr<ThreadBuffer>& buffer = thread_buffer_slot();
+        if (!buffer) {
+            auto created = std::make_shared<ThreadBuffer>();
+            created->tid = static_cast<long>(::syscall(SYS_gettid));
+            created->thread_name = thread_name();
+            if (created->thread_name.empty()) {
+                char os_name[16] = {};
+                ::pthread_getname_np(::pthread_self(), os_name, sizeof(os_name));
+                created->thread_name = os_name;
+            }
+
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mtx);
+            created->ring.resize(reg.capacity);
+            reg.buffers.push_back(created);
+            buffer = std::move(created);
+        }
+        return *buffer;
+    }
+
+    void append_json_string(std::string& out, const char* value) {
+        out += '"';
+        for (const char* p = value; *p; ++p) {
+            const unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += static_cast<char>(c);
+            } else if (c < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out += static_cast<char>(c);
+            }
+        }
+        out += '"';
+    }
+
+    void append_micros(std::string& out, std::int64_t nanos) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(nanos) / 1000.0);
+        out += buf;
+    }
+
+    void append_args(std::string& out, const TraceEvent& event) {
+        if (!event.detail[0] && !event.value_name) {
+            return;
+        }
+        out += ",\"args\":{";
+        if (event.detail[0]) {
+            out += "\"device\":";
+            append_json_string(out, event.detail);
+        }
+        if (event.value_name) {
+            if (event.detail[0]) {
+                out += ',';
+            }
+            append_json_string(out, event.value_name);
+            out += ':' + std::to_string(event.value);
+        }
+        out += '}';
+    }
+
+    std::int64_t nanos_between(TraceRecorder::Clock::time_point from,
+                               TraceRecorder::Clock::time_point to) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+    }
+
+    std::string chrome_json_counted(std::size_t& spans) {
+        Registry& reg = registry();
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        TraceRecorder::Clock::time_point origin;
+        {
+            std::lock_guard<std::mutex> lock(reg.mtx);
+            buffers = reg.buffers;
+            origin = reg.started;
+        }
+
+        const std::string pid = std::to_string(::getpid());
+        std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        std::uint64_t async_id = 0;
+        spans = 0;
+
+        // Each ring is copied out under its lock and formatted afterwards, so
+        // the owning thread is held up for a copy, not for the formatting.
+        std::vector<TraceEvent> events;
+        for (const auto& buffer : buffers) {
+            std::string thread_name;
+            long thread_id = 0;
+            events.clear();
+            {
+                std::lock_guard<std::mutex> lock(buffer->mtx);
+                thread_name = buffer->thread_name;
+                thread_id = buffer->tid;
+
+                // Oldest first.
+                const std::size_t capacity = buffer->ring.size();
+                const std::size_t oldest = (buffer->next + capacity - buffer->size) % capacity;
+                events.reserve(buffer->size);
+                for (std::size_t i = 0; i < buffer->size; ++i) {
+                    const TraceEvent& event = buffer->ring[(oldest + i) % capacity];
+                    // An RPC queued before start() has partial phases; skip it.
+                    if (event.start >= origin) {
+                        events.push_back(event);
+                    }
+                }
+            }
+
+            const std::string tid = std::to_string(thread_id);
+
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" + tid +
+                   ",\"args\":{\"name\":";
+            append_json_string(out, thread_name.c_str());
+            out += "}}";
+
+            for (const TraceEvent& event : events) {
+                ++spans;
+
+                const std::string head = [&]() {
+                    std::string h = ",\"cat\":";
+                    append_json_string(h, event.category);
+                    h += ",\"name\":";
+                    append_json_string(h, event.name);
+                    h += ",\"pid\":" + pid + ",\"tid\":" + tid;
+                    return h;
+                }();
+
+                if (event.async) {
+                    // Begin/end pair; the id only has to be unique in the dump.
+                    const std::string id = ",\"id\":" + std::to_string(++async_id);
+                    out += ",{\"ph\":\"b\"" + head + id + ",\"ts\":";
+                    append_micros(out, nanos_between(origin, event.start));
+                    append_args(out, event);
+                    out += "},{\"ph\":\"e\"" + head + id + ",\"ts\":";
+                    append_micros(out, nanos_between(origin, event.end));
+                    out += '}';
+                    continue;
+                }
+
+                out += ",{\"ph\":\"X\"" + head + ",\"ts\":";
+                append_micros(out, nanos_between(origin, event.start));
+                out += ",\"dur\":";
+                append_micros(out, nanos_between(event.start, event.end));
+                append_args(out, event);
+                out += '}';
+            }
+        }
+
+        out += "]}\n";
+        return out;
+    }
+}
+
+void TraceRecorder::start(std::size_t events_per_thread) {
+    if (events_per_thread == 0) {
+        throw std::invalid_argument("events_per_thread must be greater than 0");
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+
+    // Rings of threads that have exited are only held here; drop them.
+    reg.buffers.erase(
+        std::remove_if(reg.buffers.begin(), reg.buffers.end(),
+                       [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                           return buffer.use_count() == 1;
+                       }),
+        reg.buffers.end());
+
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mtx);
+        buffer->ring.assign(events_per_thread, TraceEvent{});
+        buffer->next = 0;
+        buffer->size = 0;
+    }
+    reg.capacity = events_per_thread;
+    reg.started = Clock::now();
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::stop() noexcept {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(const char* category,
+                           const char* name,
+                           Clock::time_point start,
+                           Clock::time_point end,
+                           const char* detail,
+                           const char* value_name,
+                           std::int64_t value) noexcept {
+    append_event(category, name, start, end, detail, value_name, value, false);
+}
+
+void TraceRecorder::record_async(const char* category,
+                                 const char* name,
+                                 Clock::time_point start,
+                                 Clock::time_point end,
+                                 const char* detail) noexcept {
+    append_event(category, name, start, end, detail, nullptr, 0, true);
+}
+
+void TraceRecorder::append_event(const char* category,
+                                 const char* name,
+                                 Clock::time_point start,
+                                 Clock::time_point end,
+                                 const char* detail,
+                                 const char* value_name,
+                                 std::int64_t value,
+                                 bool async) noexcept {
+    try {
+        ThreadBuffer& buffer = thread_buffer();
+        std::lock_guard<std::mutex> lock(buffer.mtx);
+
+        TraceEvent& event = buffer.ring[buffer.next];
+        event.category = category;
+        event.name = name;
+        event.value_name = value_name;
+        event.value = value;
+        event.start = start;
+        event.end = end;
+        event.async = async;
+        event.detail[0] = '\0';
+        if (detail) {
+            std::strncpy(event.detail, detail, DETAIL_SIZE - 1);
+            event.detail[DETAIL_SIZE - 1] = '\0';
+        }
+
+        buffer.next = (buffer.next + 1) % buffer.ring.size();
+        buffer.size = std::min(buffer.size + 1, buffer.ring.size());
+    } catch (...) {
+        // Tracing must never fail the traced code.
+    }
+}
+
+void TraceRecorder::set_thread_name(const std::string& name) {
+    thread_name() = name;
+    if (const auto& buffer = thread_buffer_slot()) {
+        std::lock_guard<std::mutex> lock(buffer->mtx);
+        buffer->thread_name = name;
+    }
+}
+
+std::string TraceRecorder::chrome_json() {
+    std::size_t spans = 0;
+    return chrome_json_counted(spans);
+}
+
+std::size_t TraceRecorder::write_chrome_json(const std::string& path) {
+    std::size_t spans = 0;
+    const std::string json = chrome_json_counted(spans);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << json;
+    file.close();
+    if (!file) {
+        throw std::runtime_error("cannot write trace to " + path);
+    }
+    return spans;
+}
@@ -0,0 +1,56 @@
+// connect_trace_budget.cpp
+//
+// How ConnectTrace classifies a failure from the phase budget. A phase that
+// runs out of budget failed with a timeout; a phase without a budget, such as
+// a hello read with an infinite read timeout, failed with an error.
+
+#include "connect_stats.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+ConnectFailure failAfter(std::chrono::milliseconds budget, std::chrono::milliseconds elapsed) {
+    ConnectTrace trace(false, std::chrono::seconds(5));
+    trace.enter(ConnectPhase::Hello, budget);
+    std::this_thread::sleep_for(elapsed);
+    trace.fail("no hello");
+    return trace.failure;
+}
+
+} // namespace
+
+int main() {
+    using std::chrono::milliseconds;
+
+    check(failAfter(milliseconds(1), milliseconds(5)) == ConnectFailure::Timeout,
+          "exhausted budget is a timeout");
+    check(failAfter(milliseconds(10000), milliseconds(0)) == ConnectFailure::Error,
+          "failure within budget is an error");
+    check(failAfter(milliseconds(0), milliseconds(5)) == ConnectFailure::Error,
+          "zero budget is no budget");
+    check(failAfter(milliseconds(-1000), milliseconds(5)) == ConnectFailure::Error,
+          "negative budget (infinite read timeout) is no budget");
+
+    ConnectTrace refused(false, milliseconds(-1000));
+    refused.mark_failure(ConnectFailure::Refused);
+    refused.fail("refused");
+    check(refused.failure == ConnectFailure::Refused, "explicit classification is kept");
+
+    if (failures) {
+        return 1;
+    }
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,64 @@
+// metrics_registry_series.cpp
+//
+// Two owners registering the same series, as two clients for the same
+// device label, host and port do. Their values add up, and destroying one
+// leaves the other's contribution in place.
+
+#include "metrics_registry.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+bool rendered(const std::string& sample) {
+    const std::string text = MetricsRegistry::instance().render_openmetrics();
+    return text.find(sample + "\n") != std::string::npos;
+}
+
+} // namespace
+
+int main() {
+    MetricsRegistry& registry = MetricsRegistry::instance();
+    const MetricLabels labels = {{"device", "leaf-01"}, {"host", "10.0.0.1"}, {"port", "830"}};
+
+    MetricsRegistration first = registry.collect(
+        MetricType::Counter, "test_enqueued", "Test counter", labels, []() { return 3.0; });
+    MetricsRegistration second = registry.collect(
+        MetricType::Counter, "test_enqueued", "Test counter", labels, []() { return 4.0; });
+    check(rendered("test_enqueued_total{device=\"leaf-01\",host=\"10.0.0.1\",port=\"830\"} 7"),
+          "collectors with the same labels are summed");
+
+    first.reset();
+    check(rendered("test_enqueued_total{device=\"leaf-01\",host=\"10.0.0.1\",port=\"830\"} 4"),
+          "unregistering one collector keeps the other");
+
+    second.reset();
+    check(!rendered("test_enqueued_total{device=\"leaf-01\",host=\"10.0.0.1\",port=\"830\"} 4"),
+          "the series goes away with its last collector");
+
+    auto a = registry.counter("test_rpcs", "Test shared counter", labels);
+    auto b = registry.counter("test_rpcs", "Test shared counter", labels);
+    check(a == b, "counter() hands out one shared series per label set");
+    a->inc();
+    b->inc();
+    a.reset();
+    check(rendered("test_rpcs_total{device=\"leaf-01\",host=\"10.0.0.1\",port=\"830\"} 2"),
+          "shared counter outlives one of its owners");
+
+    if (failures) {
+        return 1;
+    }
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,135 @@
+// strand_dispatch_from_pool.cpp
+//
+// *_sync calls made from a pool task on a one-worker pool. The strand's
+// earlier calls need a worker, and the only worker is the one making the
+// call, so the caller has to run them itself instead of waiting.
+
+#include "netconf_client.hpp"
+#include "strand.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_global.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+// A call that never finishes is a deadlock; stop before the stuck task
+// touches this test's stack.
+template <class T>
+void requireFinished(std::future<T>& fut, const char* what) {
+    if (fut.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        std::_Exit(1);
+    }
+}
+
+void waitFor(const std::atomic<bool>& flag) {
+    while (!flag.load()) {
+        std::this_thread::yield();
+    }
+}
+
+// The client's strand has async calls queued behind a runner that cannot
+// start while the pool task holds the only worker.
+void syncCallBehindQueuedAsyncCalls() {
+    auto client = std::make_shared<NetconfClient>("127.0.0.1", 830, "admin", "admin");
+    std::atomic<bool> started{false};
+    std::atomic<bool> queued{false};
+    std::vector<std::future<std::string>> pending;
+
+    auto task = get_pool().enqueue([&]() -> bool {
+        started = true;
+        waitFor(queued);
+        try {
+            client->commit_sync();
+        } catch (const NetconfException&) {
+            // Not connected; only the ordering matters here.
+        }
+        for (auto& fut : pending) {
+            if (fut.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    waitFor(started);
+    for (int i = 0; i < 5; ++i) {
+        pending.push_back(client->commit_async());
+    }
+    queued = true;
+
+    requireFinished(task, "commit_sync() from a pool task completes on a one-worker pool");
+    check(task.get(), "earlier async calls complete before the sync call");
+}
+
+// Another thread holds the strand in dispatch() while tasks queue up behind
+// it; releasing it must hand the strand to the waiting pool task, not to a
+// runner that has no worker.
+void dispatchBehindExternalCaller() {
+    auto strand = std::make_shared<Strand>();
+    std::atomic<bool> holding{false};
+    std::atomic<bool> releaseHolder{false};
+    std::vector<int> order;
+
+    std::thread holder([&]() {
+        strand->dispatch([&]() {
+            holding = true;
+            waitFor(releaseHolder);
+            order.push_back(0);
+        });
+    });
+    waitFor(holding);
+
+    std::vector<std::future<void>> pending;
+    for (int i = 1; i <= 3; ++i) {
+        pending.push_back(strand->enqueue([&order, i]() { order.push_back(i); }));
+    }
+    std::atomic<bool> started{false};
+    auto task = get_pool().enqueue([&]() {
+        started = true;
+        strand->dispatch([&]() { order.push_back(4); });
+    });
+    waitFor(started);
+    // Let the pool task park behind the queued calls.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    releaseHolder = true;
+    holder.join();
+
+    requireFinished(task, "dispatch() from a pool task completes after the holder releases");
+    for (auto& fut : pending) {
+        requireFinished(fut, "queued task completes");
+    }
+    check(order == std::vector<int>({0, 1, 2, 3, 4}), "strand keeps FIFO order");
+}
+
+} // namespace
+
+int main() {
+    init_global_pool(1);
+    syncCallBehindQueuedAsyncCalls();
+    dispatchBehindExternalCaller();
+
+    if (failures) {
+        return 1;
+    }
+    std::puts("ok");
+    return 0;
+}
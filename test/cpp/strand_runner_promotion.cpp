@@ -0,0 +1,139 @@
+// strand_runner_promotion.cpp
+//
+// A strand's runner is posted in the lane of the call that scheduled it. An
+// interactive call that arrives while that runner still waits in the bulk
+// lane must not wait behind normal pool work; the strand posts a promoted
+// runner in the interactive lane.
+
+#include "strand.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_global.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+template <class T>
+void requireFinished(std::future<T>& fut, const char* what) {
+    if (fut.wait_for(std::chrono::seconds(10)) != std::future_status::ready) {
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        std::_Exit(1);
+    }
+}
+
+void waitFor(const std::atomic<bool>& flag) {
+    while (!flag.load()) {
+        std::this_thread::yield();
+    }
+}
+
+class Order {
+public:
+    void add(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        names_.push_back(name);
+    }
+
+    std::vector<std::string> get() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return names_;
+    }
+
+private:
+    std::mutex mtx_;
+    std::vector<std::string> names_;
+};
+
+// Holds the only worker so every submission below stays queued.
+std::future<void> blockWorker(std::atomic<bool>& started, std::atomic<bool>& done) {
+    auto fut = get_pool().enqueue([&started, &done]() {
+        started = true;
+        waitFor(done);
+    });
+    waitFor(started);
+    return fut;
+}
+
+void interactiveCallPromotesBulkRunner() {
+    auto strand = std::make_shared<Strand>();
+    Order order;
+    std::atomic<bool> started{false};
+    std::atomic<bool> done{false};
+    auto blocker = blockWorker(started, done);
+
+    auto bulk = strand->enqueue([&order]() { order.add("strand-bulk"); },
+                                TaskPriority::Bulk);
+    auto normal = get_pool().enqueue([&order]() { order.add("pool-normal"); });
+    auto interactive = strand->enqueue([&order]() { order.add("strand-interactive"); },
+                                       TaskPriority::Interactive);
+    done = true;
+
+    requireFinished(blocker, "blocking task completes");
+    requireFinished(bulk, "bulk strand task completes");
+    requireFinished(normal, "normal pool task completes");
+    requireFinished(interactive, "interactive strand task completes");
+    check(order.get() == std::vector<std::string>(
+              {"strand-bulk", "strand-interactive", "pool-normal"}),
+          "promoted runner runs the strand, in FIFO order, before normal work");
+}
+
+// The superseded bulk runner must not run a task of its own, even once the
+// strand has moved on to later calls.
+void supersededRunnerStaysIdle() {
+    auto strand = std::make_shared<Strand>();
+    Order order;
+    std::atomic<bool> started{false};
+    std::atomic<bool> done{false};
+    auto blocker = blockWorker(started, done);
+
+    auto first = strand->enqueue([&order]() { order.add("a"); }, TaskPriority::Bulk);
+    auto second = strand->enqueue([&order]() { order.add("b"); },
+                                  TaskPriority::Interactive);
+    auto third = strand->enqueue([&order]() { order.add("c"); }, TaskPriority::Bulk);
+    done = true;
+
+    requireFinished(blocker, "blocking task completes");
+    requireFinished(first, "first strand task completes");
+    requireFinished(second, "second strand task completes");
+    requireFinished(third, "third strand task completes");
+    check(order.get() == std::vector<std::string>({"a", "b", "c"}),
+          "strand keeps FIFO order across a promotion");
+
+    // Let the stale runner reach the worker, then check the strand still
+    // schedules later calls.
+    auto after = strand->enqueue([&order]() { order.add("d"); }, TaskPriority::Bulk);
+    requireFinished(after, "strand task after a promotion completes");
+    check(order.get().size() == 4, "each task ran exactly once");
+}
+
+} // namespace
+
+int main() {
+    init_global_pool(1);
+    interactiveCallPromotesBulkRunner();
+    supersededRunnerStaysIdle();
+
+    if (failures) {
+        return 1;
+    }
+    std::puts("ok");
+    return 0;
+}
@@ -11,6 +11,8 @@ import pytest
 
 paramiko = pytest.importorskip("paramiko")
 
+from netconf_fleet_simulator import shared_host_key  # noqa: E402  (needs paramiko)
+
 NETCONF_EOM = "]]>]]>"
 
 SERVER_HELLO = (
@@ -107,7 +109,7 @@ class FakeNetconfSSHServer:
         self.reply_chunk_size = reply_chunk_size
         self.reply_chunk_delay = reply_chunk_delay
 
-        self._host_key = paramiko.RSAKey.generate(2048)
+        self._host_key = shared_host_key()
         self._stop = threading.Event()
         self._ready = threading.Event()
         self._records_lock = threading.Lock()
@@ -0,0 +1,669 @@
+"""Many simulated NETCONF-over-SSH devices served from one process.
+
+`FakeNetconfSSHServer` models one device with a handler thread per client.
+This simulator models a fleet: each device has its own listening socket, on
+its own port and optionally its own loopback address. Every NETCONF session
+is served by one event-loop thread, which reads RPCs, schedules replies after
+the device's latency and jitter, and sends notification floods at the
+device's rate. Paramiko still runs one transport thread per SSH connection
+for the handshake and packet I/O. Nothing else adds a thread per device, and
+all devices share a single host key.
+
+Per-device behaviour comes from `DeviceProfile`: reply size, latency and
+jitter, notification rate and size, and malformed-frame injection. The
+injected frames are the same cases the client's stream parser recovers from:
+a notification without an EOM, a truncated notification, orphan bytes, an
+empty EOM frame, and an EOM-delimited frame that is not XML.
+
+Run standalone to serve a fleet to an external tool:
+
+    python test/netconf_fleet_simulator.py --devices 500 --notification-rate 20
+
+It prints one JSON line per device endpoint and then serves until interrupted.
+"""
+
+from __future__ import annotations
+
+import argparse
+import heapq
+import itertools
+import json
+import os
+import random
+import re
+import selectors
+import socket
+import threading
+import time
+from dataclasses import dataclass, field, replace
+from datetime import datetime, timezone
+from typing import Callable, Sequence
+
+import paramiko
+
+NETCONF_EOM = "]]>]]>"
+_EOM_BYTES = NETCONF_EOM.encode("ascii")
+
+SERVER_HELLO = (
+    '<?xml version="1.0" encoding="UTF-8"?>'
+    '<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">'
+    '<capabilities>'
+    '<capability>urn:ietf:params:netconf:base:1.0</capability>'
+    '<capability>urn:ietf:params:netconf:capability:writable-running:1.0</capability>'
+    '<capability>urn:ietf:params:netconf:capability:candidate:1.0</capability>'
+    '<capability>urn:ietf:params:xml:ns:netconf:notification:1.0</capability>'
+    '</capabilities>'
+    '<session-id>{session_id}</session-id>'
+    '</hello>'
+    + NETCONF_EOM
+)
+
+MALFORMED_KINDS = ("missing_eom", "truncated", "orphan_bytes", "empty_frame", "not_xml")
+
+_MESSAGE_ID = re.compile(r'message-id="([^"]*)"')
+_GET_RPC = re.compile(r"<(?:[\w.-]+:)?get(?:-config)?[\s/>]")
+
+_host_key_lock = threading.Lock()
+_host_key: paramiko.PKey | None = None
+
+
+def shared_host_key() -> paramiko.PKey:
+    """Return the process-wide host key, generating it on first use.
+
+    RSA-2048 generation takes a noticeable fraction of a second, so it is paid
+    once per process rather than once per server or device.
+    """
+    global _host_key
+    with _host_key_lock:
+        if _host_key is None:
+            _host_key = paramiko.RSAKey.generate(2048)
+        return _host_key
+
+
+@dataclass(frozen=True)
+class DeviceProfile:
+    """How one simulated device behaves."""
+
+    # Approximate size of <get>/<get-config> replies; 0 sends an empty <data/>.
+    reply_bytes: int = 0
+    # Reply delay: latency_ms plus a uniform value in [-jitter_ms, jitter_ms].
+    latency_ms: float = 0.0
+    jitter_ms: float = 0.0
+    # Notifications per second after <create-subscription>; 0 sends none.
+    notification_rate: float = 0.0
+    notification_bytes: int = 256
+    # Replace every Nth notification with a malformed frame; 0 disables.
+    # Kinds rotate through malformed_kinds.
+    malformed_every: int = 0
+    malformed_kinds: tuple[str, ...] = MALFORMED_KINDS
+    # Send replies in chunks of this many bytes; None sends them whole.
+    reply_chunk_size: int | None = None
+
+    def __post_init__(self) -> None:
+        if self.reply_bytes < 0:
+            raise ValueError("reply_bytes must be >= 0")
+        if self.latency_ms < 0 or self.jitter_ms < 0:
+            raise ValueError("latency_ms and jitter_ms must be >= 0")
+        if self.notification_rate < 0:
+            raise ValueError("notification_rate must be >= 0")
+        if self.malformed_every < 0:
+            raise ValueError("malformed_every must be >= 0")
+        unknown = set(self.malformed_kinds) - set(MALFORMED_KINDS)
+        if unknown or not self.malformed_kinds:
+            raise ValueError(f"malformed_kinds must be a non-empty subset of {MALFORMED_KINDS}")
+        if self.reply_chunk_size is not None and self.reply_chunk_size <= 0:
+            raise ValueError("reply_chunk_size must be > 0")
+
+
+@dataclass
+class DeviceStats:
+    connections: int = 0
+    rpcs: int = 0
+    notifications_sent: int = 0
+    malformed_sent: int = 0
+    bytes_sent: int = 0
+
+
+@dataclass
+class SimulatedDevice:
+    index: int
+    host: str
+    port: int
+    profile: DeviceProfile
+    label: str
+    stats: DeviceStats = field(default_factory=DeviceStats)
+
+
+def notification_xml(sequence: int, size: int = 0, *, device: str = "") -> str:
+    """A <notification> of roughly `size` bytes."""
+    head = (
+        '<notification xmlns="urn:ietf:params:xml:ns:netconf:notification:1.0">'
+        f'<eventTime>{datetime.now(timezone.utc).isoformat()}</eventTime>'
+        f'<sequence>{sequence}</sequence>'
+        f'<device>{device}</device>'
+    )
+    tail = '</notification>'
+    filler_bytes = size - len(head) - len(tail)
+    counters = []
+    i = 0
+    while filler_bytes > 0:
+        counter = f'<counter name="c{i}">{sequence * 7919 + i}</counter>'
+        counters.append(counter)
+        filler_bytes -= len(counter)
+        i += 1
+    return head + "".join(counters) + tail
+
+
+def data_reply(message_id: str, size: int) -> str:
+    """An <rpc-reply><data> of roughly `size` bytes."""
+    head = (
+        f'<rpc-reply xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id="{message_id}">'
+        '<data><interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">'
+    )
+    tail = '</interfaces></data></rpc-reply>'
+    entries = []
+    remaining = size - len(head) - len(tail)
+    i = 0
+    while remaining > 0:
+        entry = (
+            f'<interface><name>ge-0/0/{i}</name><description>uplink {i}</description>'
+            '<enabled>true</enabled><mtu>9192</mtu></interface>'
+        )
+        entries.append(entry)
+        remaining -= len(entry)
+        i += 1
+    return head + "".join(entries) + tail + NETCONF_EOM
+
+
+def ok_reply(message_id: str) -> str:
+    return (
+        f'<rpc-reply xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id="{message_id}">'
+        '<ok/></rpc-reply>'
+        + NETCONF_EOM
+    )
+
+
+def malformed_frame(kind: str, sequence: int, size: int) -> str:
+    """Bytes for one injected bad frame. Each kind maps to one parser path."""
+    notification = notification_xml(sequence, size, device="malformed")
+    if kind == "missing_eom":
+        # Recovered when the next notification starts.
+        return notification
+    if kind == "truncated":
+        # Abandoned partial once the next notification starts.
+        return notification[: max(1, len(notification) // 2)]
+    if kind == "orphan_bytes":
+        return "garbage-before-notification" + notification + NETCONF_EOM
+    if kind == "empty_frame":
+        return NETCONF_EOM
+    if kind == "not_xml":
+        return "<notification><broken & not xml" + NETCONF_EOM
+    raise ValueError(f"unknown malformed kind {kind!r}")
+
+
+class _DeviceServerInterface(paramiko.ServerInterface):
+    def __init__(self, simulator: "NetconfFleetSimulator", device: SimulatedDevice):
+        self._simulator = simulator
+        self._device = device
+
+    def check_auth_password(self, username: str, password: str):
+        if username == self._simulator.username and password == self._simulator.password:
+            return paramiko.AUTH_SUCCESSFUL
+        return paramiko.AUTH_FAILED
+
+    def get_allowed_auths(self, username: str) -> str:
+        return "password"
+
+    def check_channel_request(self, kind: str, chanid: int):
+        if kind == "session":
+            return paramiko.OPEN_SUCCEEDED
+        return paramiko.OPEN_FAILED_ADMINISTRATIVELY_PROHIBITED
+
+    def check_channel_subsystem_request(self, channel, name: str) -> bool:
+        if name != "netconf":
+            return False
+        # Runs on the transport thread; the loop thread takes it from here.
+        self._simulator._adopt_channel(self._device, channel)
+        return True
+
+
+class _Session:
+    def __init__(self, device: SimulatedDevice, channel, session_id: int, rng: random.Random):
+        self.device = device
+        self.channel = channel
+        self.session_id = session_id
+        self.rng = rng
+        self.inbox = bytearray()
+        self.outbox = bytearray()
+        self.hello_received = False
+        self.subscribed = False
+        self.closing = False
+        self.closed = False
+        self.reply_due = 0.0
+        self.notification_seq = 0
+        self.notification_started = 0.0
+
+
+class NetconfFleetSimulator:
+    """Serve `devices` simulated NETCONF devices until `close()`.
+
+    `profile` applies to every device; `profile_for(index)` overrides it per
+    device. Device i listens on `addresses[i % len(addresses)]`. The port is
+    `base_port + i` when base_port is set, otherwise an ephemeral port. Any
+    127.0.0.0/8 address works on Linux without extra setup.
+
+    `rpc_responder(device, rpc)` can return a full reply (with EOM) for any
+    RPC. Returning None falls back to the built-in replies: sized <data> for
+    get/get-config, <ok/> for everything else.
+    """
+
+    def __init__(
+        self,
+        devices: int,
+        *,
+        profile: DeviceProfile | None = None,
+        profile_for: Callable[[int], DeviceProfile] | None = None,
+        addresses: Sequence[str] = ("127.0.0.1",),
+        base_port: int = 0,
+        username: str = "admin",
+        password: str = "admin",
+        rpc_responder: Callable[[SimulatedDevice, str], str | None] | None = None,
+        seed: int = 0,
+        listen_backlog: int = 128,
+    ):
+        if devices <= 0:
+            raise ValueError("devices must be > 0")
+        if not addresses:
+            raise ValueError("addresses must not be empty")
+
+        self.username = username
+        self.password = password
+        self.rpc_responder = rpc_responder
+        self._seed = seed
+        self._host_key = shared_host_key()
+
+        base_profile = profile or DeviceProfile()
+        self._selector = selectors.DefaultSelector()
+        self._wake_r, self._wake_w = os.pipe()
+        os.set_blocking(self._wake_r, False)
+        self._selector.register(self._wake_r, selectors.EVENT_READ, ("wake", None))
+
+        self._lock = threading.Lock()
+        self._adopted: list[tuple[SimulatedDevice, object]] = []
+        self._timers: list[tuple[float, int, Callable[[], None]]] = []
+        self._timer_seq = itertools.count()
+        self._session_ids = itertools.count(1)
+        self._sessions: set[_Session] = set()
+        self._transports: list[paramiko.Transport] = []
+        self._stop = threading.Event()
+        self._thread: threading.Thread | None = None
+
+        self.devices: list[SimulatedDevice] = []
+        self._listeners: list[socket.socket] = []
+        try:
+            for index in range(devices):
+                host = addresses[index % len(addresses)]
+                sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+                sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+                sock.bind((host, base_port + index if base_port else 0))
+                sock.listen(listen_backlog)
+                sock.setblocking(False)
+                self._listeners.append(sock)
+
+                device = SimulatedDevice(
+                    index=index,
+                    host=host,
+                    port=sock.getsockname()[1],
+                    profile=profile_for(index) if profile_for else base_profile,
+                    label=f"sim-device-{index:05d}",
+                )
+                self.devices.append(device)
+                self._selector.register(sock, selectors.EVENT_READ, ("listen", device))
+        except Exception:
+            self._close_listeners()
+            raise
+
+    def __enter__(self) -> "NetconfFleetSimulator":
+        self.start()
+        return self
+
+    def __exit__(self, exc_type, exc, tb) -> None:
+        self.close()
+
+    # ----------------------- Public API -------------------------
+
+    def start(self) -> None:
+        self._thread = threading.Thread(target=self._run, name="netconf-fleet-sim", daemon=True)
+        self._thread.start()
+
+    def close(self) -> None:
+        self._stop.set()
+        self._wake()
+        if self._thread is not None:
+            self._thread.join(timeout=5.0)
+        for transport in list(self._transports):
+            try:
+                transport.close()
+            except Exception:
+                pass
+        self._close_listeners()
+        for fd in (self._wake_r, self._wake_w):
+            try:
+                os.close(fd)
+            except OSError:
+                pass
+
+    def set_profile(self, index: int, **changes) -> None:
+        """Change one device's profile; live sessions pick it up on their next event."""
+        device = self.devices[index]
+        device.profile = replace(device.profile, **changes)
+
+    def stats(self) -> dict:
+        totals = DeviceStats()
+        for device in self.devices:
+            for name in vars(totals):
+                setattr(totals, name, getattr(totals, name) + getattr(device.stats, name))
+        result = dict(vars(totals))
+        result["devices"] = len(self.devices)
+        with self._lock:
+            result["open_sessions"] = len(self._sessions)
+        return result
+
+    # ----------------------- Loop thread -------------------------
+
+    def _wake(self) -> None:
+        try:
+            os.write(self._wake_w, b"\0")
+        except OSError:
+            pass
+
+    def _adopt_channel(self, device: SimulatedDevice, channel) -> None:
+        with self._lock:
+            self._adopted.append((device, channel))
+        self._wake()
+
+    def _schedule(self, due: float, callback: Callable[[], None]) -> None:
+        heapq.heappush(self._timers, (due, next(self._timer_seq), callback))
+
+    def _run(self) -> None:
+        while not self._stop.is_set():
+            timeout = 0.25
+            if self._timers:
+                timeout = max(0.0, min(timeout, self._timers[0][0] - time.monotonic()))
+            if any(session.outbox for session in self._sessions):
+                # Paramiko channels only signal readability; retry blocked
+                # sends on a short tick.
+                timeout = min(timeout, 0.002)
+
+            for key, _mask in self._selector.select(timeout):
+                kind, payload = key.data
+                if kind == "wake":
+                    self._drain_wakeups()
+                elif kind == "listen":
+                    self._accept(key.fileobj, payload)
+                else:
+                    self._on_readable(payload)
+
+            now = time.monotonic()
+            while self._timers and self._timers[0][0] <= now:
+                _due, _seq, callback = heapq.heappop(self._timers)
+                callback()
+
+            for session in list(self._sessions):
+                if session.outbox:
+                    self._flush(session)
+
+        for session in list(self._sessions):
+            self._drop(session)
+
+    def _drain_wakeups(self) -> None:
+        try:
+            while os.read(self._wake_r, 4096):
+                pass
+        except BlockingIOError:
+            pass
+        with self._lock:
+            adopted, self._adopted = self._adopted, []
+        for device, channel in adopted:
+            self._open_session(device, channel)
+
+    def _accept(self, listener: socket.socket, device: SimulatedDevice) -> None:
+        while True:
+            try:
+                client_sock, _addr = listener.accept()
+            except (BlockingIOError, InterruptedError):
+                return
+            except OSError:
+                return
+            client_sock.setblocking(True)
+            device.stats.connections += 1
+            try:
+                transport = paramiko.Transport(client_sock)
+                transport.add_server_key(self._host_key)
+                # With an event, start_server() returns at once and the key
+                # exchange runs on the transport's own thread.
+                transport.start_server(
+                    event=threading.Event(),
+                    server=_DeviceServerInterface(self, device),
+                )
+            except Exception:
+                client_sock.close()
+                continue
+            if len(self._transports) >= 256 and len(self._transports) % 256 == 0:
+                # Reconnect-heavy runs would otherwise keep every dead transport.
+                self._transports = [t for t in self._transports if t.is_active()]
+            self._transports.append(transport)
+
+    def _open_session(self, device: SimulatedDevice, channel) -> None:
+        session_id = next(self._session_ids)
+        session = _Session(device, channel, session_id, random.Random(self._seed * 1_000_003 + session_id))
+        channel.setblocking(0)
+        with self._lock:
+            self._sessions.add(session)
+        self._selector.register(channel, selectors.EVENT_READ, ("session", session))
+        self._send(session, SERVER_HELLO.format(session_id=session_id))
+
+    def _on_readable(self, session: _Session) -> None:
+        try:
+            while session.channel.recv_ready():
+                chunk = session.channel.recv(65536)
+                if not chunk:
+                    break
+                session.inbox += chunk
+        except socket.timeout:
+            pass
+        except Exception:
+            self._drop(session)
+            return
+
+        while True:
+            end = session.inbox.find(_EOM_BYTES)
+            if end < 0:
+                break
+            frame = bytes(session.inbox[:end]).decode("utf-8", errors="replace").strip()
+            del session.inbox[: end + len(_EOM_BYTES)]
+            self._on_frame(session, frame)
+
+        if session.channel.closed or session.channel.eof_received:
+            self._drop(session)
+
+    def _on_frame(self, session: _Session, frame: str) -> None:
+        if not session.hello_received:
+            session.hello_received = True
+            return
+        if not frame:
+            return
+
+        device = session.device
+        device.stats.rpcs += 1
+        profile = device.profile
+
+        reply = self.rpc_responder(device, frame) if self.rpc_responder else None
+        if reply is None:
+            match = _MESSAGE_ID.search(frame)
+            message_id = match.group(1) if match else "101"
+            if _GET_RPC.search(frame):
+                reply = data_reply(message_id, profile.reply_bytes)
+            else:
+                reply = ok_reply(message_id)
+
+        delay = profile.latency_ms
+        if profile.jitter_ms:
+            delay += session.rng.uniform(-profile.jitter_ms, profile.jitter_ms)
+        # Replies leave in request order even when jitter would reorder them.
+        due = max(time.monotonic() + max(0.0, delay) / 1000.0, session.reply_due)
+        session.reply_due = due
+
+        subscribe = "<create-subscription" in frame
+        close = "<close-session" in frame
+
+        def send_reply() -> None:
+            self._send(session, reply, chunk_size=profile.reply_chunk_size)
+            if subscribe and not session.subscribed:
+                session.subscribed = True
+                session.notification_started = time.monotonic()
+                self._schedule(session.notification_started, lambda: self._notification_tick(session))
+            if close:
+                session.closing = True
+
+        if due <= time.monotonic():
+            send_reply()
+        else:
+            self._schedule(due, send_reply)
+
+    def _notification_tick(self, session: _Session) -> None:
+        if session.closed:
+            return
+        profile = session.device.profile
+        if profile.notification_rate <= 0:
+            # Re-check later in case set_profile() turns notifications on.
+            self._schedule(time.monotonic() + 0.1, lambda: self._notification_tick(session))
+            return
+
+        # Send everything due since the subscription started, coalesced into
+        # one write; high rates then cost one timer per tick, not per message.
+        now = time.monotonic()
+        target = int((now - session.notification_started) * profile.notification_rate) + 1
+        parts = []
+        device = session.device
+        while session.notification_seq < target:
+            session.notification_seq += 1
+            seq = session.notification_seq
+            if profile.malformed_every and seq % profile.malformed_every == 0:
+                kinds = profile.malformed_kinds
+                kind = kinds[(seq // profile.malformed_every - 1) % len(kinds)]
+                parts.append(malformed_frame(kind, seq, profile.notification_bytes))
+                device.stats.malformed_sent += 1
+            else:
+                parts.append(notification_xml(seq, profile.notification_bytes, device=device.label) + NETCONF_EOM)
+                device.stats.notifications_sent += 1
+        if parts:
+            self._send(session, "".join(parts))
+
+        interval = max(1.0 / profile.notification_rate, 0.005)
+        self._schedule(now + interval, lambda: self._notification_tick(session))
+
+    def _send(self, session: _Session, text: str, *, chunk_size: int | None = None) -> None:
+        if session.closed:
+            return
+        data = text.encode("utf-8")
+        if chunk_size:
+            # Chunks go out as separate writes so the client sees split reads.
+            for offset in range(0, len(data), chunk_size):
+                session.outbox += data[offset : offset + chunk_size]
+                self._flush(session)
+        else:
+            session.outbox += data
+            self._flush(session)
+
+    def _flush(self, session: _Session) -> None:
+        while session.outbox and not session.closed:
+            try:
+                sent = session.channel.send(bytes(session.outbox[:32768]))
+            except socket.timeout:
+                return
+            except Exception:
+                self._drop(session)
+                return
+            if sent <= 0:
+                return
+            del session.outbox[:sent]
+            session.device.stats.bytes_sent += sent
+        if session.closing and not session.outbox:
+            self._drop(session)
+
+    def _drop(self, session: _Session) -> None:
+        if session.closed:
+            return
+        session.closed = True
+        with self._lock:
+            self._sessions.discard(session)
+        try:
+            self._selector.unregister(session.channel)
+        except (KeyError, ValueError):
+            pass
+        try:
+            session.channel.close()
+        except Exception:
+            pass
+
+    def _close_listeners(self) -> None:
+        for sock in self._listeners:
+            try:
+                self._selector.unregister(sock)
+            except (KeyError, ValueError):
+                pass
+            try:
+                sock.close()
+            except OSError:
+                pass
+        self._listeners = []
+
+
+def _parse_args(argv: Sequence[str] | None = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--devices", type=int, default=100)
+    parser.add_argument("--addresses", default="127.0.0.1", help="comma-separated bind addresses")
+    parser.add_argument("--base-port", type=int, default=0, help="device i listens on base_port + i; 0 for ephemeral ports")
+    parser.add_argument("--username", default="admin")
+    parser.add_argument("--password", default="admin")
+    parser.add_argument("--reply-bytes", type=int, default=0)
+    parser.add_argument("--latency-ms", type=float, default=0.0)
+    parser.add_argument("--jitter-ms", type=float, default=0.0)
+    parser.add_argument("--notification-rate", type=float, default=0.0, help="per device, per second")
+    parser.add_argument("--notification-bytes", type=int, default=256)
+    parser.add_argument("--malformed-every", type=int, default=0)
+    parser.add_argument("--seed", type=int, default=0)
+    return parser.parse_args(argv)
+
+
+def main(argv: Sequence[str] | None = None) -> None:
+    args = _parse_args(argv)
+    profile = DeviceProfile(
+        reply_bytes=args.reply_bytes,
+        latency_ms=args.latency_ms,
+        jitter_ms=args.jitter_ms,
+        notification_rate=args.notification_rate,
+        notification_bytes=args.notification_bytes,
+        malformed_every=args.malformed_every,
+    )
+    with NetconfFleetSimulator(
+        args.devices,
+        profile=profile,
+        addresses=[a.strip() for a in args.addresses.split(",") if a.strip()],
+        base_port=args.base_port,
+        username=args.username,
+        password=args.password,
+        seed=args.seed,
+    ) as simulator:
+        for device in simulator.devices:
+            print(json.dumps({"label": device.label, "host": device.host, "port": device.port}), flush=True)
+        try:
+            while True:
+                time.sleep(1.0)
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
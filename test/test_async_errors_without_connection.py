@@ -1,5 +1,8 @@
 from __future__ import annotations
 
+import asyncio
+import socket
+
 import pytest
 
 from conftest import assert_await_raises
@@ -67,3 +70,119 @@ async def test_subscribe_async_to_closed_local_port_raises_netconf_exception(
     )
     assert "Unable to Subscribe to device" in message
     assert not client.is_subscription_active()
+
+
+@pytest.mark.asyncio
+async def test_async_completions_are_pushed_without_polling_delay(make_client, pyNetX_module):
+    client = make_client()
+    loop = asyncio.get_running_loop()
+
+    # Sequential round trips: a polling dispatcher adds its interval to each one.
+    started = loop.time()
+    for _ in range(50):
+        await assert_await_raises(client.commit_async(), pyNetX_module.NetconfException)
+    assert loop.time() - started < 1.0
+
+
+@pytest.mark.asyncio
+async def test_many_concurrent_async_completions_resolve_together(make_client, pyNetX_module):
+    clients = [make_client() for _ in range(20)]
+    results = await asyncio.gather(
+        *(client.commit_async() for client in clients for _ in range(10)),
+        return_exceptions=True,
+    )
+    assert len(results) == 200
+    assert all(isinstance(result, pyNetX_module.NetconfException) for result in results)
+
+
+@pytest.mark.asyncio
+async def test_threadpool_resize_keeps_pending_async_calls(make_client, pyNetX_module):
+    clients = [make_client() for _ in range(10)]
+    try:
+        pending = [client.commit_async() for client in clients for _ in range(20)]
+        pyNetX_module.set_threadpool_size(1)
+        pending += [client.commit_async() for client in clients for _ in range(20)]
+        pyNetX_module.set_threadpool_size(6)
+
+        results = await asyncio.wait_for(asyncio.gather(*pending, return_exceptions=True), 10)
+        assert len(results) == 400
+        assert all(isinstance(result, pyNetX_module.NetconfException) for result in results)
+    finally:
+        pyNetX_module.set_threadpool_size(4)
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("priority", ["interactive", "normal", "bulk"])
+async def test_async_rpc_methods_accept_priority(make_client, pyNetX_module, priority):
+    client = make_client()
+    message = await assert_await_raises(
+        client.get_async(filter="", priority=priority),
+        pyNetX_module.NetconfException,
+    )
+    assert "already not connected" in message
+
+
+def test_unknown_priority_is_rejected_before_submission(make_client):
+    client = make_client()
+    with pytest.raises(ValueError, match="priority must be"):
+        client.commit_async(priority="urgent")
+
+
+def test_threadpool_queue_limit_validates_arguments(pyNetX_module):
+    with pytest.raises(ValueError):
+        pyNetX_module.set_threadpool_queue_limit(-1)
+    with pytest.raises(ValueError, match="policy must be"):
+        pyNetX_module.set_threadpool_queue_limit(10, policy="drop")
+
+
+@pytest.mark.asyncio
+async def test_queue_limit_rejects_bulk_but_admits_interactive(make_client, pyNetX_module):
+    # The listener accepts but never sends an SSH banner, so each connect holds
+    # its client's strand until the handshake times out and later calls wait
+    # in the strand queue.
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as listener:
+        listener.bind(("127.0.0.1", 0))
+        listener.listen(8)
+        port = listener.getsockname()[1]
+
+        clients = [make_client(port=port) for _ in range(4)]
+        connects = [client.connect_async() for client in clients]
+        pyNetX_module.set_threadpool_queue_limit(1, policy="reject")
+        try:
+            bulk = [client.commit_async(priority="bulk") for client in clients for _ in range(10)]
+            interactive = [client.commit_async(priority="interactive") for client in clients]
+
+            bulk_results = await asyncio.wait_for(
+                asyncio.gather(*bulk, return_exceptions=True), 10
+            )
+            interactive_results = await asyncio.wait_for(
+                asyncio.gather(*interactive, return_exceptions=True), 10
+            )
+            await asyncio.wait_for(asyncio.gather(*connects, return_exceptions=True), 10)
+        finally:
+            pyNetX_module.set_threadpool_queue_limit(0)
+
+    # Calls queued behind a busy strand count against the limit, so at most
+    # the first bulk call gets in; interactive calls are never rejected.
+    rejected = [
+        result for result in bulk_results if isinstance(result, pyNetX_module.ThreadPoolFullError)
+    ]
+    assert len(rejected) >= len(bulk_results) - 1
+    assert all("queue is full" in str(result) for result in rejected)
+    assert not any(
+        isinstance(result, pyNetX_module.ThreadPoolFullError) for result in interactive_results
+    )
+
+
+@pytest.mark.asyncio
+async def test_queue_limit_defer_completes_every_call(make_client, pyNetX_module):
+    clients = [make_client() for _ in range(10)]
+    pyNetX_module.set_threadpool_queue_limit(2, policy="defer")
+    try:
+        pending = [client.commit_async(priority="bulk") for client in clients for _ in range(20)]
+        results = await asyncio.wait_for(asyncio.gather(*pending, return_exceptions=True), 10)
+    finally:
+        pyNetX_module.set_threadpool_queue_limit(0)
+
+    assert len(results) == 200
+    assert all("already not connected" in str(result) for result in results)
@@ -1,10 +1,11 @@
 from __future__ import annotations
 
 import asyncio
+import time
 
 import pytest
 
-from fake_netconf_ssh_server import FakeNetconfSSHServer, notification_xml
+from fake_netconf_ssh_server import OK_REPLY, FakeNetconfSSHServer, notification_xml
 from test_integration_fake_netconf_server import disconnect_quietly, make_integration_client
 
 pytestmark = [pytest.mark.integration, pytest.mark.slow]
@@ -41,6 +42,78 @@ async def test_concurrent_raw_rpcs_on_one_client_all_complete_and_are_serialized
         await client.disconnect_async()
 
 
+@pytest.mark.asyncio
+async def test_queued_rpcs_on_a_slow_device_do_not_hold_pool_workers(pyNetX_module):
+    """Each client runs on its own strand, so a backlog on one device uses at
+    most one pool worker and another device is served immediately."""
+
+    def slow_responder(rpc: str) -> str:
+        time.sleep(0.2)
+        return OK_REPLY
+
+    pyNetX_module.set_threadpool_size(2)
+    try:
+        with FakeNetconfSSHServer(rpc_responder=slow_responder) as slow_server:
+            with FakeNetconfSSHServer() as fast_server:
+                slow = make_integration_client(pyNetX_module, slow_server, label="slow-leaf")
+                fast = make_integration_client(pyNetX_module, fast_server, label="fast-leaf")
+                assert await slow.connect_async() is True
+                assert await fast.connect_async() is True
+
+                backlog = [
+                    asyncio.ensure_future(slow.send_rpc_async(f'<rpc message-id="slow-{i}"><get/></rpc>'))
+                    for i in range(5)
+                ]
+                await asyncio.sleep(0.05)
+
+                reply = await asyncio.wait_for(fast.send_rpc_async("<rpc><get/></rpc>"), 0.5)
+                assert "<ok/>" in reply
+                assert not all(task.done() for task in backlog)
+
+                assert all("<ok/>" in r for r in await asyncio.gather(*backlog))
+                await disconnect_quietly(slow)
+                await disconnect_quietly(fast)
+    finally:
+        pyNetX_module.set_threadpool_size(4)
+
+
+@pytest.mark.asyncio
+@pytest.mark.filterwarnings("ignore::DeprecationWarning")
+async def test_sync_calls_run_on_the_caller_thread_while_pool_is_busy(pyNetX_module):
+    """*_sync methods run inline with the GIL released, so they complete even
+    when every pool worker is occupied and do not stall other Python threads."""
+
+    def slow_responder(rpc: str) -> str:
+        time.sleep(1.0)
+        return OK_REPLY
+
+    pyNetX_module.set_threadpool_size(1)
+    try:
+        with FakeNetconfSSHServer(rpc_responder=slow_responder) as slow_server:
+            with FakeNetconfSSHServer() as fast_server:
+                slow = make_integration_client(pyNetX_module, slow_server, label="slow-leaf")
+                assert await slow.connect_async() is True
+                backlog = asyncio.ensure_future(slow.send_rpc_async("<rpc><get/></rpc>"))
+                await asyncio.sleep(0.05)
+
+                fast = make_integration_client(pyNetX_module, fast_server, label="fast-leaf")
+
+                def sync_round_trip() -> str:
+                    assert fast.connect_sync() is True
+                    try:
+                        return fast.send_rpc_sync("<rpc><get/></rpc>")
+                    finally:
+                        fast.disconnect_sync()
+
+                reply = await asyncio.wait_for(asyncio.to_thread(sync_round_trip), 5)
+                assert "<ok/>" in reply
+                assert not backlog.done()
+                assert "<ok/>" in await backlog
+                await disconnect_quietly(slow)
+    finally:
+        pyNetX_module.set_threadpool_size(4)
+
+
 @pytest.mark.asyncio
 async def test_primary_rpc_session_remains_usable_after_notification_subscription(pyNetX_module):
     """Notifications use a separate session; primary RPCs should still work."""
@@ -1,5 +1,7 @@
 from __future__ import annotations
 
+import asyncio
+
 import pytest
 
 from conftest import EXPECTED_HEALTH_EVENT_KEYS, assert_recent_utc_timestamp, assert_await_raises
@@ -80,6 +82,25 @@ async def test_next_notification_event_async_positive_timeout_returns_structured
     assert_timeout_event(event)
 
 
+@pytest.mark.asyncio
+async def test_idle_event_listeners_do_not_occupy_pool_workers(make_client, pyNetX_module):
+    loop = asyncio.get_running_loop()
+    listeners = [
+        asyncio.ensure_future(pyNetX_module.next_notification_event_async(timeout_ms=1500))
+        for _ in range(16)
+    ]
+
+    # Far more listeners than the 4 default workers; RPC traffic still flows.
+    started = loop.time()
+    client = make_client()
+    await assert_await_raises(client.commit_async(), pyNetX_module.NetconfException)
+    assert loop.time() - started < 0.5
+    assert not any(listener.done() for listener in listeners)
+
+    for event in await asyncio.gather(*listeners):
+        assert_timeout_event(event)
+
+
 @pytest.mark.parametrize("timeout_ms", [-2, -100])
 def test_next_notification_event_rejects_invalid_negative_timeout(pyNetX_module, timeout_ms):
     # Synchronous pybind validation failures are currently exposed as RuntimeError.
@@ -126,3 +147,13 @@ def test_threadpool_size_rejects_non_positive_values(pyNetX_module):
         with pytest.raises(RuntimeError) as excinfo:
             pyNetX_module.set_threadpool_size(value)
         assert "Invalid thread pool size" in str(excinfo.value)
+
+
+def test_threadpool_size_can_grow_and_shrink_in_place(pyNetX_module):
+    try:
+        pyNetX_module.set_threadpool_size(8)
+        assert pyNetX_module.get_threadpool_size() == 8
+        pyNetX_module.set_threadpool_size(2)
+        assert pyNetX_module.get_threadpool_size() == 2
+    finally:
+        pyNetX_module.set_threadpool_size(4)
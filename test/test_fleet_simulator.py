@@ -0,0 +1,128 @@
+from __future__ import annotations
+
+import asyncio
+import time
+
+import pytest
+
+pytest.importorskip("paramiko")
+
+from netconf_fleet_simulator import DeviceProfile, NetconfFleetSimulator  # noqa: E402
+from test_integration_fake_netconf_server import disconnect_quietly  # noqa: E402
+
+pytestmark = [pytest.mark.integration, pytest.mark.slow]
+
+
+@pytest.fixture
+def make_device_client(make_client):
+    """Build a client for one simulated device with the shared conftest factory."""
+
+    def _make_device_client(device, simulator, **overrides):
+        kwargs = {
+            "hostname": device.host,
+            "port": device.port,
+            "username": simulator.username,
+            "password": simulator.password,
+            "connect_timeout": 5,
+            "read_timeout": 5,
+            "socket_connect_timeout": 2,
+            "label": device.label,
+        }
+        kwargs.update(overrides)
+        return make_client(**kwargs)
+
+    return _make_device_client
+
+
+def test_device_profile_rejects_invalid_settings():
+    with pytest.raises(ValueError):
+        DeviceProfile(latency_ms=-1)
+    with pytest.raises(ValueError):
+        DeviceProfile(malformed_kinds=("not_a_kind",))
+    with pytest.raises(ValueError):
+        DeviceProfile(reply_chunk_size=0)
+
+
+@pytest.mark.asyncio
+async def test_simulator_serves_devices_on_separate_ports_with_sized_replies(make_device_client):
+    profile = DeviceProfile(reply_bytes=20_000, reply_chunk_size=1500)
+    with NetconfFleetSimulator(8, profile=profile) as simulator:
+        assert len({device.port for device in simulator.devices}) == 8
+
+        clients = [make_device_client(d, simulator) for d in simulator.devices]
+        try:
+            assert all(await asyncio.gather(*(c.connect_async() for c in clients)))
+            replies = await asyncio.gather(*(c.get_async() for c in clients))
+            assert all("<data>" in r and len(r) >= 20_000 for r in replies)
+
+            stats = simulator.stats()
+            assert stats["connections"] >= 8
+            assert stats["rpcs"] == 8
+            assert all(d.stats.rpcs == 1 for d in simulator.devices)
+        finally:
+            await asyncio.gather(*(disconnect_quietly(c) for c in clients))
+
+
+@pytest.mark.asyncio
+async def test_simulator_applies_per_device_latency(make_device_client):
+    def profile_for(index: int) -> DeviceProfile:
+        return DeviceProfile(latency_ms=300.0 if index == 1 else 0.0)
+
+    with NetconfFleetSimulator(2, profile_for=profile_for) as simulator:
+        fast, slow = (make_device_client(d, simulator) for d in simulator.devices)
+        try:
+            await asyncio.gather(fast.connect_async(), slow.connect_async())
+
+            started = time.monotonic()
+            await fast.get_async()
+            fast_elapsed = time.monotonic() - started
+
+            started = time.monotonic()
+            await slow.get_async()
+            slow_elapsed = time.monotonic() - started
+
+            assert slow_elapsed >= 0.3
+            assert slow_elapsed > fast_elapsed
+        finally:
+            await asyncio.gather(disconnect_quietly(fast), disconnect_quietly(slow))
+
+
+@pytest.mark.asyncio
+async def test_simulator_notification_flood_with_injected_malformed_frames(
+    pyNetX_module, make_device_client
+):
+    profile = DeviceProfile(
+        notification_rate=200.0,
+        notification_bytes=400,
+        malformed_every=5,
+        malformed_kinds=("not_xml",),
+    )
+    with NetconfFleetSimulator(2, profile=profile) as simulator:
+        clients = [make_device_client(d, simulator) for d in simulator.devices]
+        try:
+            await asyncio.gather(*(c.connect_async() for c in clients))
+            await asyncio.gather(*(c.subscribe_async() for c in clients))
+
+            received = 0
+            deadline = time.monotonic() + 1.0
+            while time.monotonic() < deadline:
+                batches = await asyncio.gather(
+                    *(c.next_notifications_async(max_items=1000, timeout_ms=100) for c in clients)
+                )
+                received += sum(len(b) for b in batches)
+
+            stats = simulator.stats()
+            assert stats["notifications_sent"] >= 100
+            assert stats["malformed_sent"] >= 20
+            assert received >= 100
+
+            event = await pyNetX_module.next_notification_event_async(timeout_ms=1000)
+            assert event.type == "malformed_notification"
+            assert event.label.startswith("sim-device-")
+        finally:
+            for client in clients:
+                try:
+                    client.delete_subscription()
+                except Exception:
+                    pass
+            await asyncio.gather(*(disconnect_quietly(c) for c in clients))
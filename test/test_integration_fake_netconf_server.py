@@ -1,6 +1,11 @@
 from __future__ import annotations
 
 import asyncio
+import json
+import struct
+import time
+import urllib.error
+import urllib.request
 
 import pytest
 
@@ -158,6 +163,166 @@ async def test_rpc_error_reply_is_returned_to_caller_for_raw_rpc(pyNetX_module):
         await disconnect_quietly(client)
 
 
+@pytest.mark.asyncio
+async def test_rpc_stats_break_down_rpc_time_by_phase(pyNetX_module):
+    def responder(rpc: str) -> str:
+        if "<get>" in rpc:
+            time.sleep(0.2)
+        return OK_REPLY
+
+    with FakeNetconfSSHServer(rpc_responder=responder) as server:
+        client = make_integration_client(pyNetX_module, server)
+        assert client.rpc_stats()["rpcs"] == 0
+        assert client.rpc_stats()["last"] is None
+        assert await client.connect_async() is True
+
+        await asyncio.gather(client.lock_async(), client.get_async(), client.unlock_async())
+
+        stats = client.rpc_stats()
+        assert stats["rpcs"] == 3
+        assert stats["failed"] == 0
+        assert stats["window_seconds"] >= 0
+        for phase in ("strand_wait", "pool_queue", "write", "first_byte", "transfer", "error_check", "total"):
+            assert stats["phases"][phase]["count"] == 3
+        # unlock queued behind the slow get on the client's strand.
+        assert stats["phases"]["strand_wait"]["max_us"] >= 150_000
+        assert stats["phases"]["first_byte"]["max_us"] >= 150_000
+        assert stats["phases"]["total"]["p50_us"] <= stats["phases"]["total"]["max_us"]
+
+        last = stats["last"]
+        assert last["failed"] is False
+        assert last["strand_wait"] >= 150_000
+        assert last["first_byte"] < 150_000
+
+        client.reset_rpc_stats()
+        assert client.rpc_stats()["rpcs"] == 0
+
+        await disconnect_quietly(client)
+
+
+@pytest.mark.asyncio
+async def test_connect_stats_time_phases_and_classify_failures(pyNetX_module):
+    phases = ("dns", "tcp", "handshake", "auth", "channel", "subsystem", "hello")
+    pyNetX_module.reset_connect_stats()
+
+    with FakeNetconfSSHServer(username="admin", password="correct") as server:
+        client = make_integration_client(pyNetX_module, server, password="correct")
+        assert client.last_connect() == {"rpc": None, "notification": None}
+        assert await client.connect_async() is True
+
+        last = client.last_connect()["rpc"]
+        assert last["ok"] is True
+        assert last["session"] == "rpc"
+        assert last["failed_phase"] is None
+        assert all(last["phases"][phase] is not None for phase in phases)
+        assert last["total_us"] == pytest.approx(sum(last["phases"].values()))
+        await disconnect_quietly(client)
+
+        rejected = make_integration_client(pyNetX_module, server, password="wrong")
+        with pytest.raises((pyNetX_module.NetconfAuthError, pyNetX_module.NetconfConnectionRefusedError)):
+            await rejected.connect_async()
+        failed = rejected.last_connect()["rpc"]
+        assert failed["ok"] is False
+        assert failed["failed_phase"] == "auth"
+        assert failed["failure"] == "rejected"
+        assert "Authentication failed" in failed["error"]
+        assert failed["phases"]["handshake"] is not None
+        assert failed["phases"]["auth"] is None
+
+    stats = pyNetX_module.connect_stats()
+    assert stats["attempts"] == 2
+    assert stats["succeeded"] == 1
+    assert stats["failed"] == 1
+    assert stats["phases"]["handshake"]["count"] == 2
+    assert stats["phases"]["hello"]["count"] == 1
+    assert stats["total"]["count"] == 1
+    assert stats["failures"] == {"auth": {"rejected": 1}}
+    assert [record["ok"] for record in stats["recent_failures"]] == [False]
+    assert stats["recent_failures"][0]["port"] == server.port
+    assert len(stats["slowest"]) == 2
+
+    pyNetX_module.reset_connect_stats()
+    assert pyNetX_module.connect_stats()["attempts"] == 0
+
+
+@pytest.mark.asyncio
+async def test_metrics_export_client_pool_and_bus_series_as_openmetrics(pyNetX_module):
+    with FakeNetconfSSHServer() as server:
+        client = make_integration_client(pyNetX_module, server, label="metrics-leaf-01")
+        assert await client.connect_async() is True
+        await client.get_async()
+        await client.lock_async()
+
+        labels = f'device="metrics-leaf-01",host="{server.host}",port="{server.port}"'
+        text = pyNetX_module.metrics_text()
+        assert text.endswith("# EOF\n")
+        assert "# TYPE pynetx_rpcs counter" in text
+        assert f"pynetx_rpcs_total{{{labels}}} 2" in text
+        assert f'pynetx_rpc_duration_seconds_bucket{{{labels},le="+Inf"}} 2' in text
+        assert f"pynetx_rpc_duration_seconds_count{{{labels}}} 2" in text
+        assert f"pynetx_notifications_enqueued_total{{{labels}}} 0" in text
+        assert f"pynetx_notification_queue_depth{{{labels}}} 0" in text
+        assert "pynetx_pool_workers " in text
+        assert "pynetx_pool_tasks_executed_total " in text
+        assert "# TYPE pynetx_health_events counter" in text
+
+        port = pyNetX_module.start_metrics_server()
+        try:
+            assert pyNetX_module.start_metrics_server() == port
+            with urllib.request.urlopen(f"http://127.0.0.1:{port}/metrics", timeout=5) as response:
+                assert response.status == 200
+                assert response.headers["Content-Type"].startswith("application/openmetrics-text")
+                scraped = response.read().decode()
+            assert f"pynetx_rpcs_total{{{labels}}} 2" in scraped
+            with pytest.raises(urllib.error.HTTPError) as excinfo:
+                urllib.request.urlopen(f"http://127.0.0.1:{port}/", timeout=5)
+            assert excinfo.value.code == 404
+        finally:
+            pyNetX_module.stop_metrics_server()
+
+        await disconnect_quietly(client)
+
+
+@pytest.mark.asyncio
+async def test_trace_dump_shows_pool_rpc_reactor_and_async_spans(pyNetX_module, tmp_path):
+    notifications = [notification_xml(1)]
+    with FakeNetconfSSHServer(notifications=notifications) as server:
+        client = make_integration_client(pyNetX_module, server, label="trace-leaf-01")
+        assert await client.connect_async() is True
+
+        pyNetX_module.start_tracing()
+        try:
+            await client.get_async()
+            await client.subscribe_async(stream="NETCONF")
+            await client.next_notification_async(timeout_ms=3000)
+        finally:
+            pyNetX_module.stop_tracing()
+
+        path = tmp_path / "trace.json"
+        spans = pyNetX_module.dump_trace(str(path))
+        assert spans > 0
+        events = json.loads(path.read_text())["traceEvents"]
+
+        categories = {event.get("cat") for event in events}
+        assert {"pool", "rpc", "reactor", "notification", "async"} <= categories
+        names = {event["args"]["name"] for event in events if event["ph"] == "M"}
+        assert any(name.startswith("pool-worker-") for name in names)
+        assert any(name.startswith("notification-reactor-") for name in names)
+
+        rpc_spans = [e for e in events if e.get("cat") == "rpc" and e["name"] == "first_byte"]
+        assert rpc_spans
+        assert rpc_spans[0]["args"]["device"] == "trace-leaf-01"
+
+        # Nothing is recorded once tracing is stopped.
+        await client.get_async()
+        assert pyNetX_module.dump_trace(str(path)) == spans
+
+        with pytest.raises(ValueError):
+            pyNetX_module.start_tracing(events_per_thread=0)
+
+        await disconnect_quietly(client)
+
+
 @pytest.mark.asyncio
 async def test_subscribe_async_reads_notifications_from_reactor_queue(pyNetX_module):
     notifications = [notification_xml(1), notification_xml(2)]
@@ -180,6 +345,67 @@ async def test_subscribe_async_reads_notifications_from_reactor_queue(pyNetX_mod
         assert not client.is_subscription_active()
 
 
+@pytest.mark.asyncio
+async def test_reactor_stats_time_handlers_and_report_slow_ones(pyNetX_module):
+    notifications = [notification_xml(1), notification_xml(2)]
+    with FakeNetconfSSHServer(notifications=notifications) as server:
+        client = make_integration_client(pyNetX_module, server, label="reactor-leaf-01")
+        pyNetX_module.clear_notification_events()
+        # Every read is over a 1 us threshold.
+        pyNetX_module.set_reactor_slow_handler_threshold(0.001)
+        try:
+            reply = await client.subscribe_async(stream="NETCONF")
+            assert "<ok/>" in reply
+            await client.next_notification_async(timeout_ms=3000)
+
+            slow_event = None
+            deadline = asyncio.get_running_loop().time() + 5.0
+            while asyncio.get_running_loop().time() < deadline:
+                event = await pyNetX_module.next_notification_event_async(timeout_ms=1000)
+                if event.type == "slow_notification_handler":
+                    slow_event = event
+                    break
+            assert slow_event is not None, "did not receive slow-handler health event"
+            assert slow_event.label == "reactor-leaf-01"
+            assert slow_event.port == server.port
+            assert "threshold" in slow_event.message
+        finally:
+            pyNetX_module.set_reactor_slow_handler_threshold(0)
+
+        handlers = [
+            handler
+            for reactor in pyNetX_module.reactor_stats()
+            for handler in reactor["handlers"]
+            if handler["label"] == "reactor-leaf-01"
+        ]
+        assert len(handlers) == 1
+        handler = handlers[0]
+        assert handler["host"] == server.host
+        assert handler["calls"] >= 1
+        assert handler["slow"] >= 1
+        assert handler["bytes"] > 0
+        assert handler["handler"]["count"] == handler["calls"]
+
+        reactor = next(r for r in pyNetX_module.reactor_stats() if handler in r["handlers"])
+        assert reactor["wakeups"] >= 1
+        assert sum(reactor["events_per_wakeup"].values()) <= reactor["wakeups"]
+        assert reactor["bytes"] >= handler["bytes"]
+        assert 0 <= reactor["load"] <= 1
+
+        labels = (
+            f'device="reactor-leaf-01",host="{server.host}",port="{server.port}",'
+            f'reactor="{reactor["reactor"]}"'
+        )
+        text = pyNetX_module.metrics_text()
+        assert f"pynetx_notification_handler_seconds_count{{{labels}}}" in text
+        assert f"pynetx_notification_bytes_read_total{{{labels}}}" in text
+
+        with pytest.raises(ValueError):
+            pyNetX_module.set_reactor_slow_handler_threshold(-1)
+
+        client.delete_subscription()
+
+
 @pytest.mark.asyncio
 async def test_notification_queue_full_health_event_contains_label_timestamp_and_counters(pyNetX_module):
     notifications = [notification_xml(i) for i in range(1, 5)]
@@ -242,6 +468,113 @@ async def test_notification_queue_full_health_event_contains_label_timestamp_and
         client.delete_subscription()
 
 
+@pytest.mark.asyncio
+async def test_native_log_messages_are_rate_limited_and_reach_python_handler(pyNetX_module):
+    records: list[tuple[int, str]] = []
+    notifications = [notification_xml(i) for i in range(1, 41)]
+    pyNetX_module.set_log_rate_limit(2)
+    pyNetX_module.set_log_handler(lambda level, message: records.append((level, message)))
+    before = pyNetX_module.log_stats()
+    try:
+        with FakeNetconfSSHServer(
+            notifications=notifications,
+            notification_start_delay=0.20,
+            notification_interval=0.005,
+        ) as server:
+            client = make_integration_client(
+                pyNetX_module,
+                server,
+                notif_queue_size=1,
+                notif_drop_event_threshold=1,
+                label="leaf-flooding-logs",
+            )
+            try:
+                assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+
+                deadline = time.monotonic() + 5.0
+                while time.monotonic() < deadline:
+                    if pyNetX_module.log_stats()["suppressed"] > before["suppressed"]:
+                        break
+                    await asyncio.sleep(0.05)
+            finally:
+                await disconnect_quietly(client)
+
+        assert pyNetX_module.flush_logs(2000) is True
+    finally:
+        pyNetX_module.set_log_handler(None)
+        pyNetX_module.set_log_rate_limit(10)
+
+    stats = pyNetX_module.log_stats()
+    assert stats["suppressed"] > before["suppressed"]
+    assert stats["rate_limit"] == 10
+    assert stats["level"] == 20
+
+    queue_full = [message for level, message in records if "Notification queue full" in message]
+    assert queue_full, records
+    assert all(level == 30 for level, message in records if "Notification queue full" in message)
+    assert len(queue_full) <= 2 * 6
+
+    with pytest.raises(ValueError):
+        pyNetX_module.set_log_handler(42)
+    with pytest.raises(ValueError):
+        pyNetX_module.set_log_rate_limit(-1)
+
+
+CAPTURE_RECORD = struct.Struct("=QBBHiI")
+
+
+def read_capture(path) -> list[tuple[int, int, str, int, bytes]]:
+    data = path.read_bytes()
+    assert data[:8] == b"PNXCAP01"
+    records = []
+    offset = 8
+    while offset < len(data):
+        nanos, channel, _, label_size, fd, size = CAPTURE_RECORD.unpack_from(data, offset)
+        offset += CAPTURE_RECORD.size
+        label = data[offset:offset + label_size].decode()
+        offset += label_size
+        records.append((nanos, channel, label, fd, data[offset:offset + size]))
+        offset += size
+    assert offset == len(data)
+    return records
+
+
+@pytest.mark.asyncio
+async def test_capture_records_raw_rpc_and_notification_reads(pyNetX_module, tmp_path):
+    path = tmp_path / "leaf.pnxcap"
+    notifications = [notification_xml(1), notification_xml(2)]
+    pyNetX_module.start_capture(str(path))
+    try:
+        with FakeNetconfSSHServer(notifications=notifications) as server:
+            client = make_integration_client(pyNetX_module, server, label="captured-leaf")
+            assert await client.connect_async() is True
+            reply = await client.send_rpc_async('<rpc message-id="cap-1"><get/></rpc>')
+
+            assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+            await client.next_notification_async(timeout_ms=3000)
+            await client.next_notification_async(timeout_ms=3000)
+            await client.disconnect_async()
+    finally:
+        totals = pyNetX_module.stop_capture()
+
+    records = read_capture(path)
+    assert totals == {"records": len(records), "bytes": sum(len(r[4]) for r in records)}
+    assert [r[0] for r in records] == sorted(r[0] for r in records)
+    assert {r[2] for r in records} == {"captured-leaf"}
+
+    rpc = b"".join(r[4] for r in records if r[1] == 0)
+    notification = b"".join(r[4] for r in records if r[1] == 1)
+    assert rpc.decode() == reply
+    assert notification.count(NETCONF_EOM.encode()) == 2
+    assert b"<sequence>1</sequence>" in notification
+    assert b"<sequence>2</sequence>" in notification
+
+    # Nothing is written once capture is off.
+    assert pyNetX_module.stop_capture() == totals
+    with pytest.raises(RuntimeError):
+        pyNetX_module.start_capture(str(tmp_path / "missing" / "dir.pnxcap"))
+
+
 @pytest.mark.asyncio
 async def test_default_label_is_none_in_generated_health_events(pyNetX_module):
     notifications = [notification_xml(i) for i in range(1, 4)]
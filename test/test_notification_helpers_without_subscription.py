@@ -44,6 +44,26 @@ async def test_next_notification_async_requires_active_subscription(make_client,
     assert "Notification channel not open" in message
 
 
+def test_next_notifications_requires_active_subscription(make_client, pyNetX_module):
+    client = make_client()
+    with pytest.raises(RuntimeError) as excinfo:
+        client.next_notifications(max_items=10, timeout_ms=0)
+    message = str(excinfo.value)
+    assert "Unable to read from queue" in message
+    assert "Notification channel not open" in message
+
+
+@pytest.mark.asyncio
+async def test_next_notifications_async_requires_active_subscription(make_client, pyNetX_module):
+    client = make_client()
+    message = await assert_await_raises(
+        client.next_notifications_async(max_items=10, timeout_ms=0),
+        pyNetX_module.NetconfException,
+    )
+    assert "Unable to read from queue" in message
+    assert "Notification channel not open" in message
+
+
 def test_delete_subscription_is_non_deprecated_and_idempotent(make_client):
     client = make_client()
     assert not client.is_subscription_active()
@@ -51,3 +71,17 @@ def test_delete_subscription_is_non_deprecated_and_idempotent(make_client):
     client.delete_subscription()
     assert not client.is_subscription_active()
     assert client.notification_queue_size() == 0
+
+
+@pytest.mark.asyncio
+async def test_notifications_iterator_ends_immediately_without_subscription(make_client):
+    client = make_client()
+    received = [notification async for notification in client.notifications()]
+    assert received == []
+
+
+def test_notifications_iterator_rejects_invalid_batch_size(make_client):
+    client = make_client()
+    with pytest.raises(RuntimeError) as excinfo:
+        client.notifications(max_batch=0)
+    assert "max_batch must be greater than 0" in str(excinfo.value)
@@ -6,7 +6,7 @@ import pytest
 
 from conftest import assert_recent_utc_timestamp
 from fake_netconf_ssh_server import NETCONF_EOM, FakeNetconfSSHServer, notification_xml
-from test_integration_fake_netconf_server import make_integration_client
+from test_integration_fake_netconf_server import disconnect_quietly, make_integration_client
 
 pytestmark = [pytest.mark.integration, pytest.mark.slow]
 
@@ -52,6 +52,35 @@ async def test_peek_notifications_after_subscription_is_non_destructive(pyNetX_m
         client.delete_subscription()
 
 
+@pytest.mark.asyncio
+async def test_next_notifications_drains_batch_in_fifo_order(pyNetX_module):
+    notifications = [notification_xml(i) for i in range(1, 6)]
+    with FakeNetconfSSHServer(notifications=notifications, notification_interval=0.01) as server:
+        client = make_integration_client(pyNetX_module, server, notif_queue_size=10)
+        assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+
+        await wait_for_queue_size(client, 5)
+
+        with pytest.raises(RuntimeError) as excinfo:
+            client.next_notifications(max_items=0, timeout_ms=0)
+        assert "max_items must be -1" in str(excinfo.value)
+
+        first_batch = client.next_notifications(max_items=2, timeout_ms=1000)
+        assert len(first_batch) == 2
+        assert "<sequence>1</sequence>" in first_batch[0]
+        assert "<sequence>2</sequence>" in first_batch[1]
+
+        rest = await client.next_notifications_async(max_items=-1, timeout_ms=1000)
+        assert len(rest) == 3
+        assert "<sequence>3</sequence>" in rest[0]
+        assert "<sequence>5</sequence>" in rest[2]
+        assert client.notification_queue_size() == 0
+
+        assert client.next_notifications(max_items=10, timeout_ms=20) == []
+
+        client.delete_subscription()
+
+
 @pytest.mark.asyncio
 async def test_bounded_zero_notification_queue_drops_everything_and_reports_health(pyNetX_module):
     notifications = [notification_xml(i) for i in range(1, 5)]
@@ -380,3 +409,240 @@ async def test_empty_eom_frame_is_reported_and_dropped(pyNetX_module):
         assert client.peek_notifications(-1) == []
 
         client.delete_subscription()
+
+
+@pytest.mark.asyncio
+async def test_attached_clients_publish_into_one_merged_stream(pyNetX_module):
+    stream = pyNetX_module.notification_stream("integration-merged-stream")
+    stream.clear()
+
+    first_notifications = [notification_xml(i) for i in range(1, 4)]
+    second_notifications = [notification_xml(i) for i in range(101, 104)]
+    with FakeNetconfSSHServer(notifications=first_notifications, notification_interval=0.01) as first_server, \
+            FakeNetconfSSHServer(notifications=second_notifications, notification_interval=0.01) as second_server:
+        first = make_integration_client(pyNetX_module, first_server, label="merged-leaf-01")
+        second = make_integration_client(pyNetX_module, second_server, label="merged-leaf-02")
+        first.attach_notification_stream(stream)
+        second.attach_notification_stream(stream)
+
+        assert "<ok/>" in await first.subscribe_async(stream="NETCONF")
+        assert "<ok/>" in await second.subscribe_async(stream="NETCONF")
+
+        records = []
+        deadline = asyncio.get_running_loop().time() + 5.0
+        while len(records) < 6 and asyncio.get_running_loop().time() < deadline:
+            records.extend(await stream.next_batch_async(max_items=-1, timeout_ms=200))
+
+        assert len(records) == 6
+        by_label = {}
+        for record in records:
+            by_label.setdefault(record.label, []).append(record.payload)
+            assert record.as_dict()["hostname"] == record.hostname
+
+        assert set(by_label) == {"merged-leaf-01", "merged-leaf-02"}
+        assert "<sequence>1</sequence>" in by_label["merged-leaf-01"][0]
+        assert "<sequence>3</sequence>" in by_label["merged-leaf-01"][2]
+        assert "<sequence>101</sequence>" in by_label["merged-leaf-02"][0]
+        assert "<sequence>103</sequence>" in by_label["merged-leaf-02"][2]
+
+        # Per-client queues are bypassed while a stream is attached.
+        assert first.notification_queue_size() == 0
+        assert second.notification_queue_size() == 0
+        assert stream.pending_count() == 0
+
+        first.delete_subscription()
+        second.delete_subscription()
+
+
+@pytest.mark.asyncio
+async def test_per_client_reads_raise_while_a_stream_is_attached(pyNetX_module):
+    stream = pyNetX_module.notification_stream("integration-stream-exclusive")
+    stream.clear()
+    notifications = [notification_xml(i) for i in range(1, 4)]
+    with FakeNetconfSSHServer(
+        notifications=notifications,
+        notification_start_delay=0.5,
+        notification_interval=0.01,
+    ) as server:
+        client = make_integration_client(pyNetX_module, server, label="exclusive-leaf")
+        assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+
+        # A wait registered before the stream is attached fails instead of
+        # waiting for notifications that now go to the stream.
+        pending = asyncio.ensure_future(client.next_notifications_async(max_items=10, timeout_ms=5000))
+        await asyncio.sleep(0.05)
+        client.attach_notification_stream(stream)
+        with pytest.raises(pyNetX_module.NetconfException, match="stream was attached"):
+            await asyncio.wait_for(pending, 1.0)
+
+        with pytest.raises(pyNetX_module.NetconfException, match="notification stream is attached"):
+            client.next_notification(timeout_ms=0)
+        with pytest.raises(pyNetX_module.NetconfException, match="notification stream is attached"):
+            client.next_notifications(max_items=10, timeout_ms=0)
+        with pytest.raises(pyNetX_module.NetconfException, match="notification stream is attached"):
+            await client.next_notification_async(timeout_ms=0)
+        with pytest.raises(pyNetX_module.NetconfException, match="notification stream is attached"):
+            await client.next_notifications_async(max_items=10, timeout_ms=0)
+        with pytest.raises(pyNetX_module.NetconfException, match="notification stream is attached"):
+            await client.notifications().__anext__()
+
+        records = []
+        deadline = asyncio.get_running_loop().time() + 5.0
+        while len(records) < 3 and asyncio.get_running_loop().time() < deadline:
+            records.extend(await stream.next_batch_async(max_items=-1, timeout_ms=200))
+        assert len(records) == 3
+
+        client.detach_notification_stream()
+        assert client.next_notifications(max_items=10, timeout_ms=0) == []
+
+        client.delete_subscription()
+
+
+@pytest.mark.asyncio
+async def test_stream_budget_drops_are_counted_per_client_and_reported(pyNetX_module):
+    # Every record is larger than a one-byte budget.
+    stream = pyNetX_module.notification_stream("integration-stream-drops", max_bytes=1)
+    notifications = [notification_xml(i) for i in range(1, 5)]
+    with FakeNetconfSSHServer(notifications=notifications, notification_interval=0.01) as server:
+        client = make_integration_client(
+            pyNetX_module,
+            server,
+            notif_drop_event_threshold=1,
+            label="stream-drop-leaf",
+        )
+        client.attach_notification_stream(stream)
+        assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+
+        event = await wait_for_health_event(
+            pyNetX_module,
+            {"notification_queue_full", "notification_drops_summary"},
+            predicate=lambda candidate: candidate.label == "stream-drop-leaf",
+        )
+        assert "stream" in event.message
+        assert event.notifications_dropped_queue_full >= 1
+        assert event.notifications_dropped_delta >= 1
+
+        dropped = stream.dropped_count()
+        assert dropped >= 1
+        stream.clear()
+        assert stream.dropped_count() >= dropped
+
+        client.delete_subscription()
+
+
+@pytest.mark.asyncio
+async def test_waiting_stream_next_batch_async_calls_use_no_pool_workers(pyNetX_module):
+    stream = pyNetX_module.notification_stream("integration-stream-waiters")
+    stream.clear()
+    notifications = [notification_xml(i) for i in range(1, 5)]
+    pyNetX_module.set_threadpool_size(1)
+    try:
+        with FakeNetconfSSHServer(
+            notifications=notifications,
+            notification_start_delay=0.5,
+            notification_interval=0.02,
+        ) as server:
+            client = make_integration_client(pyNetX_module, server)
+            client.attach_notification_stream(stream)
+            assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+            assert await client.connect_async() is True
+
+            waiters = [
+                asyncio.ensure_future(stream.next_batch_async(max_items=1, timeout_ms=5000))
+                for _ in range(4)
+            ]
+            await asyncio.sleep(0.05)
+
+            # Four parked waiters and a 1-worker pool: RPCs still run.
+            reply = await asyncio.wait_for(client.send_rpc_async("<rpc><get/></rpc>"), 1.0)
+            assert "<ok/>" in reply
+
+            batches = await asyncio.wait_for(asyncio.gather(*waiters), 5.0)
+            payloads = [record.payload for batch in batches for record in batch]
+            for index in range(1, 5):
+                assert sum(f"<sequence>{index}</sequence>" in p for p in payloads) == 1
+
+            client.delete_subscription()
+            await disconnect_quietly(client)
+    finally:
+        pyNetX_module.set_threadpool_size(4)
+
+
+@pytest.mark.asyncio
+async def test_notifications_async_iterator_is_push_driven(pyNetX_module):
+    notifications = [notification_xml(i) for i in range(1, 6)]
+    with FakeNetconfSSHServer(notifications=notifications, notification_interval=0.05) as server:
+        client = make_integration_client(pyNetX_module, server, notif_queue_size=10)
+        assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+
+        received = []
+
+        async def consume():
+            async for notification in client.notifications(max_batch=2):
+                received.append(notification)
+                if len(received) == 5:
+                    break
+
+        await asyncio.wait_for(consume(), timeout=5.0)
+
+        assert len(received) == 5
+        for index, notification in enumerate(received, start=1):
+            assert f"<sequence>{index}</sequence>" in notification
+        assert client.notification_queue_size() == 0
+
+        client.delete_subscription()
+
+
+@pytest.mark.asyncio
+async def test_notifications_async_iterator_stops_when_subscription_is_deleted(pyNetX_module):
+    with FakeNetconfSSHServer(notifications=[]) as server:
+        client = make_integration_client(pyNetX_module, server)
+        assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+
+        async def consume():
+            return [notification async for notification in client.notifications()]
+
+        task = asyncio.ensure_future(consume())
+        await asyncio.sleep(0.1)
+        assert not task.done()
+
+        client.delete_subscription()
+        assert await asyncio.wait_for(task, timeout=2.0) == []
+
+        # The ready fd is released once the waiter finishes, so a new
+        # iterator can be created and ends immediately.
+        assert [n async for n in client.notifications()] == []
+
+
+@pytest.mark.asyncio
+async def test_waiting_next_notification_async_calls_use_no_pool_workers(pyNetX_module):
+    notifications = [notification_xml(i) for i in range(1, 9)]
+    pyNetX_module.set_threadpool_size(2)
+    try:
+        with FakeNetconfSSHServer(
+            notifications=notifications,
+            notification_start_delay=0.5,
+            notification_interval=0.02,
+        ) as server:
+            client = make_integration_client(pyNetX_module, server, notif_queue_size=20)
+            assert "<ok/>" in await client.subscribe_async(stream="NETCONF")
+            assert await client.connect_async() is True
+
+            waiters = [
+                asyncio.ensure_future(client.next_notification_async(timeout_ms=5000))
+                for _ in range(8)
+            ]
+            await asyncio.sleep(0.05)
+
+            # Eight parked waiters and a 2-worker pool: RPCs still run.
+            reply = await asyncio.wait_for(client.send_rpc_async("<rpc><get/></rpc>"), 1.0)
+            assert "<ok/>" in reply
+
+            received = await asyncio.wait_for(asyncio.gather(*waiters), 5.0)
+            for index in range(1, 9):
+                assert sum(f"<sequence>{index}</sequence>" in n for n in received) == 1
+
+            client.delete_subscription()
+            await disconnect_quietly(client)
+    finally:
+        pyNetX_module.set_threadpool_size(4)
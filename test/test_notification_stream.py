@@ -0,0 +1,81 @@
+from __future__ import annotations
+
+import pytest
+
+
+def test_named_streams_are_process_wide_singletons(pyNetX_module):
+    first = pyNetX_module.notification_stream("stream-contract-a")
+    second = pyNetX_module.notification_stream("stream-contract-a")
+    other = pyNetX_module.notification_stream("stream-contract-b")
+
+    assert first.name == "stream-contract-a"
+    assert other.name == "stream-contract-b"
+    assert first is second
+    assert pyNetX_module.notification_stream().name == "default"
+
+
+def test_empty_stream_returns_empty_batch(pyNetX_module):
+    stream = pyNetX_module.notification_stream("stream-contract-empty")
+    stream.clear()
+    assert stream.next_batch(max_items=10, timeout_ms=0) == []
+    assert stream.next_batch(max_items=10, timeout_ms=20) == []
+    assert stream.pending_count() == 0
+    assert stream.pending_bytes() == 0
+    assert stream.dropped_count() == 0
+
+
+@pytest.mark.asyncio
+async def test_empty_stream_async_batch_times_out(pyNetX_module):
+    stream = pyNetX_module.notification_stream("stream-contract-empty-async")
+    assert await stream.next_batch_async(max_items=10, timeout_ms=20) == []
+
+
+def test_stream_rejects_invalid_arguments(pyNetX_module):
+    stream = pyNetX_module.notification_stream("stream-contract-invalid")
+
+    with pytest.raises(RuntimeError) as excinfo:
+        stream.next_batch(max_items=0, timeout_ms=0)
+    assert "max_items must be -1" in str(excinfo.value)
+
+    with pytest.raises(RuntimeError) as excinfo:
+        stream.next_batch(max_items=1, timeout_ms=-1)
+    assert "timeout_ms must be >= 0" in str(excinfo.value)
+
+    with pytest.raises(RuntimeError) as excinfo:
+        stream.max_bytes = 0
+    assert "max_bytes must be greater than 0" in str(excinfo.value)
+
+    with pytest.raises(RuntimeError):
+        pyNetX_module.notification_stream("")
+
+
+@pytest.mark.asyncio
+async def test_stream_async_batch_rejects_invalid_arguments(pyNetX_module):
+    stream = pyNetX_module.notification_stream("stream-contract-invalid-async")
+
+    with pytest.raises(RuntimeError) as excinfo:
+        await stream.next_batch_async(max_items=0, timeout_ms=0)
+    assert "max_items must be -1" in str(excinfo.value)
+
+    with pytest.raises(RuntimeError) as excinfo:
+        await stream.next_batch_async(max_items=1, timeout_ms=-1)
+    assert "timeout_ms must be >= 0" in str(excinfo.value)
+
+
+def test_stream_budget_can_be_resized(pyNetX_module):
+    stream = pyNetX_module.notification_stream("stream-contract-budget", max_bytes=4096)
+    assert stream.max_bytes == 4096
+
+    stream.max_bytes = 8192
+    assert pyNetX_module.notification_stream("stream-contract-budget").max_bytes == 8192
+
+
+def test_attach_and_detach_stream_before_subscription(make_client, pyNetX_module):
+    client = make_client()
+    stream = pyNetX_module.notification_stream("stream-contract-attach")
+
+    client.attach_notification_stream(stream)
+    client.attach_notification_stream(stream)
+    client.detach_notification_stream()
+    client.detach_notification_stream()
+    assert client.notification_queue_size() == 0
@@ -9,13 +9,37 @@ NON_DEPRECATED_MODULE_SYMBOLS = {
     "NetconfAuthError",
     "NetconfChannelError",
     "NetconfConnectionRefusedError",
+    "ThreadPoolFullError",
     "NotificationHealthEvent",
     "set_threadpool_size",
+    "get_threadpool_size",
+    "set_threadpool_queue_limit",
     "set_notification_reactor_count",
+    "set_reactor_slow_handler_threshold",
+    "reactor_stats",
     "next_notification_event",
     "next_notification_event_async",
     "pending_notification_event_count",
     "clear_notification_events",
+    "NotificationRecord",
+    "NotificationStream",
+    "notification_stream",
+    "NotificationIterator",
+    "connect_stats",
+    "reset_connect_stats",
+    "metrics_text",
+    "start_metrics_server",
+    "stop_metrics_server",
+    "start_tracing",
+    "stop_tracing",
+    "dump_trace",
+    "start_capture",
+    "stop_capture",
+    "set_log_level",
+    "set_log_rate_limit",
+    "set_log_handler",
+    "flush_logs",
+    "log_stats",
 }
 
 NON_DEPRECATED_CLIENT_METHODS = {
@@ -35,10 +59,18 @@ NON_DEPRECATED_CLIENT_METHODS = {
     "locked_edit_config_async",
     "next_notification",
     "next_notification_async",
+    "next_notifications",
+    "next_notifications_async",
+    "notifications",
     "peek_notifications",
     "notification_queue_size",
+    "attach_notification_stream",
+    "detach_notification_stream",
     "is_subscription_active",
     "delete_subscription",
+    "rpc_stats",
+    "reset_rpc_stats",
+    "last_connect",
 }
 
 DEPRECATED_SYNC_FLOW_METHODS = {
@@ -80,6 +112,7 @@ def test_exception_hierarchy_uses_python_builtin_categories(pyNetX_module):
     assert issubclass(pyNetX_module.NetconfConnectionRefusedError, ConnectionError)
     assert issubclass(pyNetX_module.NetconfAuthError, PermissionError)
     assert issubclass(pyNetX_module.NetconfChannelError, OSError)
+    assert issubclass(pyNetX_module.ThreadPoolFullError, pyNetX_module.NetconfException)
 
 
 def test_constructor_accepts_current_non_deprecated_keywords(make_client):
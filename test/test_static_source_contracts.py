@@ -95,6 +95,7 @@ def test_notification_stream_parser_source_contract_includes_today_fix(project_r
     netconf_hpp = read(root, "include/netconf_client.hpp")
     non_blocking_cpp = read(root, "src/netconf_client_non_blocking.cpp")
     blocking_cpp = read(root, "src/netconf_client_blocking.cpp")
+    framing_cpp = read(root, "src/netconf_framing.cpp")
 
     assert "std::string _notif_rx_buffer" in netconf_hpp
     assert "_notif_rx_partial_timer_active" in netconf_hpp
@@ -105,20 +106,63 @@ def test_notification_stream_parser_source_contract_includes_today_fix(project_r
     assert "process_rx_buffer_locked" in non_blocking_cpp
     assert "process_eom_frame_locked" in non_blocking_cpp
     assert "process_recovered_missing_eom_locked" in non_blocking_cpp
-    assert "find_notification_start_tag(_notif_rx_buffer, notification_start + 1)" in non_blocking_cpp
+    assert "split_notification_frames(_notif_rx_buffer," in non_blocking_cpp
+    assert "std::max(notification_start + 1, scan.after_start_from)" in framing_cpp
+    assert "NotificationScanState _notif_rx_scan" in netconf_hpp
     assert "Received a new notification start before the previous notification was completed" in non_blocking_cpp
     assert '"malformed_notification"' in non_blocking_cpp
     assert '"incomplete_notification"' in non_blocking_cpp
     assert "_notif_rx_buffer.clear();" in blocking_cpp
+    assert "_notif_rx_scan = NotificationScanState();" in blocking_cpp
 
 
 def test_notification_stream_parser_drops_orphan_prefix_before_eom_frames(project_root):
     root = require_source_root(project_root)
     non_blocking_cpp = read(root, "src/netconf_client_non_blocking.cpp")
+    framing_cpp = read(root, "src/netconf_framing.cpp")
 
     orphan_message = "Received orphan notification bytes before a notification start tag; dropped orphan fragment"
-    eom_loop = "eom_pos = _notif_rx_buffer.find(NETCONF_NOTIFICATION_EOM)"
+    orphan_callback = "handler.on_orphan_prefix("
+    eom_loop = "eom_pos = buffer.find(NETCONF_EOM, scan.eom_from)"
 
     assert orphan_message in non_blocking_cpp
-    assert eom_loop in non_blocking_cpp
-    assert non_blocking_cpp.index(orphan_message) < non_blocking_cpp.index(eom_loop)
+    assert "process_orphan_prefix_locked" in non_blocking_cpp
+    assert orphan_callback in framing_cpp
+    assert eom_loop in framing_cpp
+    assert framing_cpp.index(orphan_callback) < framing_cpp.index(eom_loop)
+
+
+def test_every_documented_usdt_probe_is_fired_and_off_by_default(project_root):
+    root = require_source_root(project_root)
+    probes_hpp = read(root, "include/usdt_probes.hpp")
+    cmake = read(root, "CMakeLists.txt")
+    sources = "\n".join(path.read_text(encoding="utf-8") for path in sorted((root / "src").glob("*.cpp")))
+
+    documented = {
+        line.split()[1]
+        for line in probes_hpp.splitlines()
+        if line.startswith("//   ") and "__" in line.split()[1]
+    }
+    assert documented == {
+        "rpc__start", "rpc__end", "connect__phase", "connect__end",
+        "notification__enqueue", "notification__drop", "reactor__wakeup",
+        "reactor__handler", "pool__task__start", "pool__task__end",
+    }
+    for probe in documented:
+        assert f"({probe}," in sources, f"{probe} is documented but never fired"
+
+    assert "#include <sys/sdt.h>" not in sources
+    assert 'option(PYNETX_ENABLE_USDT "' in cmake
+    assert "(needs sys/sdt.h); see include/usdt_probes.hpp\" OFF)" in cmake
+
+
+def test_native_code_logs_through_the_async_logger(project_root):
+    root = require_source_root(project_root)
+    paths = sorted((root / "src").glob("*.cpp")) + sorted((root / "include").glob("*.hpp"))
+
+    for path in paths:
+        if path.name == "logger.hpp":
+            continue
+        text = path.read_text(encoding="utf-8")
+        assert "std::cerr" not in text, f"{path.name} writes to std::cerr; use NETX_LOG()"
+        assert "std::cout" not in text, f"{path.name} writes to std::cout; use NETX_LOG()"